@@ -0,0 +1,348 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_mcmc_chains.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_MCMC_CHAINS_HPP
+#define MCKL_EXAMPLE_ALGORITHM_MCMC_CHAINS_HPP
+
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/uniform_real_distribution.hpp>
+#include <mckl/smp/backend_omp.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using AlgorithmMCMCChains = mckl::MCMCChains<double>;
+
+// An exact AR(1) move with stationary distribution N(mu, 1), which records
+// the trajectory of its chain
+class AlgorithmMCMCChainsAR
+{
+  public:
+    AlgorithmMCMCChainsAR(
+        mckl::RNG &rng, double mu, double rho, mckl::Vector<double> &path)
+        : rng_(rng), mu_(mu), rho_(rho), path_(path)
+    {
+    }
+
+    std::size_t operator()(std::size_t, double &x)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        x = mu_ + rho_ * (x - mu_) + std::sqrt(1 - rho_ * rho_) * normal(rng_);
+        path_.push_back(x);
+
+        return 1;
+    }
+
+  private:
+    mckl::RNG &rng_;
+    double mu_;
+    double rho_;
+    mckl::Vector<double> &path_;
+}; // class AlgorithmMCMCChainsAR
+
+// A random walk Metropolis move with target N(0, 1)
+class AlgorithmMCMCChainsRW
+{
+  public:
+    AlgorithmMCMCChainsRW(mckl::RNG &rng) : rng_(rng) {}
+
+    std::size_t operator()(std::size_t, double &x)
+    {
+        mckl::NormalDistribution<double> normal(0, 2.4);
+        mckl::UniformRealDistribution<double> runif(0, 1);
+        const double y = x + normal(rng_);
+        if (std::log(runif(rng_)) < 0.5 * (x * x - y * y)) {
+            x = y;
+            return 1;
+        }
+
+        return 0;
+    }
+
+  private:
+    mckl::RNG &rng_;
+}; // class AlgorithmMCMCChainsRW
+
+// Set up K chains of AR(1) moves, the k-th chain with mean mu[k], starting
+// at start + k and monitoring the state and its square
+inline void algorithm_mcmc_chains_setup(AlgorithmMCMCChains &chains,
+    const mckl::Vector<double> &mu, double rho, double start,
+    mckl::Vector<mckl::Vector<double>> &path, std::size_t batch)
+{
+    path.clear();
+    path.resize(chains.size());
+    for (std::size_t k = 0; k != chains.size(); ++k)
+        chains.chain(k).state() = start + k;
+    chains.mutation([&](std::size_t k, mckl::RNG &rng) {
+        return AlgorithmMCMCChainsAR(rng, mu[k], rho, path[k]);
+    });
+    chains.monitor(2,
+        [](std::size_t, std::size_t, double &x, double *r) {
+            r[0] = x;
+            r[1] = x * x;
+        },
+        batch);
+}
+
+// The statistics computed from the recorded trajectories of the last n
+// iterations
+inline void algorithm_mcmc_chains_stats(std::size_t n, std::size_t batch,
+    const mckl::Vector<mckl::Vector<double>> &path, double &mean,
+    double &rhat, double &ess)
+{
+    const std::size_t K = path.size();
+    mckl::Vector<double> m(K);
+    mckl::Vector<double> v(K);
+    ess = 0;
+    for (std::size_t k = 0; k != K; ++k) {
+        const double *x = path[k].data() + path[k].size() - n;
+        m[k] = 0;
+        for (std::size_t i = 0; i != n; ++i)
+            m[k] += x[i];
+        m[k] /= n;
+        v[k] = 0;
+        for (std::size_t i = 0; i != n; ++i)
+            v[k] += (x[i] - m[k]) * (x[i] - m[k]);
+        v[k] /= n - 1;
+
+        const std::size_t nb = n / batch;
+        if (nb < 2)
+            continue;
+        mckl::Vector<double> b(nb);
+        double bm = 0;
+        for (std::size_t i = 0; i != nb; ++i) {
+            b[i] = 0;
+            for (std::size_t j = 0; j != batch; ++j)
+                b[i] += x[i * batch + j];
+            b[i] /= batch;
+            bm += b[i];
+        }
+        bm /= nb;
+        double bv = 0;
+        for (std::size_t i = 0; i != nb; ++i)
+            bv += (b[i] - bm) * (b[i] - bm);
+        bv = bv / (nb - 1) * batch;
+        ess += n * v[k] / bv;
+    }
+
+    mean = 0;
+    double w = 0;
+    for (std::size_t k = 0; k != K; ++k) {
+        mean += m[k];
+        w += v[k];
+    }
+    mean /= K;
+    w /= K;
+    double b = 0;
+    for (std::size_t k = 0; k != K; ++k)
+        b += (m[k] - mean) * (m[k] - mean);
+    b /= K - 1;
+    rhat = std::sqrt(((n - 1.0) / n * w + b) / w);
+}
+
+inline bool algorithm_mcmc_chains_close(double x, double y)
+{
+    return std::abs(x - y) < 1e-8 * (1 + std::abs(y));
+}
+
+// The monitored statistics agree with those computed from the trajectories,
+// after burn-in and the statistics cleared
+inline bool algorithm_mcmc_chains_monitor(
+    std::size_t K, std::size_t n, std::size_t batch)
+{
+    AlgorithmMCMCChains chains(K);
+    mckl::Vector<mckl::Vector<double>> path;
+    algorithm_mcmc_chains_setup(
+        chains, mckl::Vector<double>(K, 0.0), 0.5, -5, path, batch);
+    chains.iterate(n / 10);
+    chains.clear_monitor();
+    chains.iterate(n);
+
+    double mean = 0;
+    double rhat = 0;
+    double ess = 0;
+    algorithm_mcmc_chains_stats(n, batch, path, mean, rhat, ess);
+
+    mckl::Vector<double> m(2);
+    mckl::Vector<double> r(2);
+    mckl::Vector<double> e(2);
+    chains.mean(m.begin());
+    chains.rhat(r.begin());
+    chains.ess(e.begin());
+
+    bool pass = chains.num_monitor() == n;
+    pass = pass && algorithm_mcmc_chains_close(m[0], mean);
+    pass = pass && algorithm_mcmc_chains_close(r[0], rhat);
+    pass = pass && algorithm_mcmc_chains_close(e[0], ess);
+
+    // The AR(1) chain with rho = 0.5 has ESS n * K / 3
+    pass = pass && std::abs(m[0]) < 0.05;
+    pass = pass && std::abs(m[1] - 1) < 0.05;
+    pass = pass && r[0] < 1.01;
+    pass = pass && std::abs(e[0] / (n * K / 3.0) - 1) < 0.2;
+
+    return pass;
+}
+
+// Chains with different stationary distributions have large R-hat
+inline bool algorithm_mcmc_chains_rhat(std::size_t K, std::size_t n)
+{
+    mckl::Vector<double> mu(K);
+    for (std::size_t k = 0; k != K; ++k)
+        mu[k] = static_cast<double>(k);
+    AlgorithmMCMCChains chains(K);
+    mckl::Vector<mckl::Vector<double>> path;
+    algorithm_mcmc_chains_setup(chains, mu, 0.5, 0, path, 100);
+    chains.iterate(n);
+
+    mckl::Vector<double> r(2);
+    chains.rhat(r.begin());
+    bool pass = r[0] > 1.5;
+
+    AlgorithmMCMCChains single(1);
+    algorithm_mcmc_chains_setup(single, mu, 0.5, 0, path, 100);
+    single.iterate(n);
+    single.rhat(r.begin());
+    pass = pass && std::isnan(r[0]);
+
+    return pass;
+}
+
+// The chains use distinct streams, and the results do not depend on how the
+// chains are scheduled
+template <typename Run>
+inline bool algorithm_mcmc_chains_run(std::size_t K, std::size_t n, Run run)
+{
+    mckl::Vector<double> mu(K, 0.0);
+    mckl::Vector<mckl::Vector<double>> path1;
+    mckl::Vector<mckl::Vector<double>> path2;
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    AlgorithmMCMCChains chains1(K);
+    algorithm_mcmc_chains_setup(chains1, mu, 0.5, 0, path1, 10);
+    chains1.iterate(n);
+    chains1.iterate(n);
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    AlgorithmMCMCChains chains2(K);
+    algorithm_mcmc_chains_setup(chains2, mu, 0.5, 0, path2, 10);
+    chains2.run(run);
+    chains2.iterate(n);
+    chains2.iterate(n);
+
+    bool pass = path1 == path2;
+    for (std::size_t k = 0; k != K; ++k) {
+        pass = pass && path1[k].size() == 2 * n;
+        const double zk = path1[k].front() - 0.5 * k;
+        for (std::size_t j = 0; j != k; ++j)
+            pass = pass && zk != path1[j].front() - 0.5 * j;
+    }
+
+    mckl::Vector<double> r1(6);
+    mckl::Vector<double> r2(6);
+    chains1.mean(r1.begin());
+    chains1.rhat(r1.begin() + 2);
+    chains1.ess(r1.begin() + 4);
+    chains2.mean(r2.begin());
+    chains2.rhat(r2.begin() + 2);
+    chains2.ess(r2.begin() + 4);
+    pass = pass && r1 == r2;
+
+    return pass;
+}
+
+// The pooled acceptance rate agrees with the accept histories of the chains
+inline bool algorithm_mcmc_chains_accept(std::size_t K, std::size_t n)
+{
+    AlgorithmMCMCChains chains(K);
+    chains.mutation([](std::size_t, mckl::RNG &rng) {
+        return AlgorithmMCMCChainsRW(rng);
+    });
+    chains.run(mckl::RunSMP<mckl::BackendSTD>());
+    chains.iterate(n);
+
+    std::size_t accept = 0;
+    bool pass = true;
+    for (std::size_t k = 0; k != K; ++k) {
+        mckl::Vector<std::size_t> a(chains.chain(k).num_iter());
+        chains.chain(k).read_accept_history(0, a.begin());
+        std::size_t c = 0;
+        for (auto v : a)
+            c += v;
+        pass = pass && c == chains.chain(k).accept_count(0);
+        accept += c;
+    }
+    pass = pass && chains.chain(0).accept_count(1) == 0;
+    const double rate = chains.accept_rate(0);
+    pass = pass && rate == static_cast<double>(accept) / (n * K);
+    pass = pass && rate > 0.2 && rate < 0.6;
+
+    chains.chain(0).clear();
+    pass = pass && chains.chain(0).accept_count(0) == 0;
+
+    return pass;
+}
+
+inline void algorithm_mcmc_chains(std::size_t K, std::size_t n)
+{
+    mckl::BackendSTD::instance().np(4);
+
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 =
+        algorithm_mcmc_chains_run(
+        K, n / 10, mckl::RunSMP<mckl::BackendSTD>());
+    std::cout << std::setw(60) << std::left << "MCMCChains RunSMP<BackendSTD>";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 =
+        algorithm_mcmc_chains_run(
+        K, n / 10, mckl::RunSMP<mckl::BackendOMP>());
+    std::cout << std::setw(60) << std::left << "MCMCChains RunSMP<BackendOMP>";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_mcmc_chains_monitor(K, n, 100);
+    std::cout << std::setw(60) << std::left << "MCMCChains monitor";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = algorithm_mcmc_chains_rhat(K, n / 10);
+    std::cout << std::setw(60) << std::left << "MCMCChains rhat";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = algorithm_mcmc_chains_accept(K, n / 10);
+    std::cout << std::setw(60) << std::left << "MCMCChains accept";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_MCMC_CHAINS_HPP
@@ -0,0 +1,299 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_mh.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_MH_HPP
+#define MCKL_EXAMPLE_ALGORITHM_MH_HPP
+
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/mh.hpp>
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <iomanip>
+#include <iostream>
+
+using AlgorithmMHState = mckl::StateMatrix<mckl::RowMajor, double>;
+
+constexpr std::size_t algorithm_mh_dim = 3;
+
+// The target is a Gaussian with independent components
+inline const double *algorithm_mh_mean()
+{
+    static const double mean[algorithm_mh_dim] = {1, -2, 0.5};
+
+    return mean;
+}
+
+inline const double *algorithm_mh_sd()
+{
+    static const double sd[algorithm_mh_dim] = {1, 3, 0.2};
+
+    return sd;
+}
+
+inline void algorithm_mh_target(
+    std::size_t, std::size_t n, std::size_t dim, const double *x, double *r)
+{
+    const double *mean = algorithm_mh_mean();
+    const double *sd = algorithm_mh_sd();
+    for (std::size_t i = 0; i != n; ++i, x += dim) {
+        r[i] = 0;
+        for (std::size_t j = 0; j != dim; ++j) {
+            const double z = (x[j] - mean[j]) / sd[j];
+            r[i] -= 0.5 * z * z;
+        }
+    }
+}
+
+// The weighted mean and standard deviation of each component are close to
+// those of the target
+inline bool algorithm_mh_moments(std::size_t n, const double *x,
+    const double *w, double tmean, double tsd)
+{
+    const std::size_t dim = algorithm_mh_dim;
+    const double *mean = algorithm_mh_mean();
+    const double *sd = algorithm_mh_sd();
+
+    bool pass = true;
+    for (std::size_t j = 0; j != dim; ++j) {
+        double s = 0;
+        double m = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            const double v = w == nullptr ? 1.0 : w[i];
+            s += v;
+            m += v * x[i * dim + j];
+        }
+        m /= s;
+        double q = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            const double v = w == nullptr ? 1.0 : w[i];
+            const double d = x[i * dim + j] - m;
+            q += v * d * d;
+        }
+        q = std::sqrt(q / s);
+        pass = pass && std::abs(m - mean[j]) < tmean * sd[j];
+        pass = pass && std::abs(q - sd[j]) < tsd * sd[j];
+    }
+
+    return pass;
+}
+
+// Particles drawn from the target stay so after they are moved, and most of
+// them are actually moved
+inline bool algorithm_mh_smc(std::size_t N, mckl::MHProposal proposal)
+{
+    const std::size_t dim = algorithm_mh_dim;
+    const double *mean = algorithm_mh_mean();
+    const double *sd = algorithm_mh_sd();
+
+    mckl::SMCSampler<AlgorithmMHState> sampler(N, dim);
+    auto &state = sampler.particle().state();
+    mckl::RNG rng;
+    for (std::size_t j = 0; j != dim; ++j) {
+        mckl::NormalDistribution<double> normal(mean[j], sd[j]);
+        for (std::size_t i = 0; i != N; ++i)
+            state(i, j) = normal(rng);
+    }
+    const AlgorithmMHState init(state);
+
+    mckl::AdaptiveMH<double> mh(dim, algorithm_mh_target, proposal);
+    mh.run(mckl::RunSMP<mckl::BackendSTD>());
+    sampler.mutation(std::ref(mh));
+    sampler.iterate(5);
+
+    bool pass = mh.num_repeat() >= 1 && mh.num_repeat() <= mh.max_repeat();
+    pass = pass && mh.accept_rate() > 0.05 && mh.accept_rate() < 1;
+
+    std::size_t moved = 0;
+    for (std::size_t i = 0; i != N; ++i)
+        moved += state(i, 0) != init(i, 0) ? 1 : 0;
+    pass = pass && moved > N * 9 / 10;
+
+    return pass &&
+        algorithm_mh_moments(
+            N, state.data(), sampler.particle().weight().data(), 0.05, 0.05);
+}
+
+// Weighted particles drawn from a wide Gaussian target the same
+inline bool algorithm_mh_smc_weighted(std::size_t N)
+{
+    const std::size_t dim = algorithm_mh_dim;
+
+    mckl::SMCSampler<AlgorithmMHState> sampler(N, dim);
+    auto &state = sampler.particle().state();
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 4);
+    mckl::rand(rng, normal, N * dim, state.data());
+    mckl::Vector<double> lw(N);
+    algorithm_mh_target(0, N, dim, state.data(), lw.data());
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t j = 0; j != dim; ++j)
+            lw[i] += state(i, j) * state(i, j) / 32;
+    sampler.particle().weight().set_log(lw.data());
+
+    mckl::AdaptiveMH<double> mh(dim, algorithm_mh_target);
+    sampler.mutation(std::ref(mh));
+    sampler.iterate(5);
+
+    return algorithm_mh_moments(
+        N, state.data(), sampler.particle().weight().data(), 0.2, 0.2);
+}
+
+// A single chain approaches the target
+inline bool algorithm_mh_mcmc(std::size_t n, mckl::MHProposal proposal)
+{
+    const std::size_t dim = algorithm_mh_dim;
+
+    mckl::MCMCSampler<mckl::Vector<double>> sampler(dim, 0.0);
+    mckl::AdaptiveMH<double> mh(dim, algorithm_mh_target, proposal);
+    sampler.mutation(std::ref(mh));
+
+    const std::size_t burnin = n / 10;
+    sampler.iterate(burnin);
+    mckl::Vector<double> x(n * dim);
+    for (std::size_t i = 0; i != n; ++i) {
+        sampler.iterate();
+        std::copy_n(sampler.state().data(), dim, x.data() + i * dim);
+    }
+
+    const bool pass = mh.accept_rate() > 0.05 && mh.accept_rate() < 1;
+
+    return pass && algorithm_mh_moments(n, x.data(), nullptr, 0.1, 0.1);
+}
+
+// The log density of the current state is evaluated on every call, unless
+// caching is enabled
+inline bool algorithm_mh_cache(std::size_t n)
+{
+    const std::size_t dim = algorithm_mh_dim;
+
+    mckl::Vector<double> points;
+    auto eval = [&](std::size_t iter, std::size_t m, std::size_t d,
+                    const double *x, double *r) {
+        points.insert(points.end(), x, x + m * d);
+        algorithm_mh_target(iter, m, d, x, r);
+    };
+
+    bool pass = true;
+    mckl::Vector<double> x(dim, 0.0);
+    mckl::AdaptiveMH<double> mh(dim, eval);
+    for (std::size_t i = 0; i != n; ++i) {
+        // Another move changes the state between the calls
+        x[i % dim] += 1;
+        const mckl::Vector<double> y(x);
+        points.clear();
+        mh(i, x);
+        pass = pass && points.size() == 2 * dim;
+        pass = pass && std::equal(y.begin(), y.end(), points.begin());
+    }
+
+    mckl::AdaptiveMH<double> mhc(dim, eval);
+    mhc.cache(true);
+    for (std::size_t i = 0; i != n; ++i) {
+        points.clear();
+        mhc(i, x);
+        pass = pass && points.size() == (i == 0 ? 2 : 1) * dim;
+    }
+
+    return pass;
+}
+
+// The MCMC move draws from the engine given to the constructor
+inline bool algorithm_mh_rng(std::size_t n)
+{
+    const std::size_t dim = algorithm_mh_dim;
+
+    mckl::RNG rng(101);
+    mckl::AdaptiveMH<double> mh1(dim, algorithm_mh_target, rng);
+    mckl::AdaptiveMH<double> mh2(dim, algorithm_mh_target, rng);
+    mckl::Vector<double> x1(dim, 0.0);
+    mckl::Vector<double> x2(dim, 0.0);
+    bool pass = mh1.rng() == rng;
+    for (std::size_t i = 0; i != n; ++i) {
+        mh1(i, x1);
+        mh2(i, x2);
+    }
+    pass = pass && x1 == x2 && mh1.rng() == mh2.rng() && !(mh1.rng() == rng);
+
+    mh2.rng() = rng;
+    mh2.reset();
+    std::fill(x2.begin(), x2.end(), 0.0);
+    mckl::AdaptiveMH<double> mh3(dim, algorithm_mh_target, rng);
+    mckl::Vector<double> x3(dim, 0.0);
+    mh2.scale(mh3.scale());
+    for (std::size_t i = 0; i != n; ++i) {
+        mh2(i, x2);
+        mh3(i, x3);
+    }
+
+    return pass && x2 == x3;
+}
+
+inline void algorithm_mh(std::size_t N, std::size_t n)
+{
+    // More threads than processors if need be
+    mckl::BackendSTD::instance().np(4);
+
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 = algorithm_mh_smc(N, mckl::MHProposal::RandomWalk);
+    std::cout << std::setw(60) << std::left << "SMC RandomWalk";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_mh_smc(N, mckl::MHProposal::Independent);
+    std::cout << std::setw(60) << std::left << "SMC Independent";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_mh_smc_weighted(N);
+    std::cout << std::setw(60) << std::left << "SMC weighted";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = algorithm_mh_mcmc(n, mckl::MHProposal::RandomWalk);
+    std::cout << std::setw(60) << std::left << "MCMC RandomWalk";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = algorithm_mh_mcmc(n, mckl::MHProposal::Independent);
+    std::cout << std::setw(60) << std::left << "MCMC Independent";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 = algorithm_mh_cache(100);
+    std::cout << std::setw(60) << std::left << "MCMC cache";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass7 = algorithm_mh_rng(100);
+    std::cout << std::setw(60) << std::left << "MCMC RNG";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_MH_HPP
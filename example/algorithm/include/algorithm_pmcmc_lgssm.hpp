@@ -0,0 +1,590 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_pmcmc_lgssm.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_PMCMC_LGSSM_HPP
+#define MCKL_EXAMPLE_ALGORITHM_PMCMC_LGSSM_HPP
+
+#define MCKL_NO_RUNTIME_ASSERT 0
+#define MCKL_RUNTIME_ASSERT_AS_EXCEPTION 1
+
+#include <mckl/algorithm/pmcmc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+// The linear Gaussian state space model
+// X_0 ~ N(0, 1), X_t = phi X_{t - 1} + N(0, 1), Y_t = X_t + N(0, 1),
+// with a uniform prior of phi on (-1, 1), of which the likelihood is computed
+// exactly by the Kalman filter
+
+using AlgorithmPMCMCLGSSMParam = std::array<double, 1>;
+
+// A state with the parameter and the normalizing constant, but without the
+// auxiliary random numbers of the correlated mode
+class AlgorithmPMCMCLGSSMPlain
+    : public mckl::StateMatrix<mckl::ColMajor, double, 1>
+{
+  public:
+    using param_type = AlgorithmPMCMCLGSSMParam;
+
+    using mckl::StateMatrix<mckl::ColMajor, double, 1>::StateMatrix;
+
+    double log_nc() const { return log_nc_; }
+
+    void add_log_nc(double nc) { log_nc_ += nc; }
+
+    const param_type &param() { return param_; }
+
+    void reset(const param_type &p, double nc = 0)
+    {
+        param_ = p;
+        log_nc_ = nc;
+    }
+
+  private:
+    param_type param_;
+    double log_nc_ = 0;
+}; // class AlgorithmPMCMCLGSSMPlain
+
+using AlgorithmPMCMCLGSSMState =
+    mckl::PMCMCStateMatrix<AlgorithmPMCMCLGSSMParam, mckl::ColMajor, double,
+        1>;
+
+inline const mckl::Vector<double> &algorithm_pmcmc_lgssm_data()
+{
+    static mckl::Vector<double> y;
+    if (y.empty()) {
+        constexpr std::size_t n = 50;
+        constexpr double phi = 0.8;
+        mckl::RNG rng(101);
+        mckl::NormalDistribution<double> normal(0, 1);
+        double x = normal(rng);
+        for (std::size_t t = 0; t != n; ++t) {
+            if (t != 0)
+                x = phi * x + normal(rng);
+            y.push_back(x + normal(rng));
+        }
+    }
+
+    return y;
+}
+
+inline double algorithm_pmcmc_lgssm_kalman(double phi)
+{
+    const double log2pi = std::log(2 * mckl::const_pi<double>());
+    const mckl::Vector<double> &y = algorithm_pmcmc_lgssm_data();
+    double m = 0;
+    double p = 1;
+    double llh = 0;
+    for (std::size_t t = 0; t != y.size(); ++t) {
+        if (t != 0) {
+            m = phi * m;
+            p = phi * phi * p + 1;
+        }
+        const double s = p + 1;
+        const double e = y[t] - m;
+        llh -= 0.5 * (log2pi + std::log(s) + e * e / s);
+        m += p / s * e;
+        p -= p * p / s;
+    }
+
+    return llh;
+}
+
+// The posterior mean of phi computed on a grid
+inline double algorithm_pmcmc_lgssm_posterior_mean()
+{
+    constexpr std::size_t n = 2000;
+    mckl::Vector<double> phi(n);
+    mckl::Vector<double> llh(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        phi[i] = -1 + (i + 0.5) * 2 / n;
+        llh[i] = algorithm_pmcmc_lgssm_kalman(phi[i]);
+    }
+    const double lmax = *std::max_element(llh.begin(), llh.end());
+    double s = 0;
+    double m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        const double w = std::exp(llh[i] - lmax);
+        s += w;
+        m += w * phi[i];
+    }
+
+    return m / s;
+}
+
+inline const double *algorithm_pmcmc_lgssm_aux(
+    const AlgorithmPMCMCLGSSMState &state, std::size_t iter)
+{
+    return state.aux(iter);
+}
+
+inline const double *algorithm_pmcmc_lgssm_aux(
+    const AlgorithmPMCMCLGSSMPlain &, std::size_t)
+{
+    return nullptr;
+}
+
+// The bootstrap particle filter, which uses the auxiliary random numbers of
+// the state if there are any
+template <typename T>
+class AlgorithmPMCMCLGSSMSelection
+{
+  public:
+    void operator()(std::size_t iter, mckl::Particle<T> &particle)
+    {
+        const double log2pi = std::log(2 * mckl::const_pi<double>());
+        const double phi = particle.state().param()[0];
+        const double y = algorithm_pmcmc_lgssm_data()[iter];
+        const std::size_t N = particle.size();
+        double *const x = particle.state().col_data(0);
+
+        if (iter == 0)
+            particle.weight().set_equal();
+
+        z_.resize(N);
+        w_.resize(N);
+        const double *z = algorithm_pmcmc_lgssm_aux(particle.state(), iter);
+        if (z == nullptr) {
+            mckl::NormalDistribution<double> normal(0, 1);
+            mckl::rand(particle.rng(), normal, N, z_.data());
+            z = z_.data();
+        }
+        for (std::size_t i = 0; i != N; ++i) {
+            x[i] = (iter == 0 ? 0 : phi * x[i]) + z[i];
+            w_[i] = -0.5 * (log2pi + (y - x[i]) * (y - x[i]));
+        }
+
+        const double *const v = particle.weight().data();
+        const double lmax = *std::max_element(w_.begin(), w_.end());
+        double s = 0;
+        for (std::size_t i = 0; i != N; ++i)
+            s += v[i] * std::exp(w_[i] - lmax);
+        particle.state().add_log_nc(lmax + std::log(s));
+        particle.weight().add_log(w_.data());
+    }
+
+  private:
+    mckl::Vector<double> z_;
+    mckl::Vector<double> w_;
+}; // class AlgorithmPMCMCLGSSMSelection
+
+class AlgorithmPMCMCLGSSMPrior
+{
+  public:
+    double operator()(const AlgorithmPMCMCLGSSMParam &param)
+    {
+        return std::abs(param[0]) < 1 ? 0 : -mckl::const_inf<double>();
+    }
+}; // class AlgorithmPMCMCLGSSMPrior
+
+class AlgorithmPMCMCLGSSMUpdate
+{
+  public:
+    template <typename RNGType>
+    double operator()(RNGType &rng, AlgorithmPMCMCLGSSMParam &param)
+    {
+        mckl::NormalDistribution<double> normal(0, 0.15);
+        param[0] += normal(rng);
+
+        return 0;
+    }
+}; // class AlgorithmPMCMCLGSSMUpdate
+
+inline void algorithm_pmcmc_lgssm_resample(
+    mckl::SMCSampler<AlgorithmPMCMCLGSSMState> &pf)
+{
+    pf.resample(mckl::PMCMCResample<AlgorithmPMCMCLGSSMState>());
+}
+
+inline void algorithm_pmcmc_lgssm_resample(
+    mckl::SMCSampler<AlgorithmPMCMCLGSSMPlain> &pf)
+{
+    pf.resample(mckl::Stratified);
+}
+
+template <typename T>
+using AlgorithmPMCMCLGSSMMutation =
+    mckl::PMCMCMutation<AlgorithmPMCMCLGSSMParam, T>;
+
+template <typename T>
+inline AlgorithmPMCMCLGSSMMutation<T> algorithm_pmcmc_lgssm_mutation(
+    std::size_t N)
+{
+    AlgorithmPMCMCLGSSMMutation<T> mutation(
+        N, algorithm_pmcmc_lgssm_data().size(), AlgorithmPMCMCLGSSMPrior());
+    mutation.update(AlgorithmPMCMCLGSSMUpdate());
+    mutation.pf().selection(AlgorithmPMCMCLGSSMSelection<T>());
+    algorithm_pmcmc_lgssm_resample(mutation.pf());
+    mutation.pf().resample_threshold(0.5);
+
+    return mutation;
+}
+
+// Run a chain of n iterations after burn-in, and check the acceptance rate
+// and the posterior mean of phi
+template <typename Mutation>
+inline bool algorithm_pmcmc_lgssm_chain(std::size_t n, Mutation &&mutation,
+    double &accept, mckl::Vector<double> *path = nullptr)
+{
+    mckl::MCMCSampler<AlgorithmPMCMCLGSSMParam> sampler;
+    sampler.mutation(std::forward<Mutation>(mutation));
+    sampler.state()[0] = 0;
+    sampler.iterate(n / 10);
+    sampler.clear();
+
+    double mean = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        sampler.iterate();
+        mean += sampler.state()[0];
+        if (path != nullptr)
+            path->push_back(sampler.state()[0]);
+    }
+    mean /= n;
+    accept = static_cast<double>(sampler.accept_count(0)) / n;
+
+    return accept > 0.05 &&
+        std::abs(mean - algorithm_pmcmc_lgssm_posterior_mean()) < 0.03;
+}
+
+// The trait detecting aux(size, u) of the state
+inline bool algorithm_pmcmc_lgssm_trait()
+{
+    return mckl::internal::PMCMCHasAux<AlgorithmPMCMCLGSSMState>::value &&
+        !mckl::internal::PMCMCHasAux<AlgorithmPMCMCLGSSMPlain>::value;
+}
+
+// A state without aux(size, u) can be used with the correlated mode
+// disabled, and cannot enable it
+inline bool algorithm_pmcmc_lgssm_plain(std::size_t N, std::size_t n)
+{
+    auto mutation =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMPlain>(N);
+    bool pass = false;
+    try {
+        mutation.correlate(0.9, N);
+    } catch (const mckl::RuntimeAssert &) {
+        pass = true;
+    }
+    mutation.correlate(0, 0);
+
+    double accept = 0;
+    pass = pass && algorithm_pmcmc_lgssm_chain(n, mutation, accept);
+
+    return pass;
+}
+
+// The correlated mode keeps a reasonable acceptance rate with few particles
+inline bool algorithm_pmcmc_lgssm_correlated(std::size_t N, std::size_t n)
+{
+    const std::size_t M = N / 10;
+    auto independent =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(M);
+    auto correlated =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(M);
+    correlated.correlate(0.99, M);
+
+    double accept_independent = 0;
+    double accept_correlated = 0;
+    algorithm_pmcmc_lgssm_chain(n, independent, accept_independent);
+    bool pass = algorithm_pmcmc_lgssm_chain(n, correlated, accept_correlated);
+    pass = pass && accept_correlated > accept_independent;
+
+    return pass;
+}
+
+// An upper bound of the remaining increments of log_nc() after iteration
+// iter, since each is the log of a normal density of unit variance averaged
+// over the particles
+inline double algorithm_pmcmc_lgssm_bound(
+    std::size_t iter, const AlgorithmPMCMCLGSSMParam &)
+{
+    const double log2pi = std::log(2 * mckl::const_pi<double>());
+    const std::size_t n = algorithm_pmcmc_lgssm_data().size();
+
+    return -0.5 * log2pi * static_cast<double>(n - 1 - iter);
+}
+
+// In the correlated mode, the particle filter uses no random numbers other
+// than the auxiliary ones, and early rejection gives exactly the same chain
+inline bool algorithm_pmcmc_lgssm_early_reject(std::size_t N, std::size_t n)
+{
+    const std::size_t M = N / 10;
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    auto mutation =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(M);
+    mutation.correlate(0.99, M);
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    auto early = algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(M);
+    early.correlate(0.99, M);
+    early.early_reject(algorithm_pmcmc_lgssm_bound);
+
+    double accept = 0;
+    double accept_early = 0;
+    mckl::Vector<double> path;
+    mckl::Vector<double> path_early;
+    bool pass = algorithm_pmcmc_lgssm_chain(
+        n, std::ref(mutation), accept, &path);
+    pass = pass &&
+        algorithm_pmcmc_lgssm_chain(
+            n, std::ref(early), accept_early, &path_early);
+    pass = pass && path == path_early;
+    pass = pass && mutation.num_early_reject() == 0;
+    pass = pass && early.num_early_reject() > 0;
+
+    early.early_reject(nullptr);
+    const std::size_t num_early_reject = early.num_early_reject();
+    pass = pass &&
+        algorithm_pmcmc_lgssm_chain(n / 10, std::ref(early), accept);
+    pass = pass && early.num_early_reject() == num_early_reject;
+
+    return pass;
+}
+
+// Delayed acceptance with an approximate likelihood still targets the exact
+// posterior, alone and with early rejection
+inline bool algorithm_pmcmc_lgssm_surrogate(
+    std::size_t N, std::size_t n, bool early_reject)
+{
+    auto mutation =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(N);
+    mutation.surrogate([](const AlgorithmPMCMCLGSSMParam &param) {
+        return algorithm_pmcmc_lgssm_kalman(param[0]) +
+            0.5 * std::sin(10 * param[0]);
+    });
+    if (early_reject)
+        mutation.early_reject(algorithm_pmcmc_lgssm_bound);
+
+    double accept = 0;
+    bool pass = algorithm_pmcmc_lgssm_chain(n, std::ref(mutation), accept);
+    pass = pass && mutation.num_surrogate_reject() > 0;
+    pass = pass && (mutation.num_early_reject() > 0) == early_reject;
+
+    return pass;
+}
+
+using AlgorithmPMCMCLGSSMPool =
+    mckl::PMCMCFilterPool<AlgorithmPMCMCLGSSMParam, AlgorithmPMCMCLGSSMState>;
+
+inline void algorithm_pmcmc_lgssm_pool_setup(AlgorithmPMCMCLGSSMPool &pool)
+{
+    pool.each([](mckl::SMCSampler<AlgorithmPMCMCLGSSMState> &pf) {
+        pf.selection(AlgorithmPMCMCLGSSMSelection<AlgorithmPMCMCLGSSMState>());
+        pf.resample(mckl::Stratified);
+        pf.resample_threshold(0.5);
+    });
+}
+
+// The estimates do not depend on how the candidates are scheduled, and
+// their average is close to the exact log likelihood
+inline bool algorithm_pmcmc_lgssm_pool(std::size_t N, std::size_t n)
+{
+    constexpr std::size_t K = 4;
+    const std::size_t M = algorithm_pmcmc_lgssm_data().size();
+
+    mckl::Vector<AlgorithmPMCMCLGSSMParam> param(n);
+    for (std::size_t i = 0; i != n; ++i)
+        param[i][0] = i % 2 == 0 ? 0.8 : 0.5;
+
+    mckl::Vector<double> r1(n);
+    mckl::Vector<double> r2(n);
+    mckl::Vector<double> r3(n);
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    AlgorithmPMCMCLGSSMPool pool1(K, N, M);
+    algorithm_pmcmc_lgssm_pool_setup(pool1);
+    pool1.log_nc(n, param.data(), r1.data());
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    AlgorithmPMCMCLGSSMPool pool2(K, N, M);
+    algorithm_pmcmc_lgssm_pool_setup(pool2);
+    pool2.run(mckl::RunSMP<mckl::BackendSTD>());
+    pool2.log_nc(n, param.data(), r2.data());
+
+    mckl::Seed<mckl::RNG>::instance().set(101);
+    AlgorithmPMCMCLGSSMPool pool3(K, N, M);
+    algorithm_pmcmc_lgssm_pool_setup(pool3);
+    pool3.run(mckl::RunSMP<mckl::BackendSTD>());
+    pool3.outer_min(K + 1);
+    pool3.log_nc(n, param.data(), r3.data());
+
+    bool pass = pool1.size() == K && r1 == r2 && r1 == r3;
+
+    double m1 = 0;
+    double m2 = 0;
+    for (std::size_t i = 0; i != n; ++i)
+        (i % 2 == 0 ? m1 : m2) += r1[i];
+    m1 /= (n + 1) / 2;
+    m2 /= n / 2;
+    pass = pass && std::abs(m1 - algorithm_pmcmc_lgssm_kalman(0.8)) < 0.5;
+    pass = pass && std::abs(m2 - algorithm_pmcmc_lgssm_kalman(0.5)) < 0.5;
+
+    return pass;
+}
+
+// The multiple-try chain recovers the posterior mean, and accepts more
+// often than the single-try chain with the same particle filter
+inline bool algorithm_pmcmc_lgssm_multiple_try(std::size_t N, std::size_t n)
+{
+    constexpr std::size_t K = 4;
+    const std::size_t M = N / 10;
+
+    mckl::PMCMCMultipleTry<AlgorithmPMCMCLGSSMParam, AlgorithmPMCMCLGSSMState>
+        mutation(K, AlgorithmPMCMCLGSSMPrior(), M,
+            algorithm_pmcmc_lgssm_data().size());
+    mutation.update(AlgorithmPMCMCLGSSMUpdate());
+    algorithm_pmcmc_lgssm_pool_setup(mutation.pool());
+    mutation.pool().run(mckl::RunSMP<mckl::BackendSTD>());
+
+    auto single =
+        algorithm_pmcmc_lgssm_mutation<AlgorithmPMCMCLGSSMState>(M);
+
+    double accept = 0;
+    double accept_single = 0;
+    bool pass = algorithm_pmcmc_lgssm_chain(n, std::ref(mutation), accept);
+    algorithm_pmcmc_lgssm_chain(n, single, accept_single);
+    pass = pass && mutation.size() == K && accept > accept_single;
+
+    return pass;
+}
+
+// The resampling with the same auxiliary random numbers does not depend on
+// the order of the particles, since they are sorted first, by the state or
+// by a user supplied ordering
+inline bool algorithm_pmcmc_lgssm_resample_order(std::size_t N)
+{
+    using particle_type = mckl::Particle<AlgorithmPMCMCLGSSMState>;
+    using size_type = particle_type::size_type;
+
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal(0, 1);
+    mckl::U01Distribution<double> u01;
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> w(N);
+    mckl::Vector<double> z(N);
+    mckl::rand(rng, normal, N, x.data());
+    mckl::rand(rng, u01, N, w.data());
+    mckl::rand(rng, normal, N, z.data());
+    mckl::Vector<size_type> perm(N);
+    std::iota(perm.begin(), perm.end(), size_type(0));
+    std::shuffle(perm.begin(), perm.end(), rng);
+
+    auto resample = [&](mckl::PMCMCResample<AlgorithmPMCMCLGSSMState> &rs,
+                        bool permuted) {
+        particle_type particle(static_cast<size_type>(N));
+        mckl::Vector<double> v(N);
+        for (std::size_t i = 0; i != N; ++i) {
+            const std::size_t j = permuted ? perm[i] : i;
+            particle.state()(i, 0) = x[j];
+            v[i] = w[j];
+        }
+        particle.weight().set(v.data());
+        particle.state().aux(0, z.data());
+        rs(0, particle);
+        for (std::size_t i = 0; i != N; ++i) {
+            v[i] = particle.state()(i, 0);
+        }
+        std::sort(v.begin(), v.end());
+
+        return v;
+    };
+
+    mckl::PMCMCResample<AlgorithmPMCMCLGSSMState> rs1;
+    bool pass = resample(rs1, false) == resample(rs1, true);
+
+    // Descending order by a user supplied ordering
+    mckl::PMCMCResample<AlgorithmPMCMCLGSSMState> rs2(
+        [](std::size_t, const particle_type &particle, size_type *index) {
+            const auto &state = particle.state();
+            std::iota(index, index + state.size(), size_type(0));
+            std::sort(index, index + state.size(),
+                [&state](size_type i, size_type j) {
+                    return state(i, 0) > state(j, 0);
+                });
+        });
+    pass = pass && resample(rs2, false) == resample(rs2, true);
+
+    return pass;
+}
+
+inline void algorithm_pmcmc_lgssm(std::size_t N, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 = algorithm_pmcmc_lgssm_trait();
+    std::cout << std::setw(60) << std::left << "PMCMCMutation aux trait";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_pmcmc_lgssm_plain(N, n);
+    std::cout << std::setw(60) << std::left
+              << "PMCMCMutation state without aux";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_pmcmc_lgssm_correlated(N, n);
+    std::cout << std::setw(60) << std::left << "PMCMCMutation correlated";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = algorithm_pmcmc_lgssm_early_reject(N, n);
+    std::cout << std::setw(60) << std::left << "PMCMCMutation early rejection";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = algorithm_pmcmc_lgssm_surrogate(N, n, false);
+    std::cout << std::setw(60) << std::left
+              << "PMCMCMutation delayed acceptance";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 = algorithm_pmcmc_lgssm_surrogate(N, n, true);
+    std::cout << std::setw(60) << std::left
+              << "PMCMCMutation delayed acceptance with early rejection";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass7 = algorithm_pmcmc_lgssm_pool(N, n / 50);
+    std::cout << std::setw(60) << std::left << "PMCMCFilterPool";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass8 = algorithm_pmcmc_lgssm_multiple_try(N, n / 5);
+    std::cout << std::setw(60) << std::left << "PMCMCMultipleTry";
+    std::cout << std::setw(20) << std::right << (pass8 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass9 = algorithm_pmcmc_lgssm_resample_order(N);
+    std::cout << std::setw(60) << std::left << "PMCMCResample order";
+    std::cout << std::setw(20) << std::right << (pass9 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_PMCMC_LGSSM_HPP
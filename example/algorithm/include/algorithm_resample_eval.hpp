@@ -0,0 +1,217 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_resample_eval.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_RESAMPLE_EVAL_HPP
+#define MCKL_EXAMPLE_ALGORITHM_RESAMPLE_EVAL_HPP
+
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/core/matrix.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+template <mckl::MatrixLayout Layout>
+using AlgorithmResampleEvalState = mckl::StateMatrix<Layout, double>;
+
+template <typename T, typename RNGType>
+inline void algorithm_resample_eval_fill(RNGType &rng, T &state)
+{
+    mckl::U01Distribution<double> u01;
+    mckl::rand(rng, u01, state.size() * state.dim(), state.data());
+}
+
+// Changing the number of rows of a column major matrix with enough capacity
+// keeps the storage and the values of the remaining rows
+inline bool algorithm_resample_eval_resize(std::size_t N, std::size_t dim)
+{
+    mckl::RNG rng;
+    mckl::Matrix<double, mckl::ColMajor> m(N, dim);
+    m.reserve(N * 2, dim);
+    mckl::U01Distribution<double> u01;
+    mckl::rand(rng, u01, N * dim, m.data());
+    const mckl::Matrix<double, mckl::ColMajor> r(m);
+    const double *data = m.data();
+
+    bool pass = true;
+
+    const std::size_t n = N / 2;
+    m.resize(n, dim);
+    for (std::size_t j = 0; j != dim; ++j)
+        for (std::size_t i = 0; i != n; ++i)
+            pass = pass && m(i, j) == r(i, j);
+    pass = pass && m.data() == data;
+
+    const std::size_t M = N * 2;
+    m.resize(M, dim);
+    for (std::size_t j = 0; j != dim; ++j) {
+        for (std::size_t i = 0; i != n; ++i)
+            pass = pass && m(i, j) == r(i, j);
+        for (std::size_t i = n; i != M; ++i)
+            pass = pass && m(i, j) == 0;
+    }
+    pass = pass && m.data() == data;
+
+    return pass;
+}
+
+// Selecting a sample of a different size in-place gives the rows of the
+// parent indices and keeps the storage if the capacity suffices
+template <mckl::MatrixLayout Layout>
+inline bool algorithm_resample_eval_select(
+    std::size_t N, std::size_t M, std::size_t dim)
+{
+    mckl::RNG rng;
+    AlgorithmResampleEvalState<Layout> state(N, dim);
+    state.reserve(std::max(N, M));
+    algorithm_resample_eval_fill(rng, state);
+    const AlgorithmResampleEvalState<Layout> parent(state);
+    const double *data = state.data();
+
+    mckl::Vector<double> w(N);
+    mckl::U01Distribution<double> u01;
+    mckl::rand(rng, u01, N, w.data());
+    const double sum = std::accumulate(w.begin(), w.end(), 0.0);
+    for (auto &v : w)
+        v /= sum;
+
+    mckl::Vector<std::size_t> rep(N);
+    mckl::Vector<std::size_t> idx(M);
+    mckl::ResampleMultinomial resample;
+    resample(N, M, rng, w.data(), rep.data());
+    mckl::resample_trans_rep_index(N, M, rep.data(), idx.data());
+    state.select(M, idx.data());
+
+    bool pass = state.size() == M && state.data() == data;
+    for (std::size_t i = 0; i != M; ++i)
+        for (std::size_t j = 0; j != dim; ++j)
+            pass = pass && state(i, j) == parent(idx[i], j);
+
+    return pass;
+}
+
+// Repeated resampling gives the same sample as the reference selection and
+// reuses the storage of the state, with const resampling objects
+template <mckl::MatrixLayout Layout, typename ResampleType>
+inline bool algorithm_resample_eval_step(std::size_t N, std::size_t dim)
+{
+    using T = AlgorithmResampleEvalState<Layout>;
+
+    mckl::RNG rng;
+    mckl::Particle<T> particle(N, dim);
+    algorithm_resample_eval_fill(rng, particle.state());
+    const double *data = particle.state().data();
+
+    const mckl::ResampleEval<T> eval((ResampleType()));
+    mckl::Vector<double> w(N);
+    mckl::Vector<std::size_t> rep(N);
+    mckl::Vector<std::size_t> idx(N);
+    mckl::U01Distribution<double> u01;
+
+    bool pass = true;
+    for (std::size_t k = 0; k != 10; ++k) {
+        mckl::rand(rng, u01, N, w.data());
+        particle.weight().set(w.data());
+        mckl::Particle<T> ref(particle);
+        eval(k, particle);
+
+        const ResampleType resample = ResampleType();
+        resample(N, N, ref.rng(), ref.weight().data(), rep.data());
+        mckl::resample_trans_rep_index(N, N, rep.data(), idx.data());
+        const T &state = particle.state();
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != dim; ++j)
+                pass = pass && state(i, j) == ref.state()(idx[i], j);
+        pass = pass && particle.state().data() == data;
+    }
+
+    return pass;
+}
+
+template <mckl::MatrixLayout Layout>
+inline void algorithm_resample_eval_layout(
+    std::size_t N, std::size_t dim, const std::string &layout)
+{
+    const bool pass1 = algorithm_resample_eval_select<Layout>(N, N / 2, dim);
+    std::cout << std::setw(60) << std::left << layout + " select (shrink)";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_resample_eval_select<Layout>(N, N * 2, dim);
+    std::cout << std::setw(60) << std::left << layout + " select (grow)";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_resample_eval_step<Layout,
+        mckl::ResampleMultinomial>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " Multinomial";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 =
+        algorithm_resample_eval_step<Layout, mckl::ResampleStratified>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " Stratified";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 =
+        algorithm_resample_eval_step<Layout, mckl::ResampleSystematic>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " Systematic";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 =
+        algorithm_resample_eval_step<Layout, mckl::ResampleResidual>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " Residual";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass7 = algorithm_resample_eval_step<Layout,
+        mckl::ResampleResidualStratified>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " ResidualStratified";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass8 = algorithm_resample_eval_step<Layout,
+        mckl::ResampleResidualSystematic>(N, dim);
+    std::cout << std::setw(60) << std::left << layout + " ResidualSystematic";
+    std::cout << std::setw(20) << std::right << (pass8 ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+inline void algorithm_resample_eval(std::size_t N, std::size_t dim)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass9 = algorithm_resample_eval_resize(N, dim);
+    std::cout << std::setw(60) << std::left << "ColMajor resize";
+    std::cout << std::setw(20) << std::right << (pass9 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    algorithm_resample_eval_layout<mckl::RowMajor>(N, dim, "RowMajor");
+    algorithm_resample_eval_layout<mckl::ColMajor>(N, dim, "ColMajor");
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_RESAMPLE_EVAL_HPP
@@ -0,0 +1,229 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_smc_fuse.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_SMC_FUSE_HPP
+#define MCKL_EXAMPLE_ALGORITHM_SMC_FUSE_HPP
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/smp/backend_omp.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using AlgorithmSMCFuseState = mckl::StateMatrix<mckl::RowMajor, double, 2>;
+
+using AlgorithmSMCFuseSampler = mckl::SMCSampler<AlgorithmSMCFuseState>;
+
+using AlgorithmSMCFuseEstimator = AlgorithmSMCFuseSampler::estimator_type;
+
+inline void algorithm_smc_fuse_eval(
+    std::size_t iter, mckl::Particle<AlgorithmSMCFuseState> &particle)
+{
+    const std::size_t N = particle.size();
+    mckl::Vector<double> l(N);
+    for (std::size_t i = 0; i != N; ++i) {
+        const double x = 1e-3 * static_cast<double>((i + 1) * (iter + 1));
+        particle.state()(i, 0) = std::cos(x);
+        particle.state()(i, 1) = std::sin(x / 2);
+        l[i] = 2 * std::sin(x);
+    }
+    particle.weight().set_log(l.data());
+}
+
+// The k-th value of particle i, the same for the fused and unfused estimators
+inline double algorithm_smc_fuse_value(
+    const mckl::Particle<AlgorithmSMCFuseState> &particle, std::size_t i,
+    std::size_t k)
+{
+    const double x = particle.state()(i, 0);
+    const double y = particle.state()(i, 1);
+
+    const double p = static_cast<double>(k + 1);
+
+    return std::pow(x, p) + static_cast<double>(k) * y;
+}
+
+inline void algorithm_smc_fuse_full(std::size_t, std::size_t dim,
+    mckl::Particle<AlgorithmSMCFuseState> &particle, double *r)
+{
+    const std::size_t N = particle.size();
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t k = 0; k != dim; ++k)
+            r[i * dim + k] = algorithm_smc_fuse_value(particle, i, k);
+}
+
+inline void algorithm_smc_fuse_range(std::size_t, std::size_t dim,
+    const mckl::ParticleRange<AlgorithmSMCFuseState> &range, double *r)
+{
+    const std::size_t ibegin = range.ibegin();
+    const std::size_t iend = range.iend();
+    for (std::size_t i = ibegin; i != iend; ++i)
+        for (std::size_t k = 0; k != dim; ++k)
+            r[(i - ibegin) * dim + k] =
+                algorithm_smc_fuse_value(range.particle(), i, k);
+}
+
+inline void algorithm_smc_fuse_record(std::size_t iter, std::size_t dim,
+    mckl::Particle<AlgorithmSMCFuseState> &particle, double *r)
+{
+    for (std::size_t k = 0; k != dim; ++k)
+        r[k] = static_cast<double>(iter + k * particle.size());
+}
+
+// Estimators 0 to m - 1 are unfused, m to 2 * m - 1 are fused with the same
+// values, and the last is a record only estimator that is never fused
+inline void algorithm_smc_fuse_init(AlgorithmSMCFuseSampler &sampler,
+    const mckl::Vector<std::size_t> &dims)
+{
+    sampler.mutation(algorithm_smc_fuse_eval);
+    for (std::size_t d : dims) {
+        sampler.mutation_estimator(
+            AlgorithmSMCFuseEstimator(d, algorithm_smc_fuse_full));
+    }
+    for (std::size_t d : dims) {
+        AlgorithmSMCFuseEstimator estimator(d, algorithm_smc_fuse_full);
+        estimator.fuse(algorithm_smc_fuse_range);
+        sampler.mutation_estimator(std::move(estimator));
+    }
+    AlgorithmSMCFuseEstimator record(
+        2, algorithm_smc_fuse_record, mckl::RowMajor, true);
+    record.fuse(algorithm_smc_fuse_range);
+    sampler.mutation_estimator(std::move(record));
+}
+
+inline bool algorithm_smc_fuse_close(std::size_t n, const double *x,
+    const double *y)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const double tol = 1e-12 * std::max(1.0, std::abs(y[i]));
+        if (!(std::abs(x[i] - y[i]) <= tol))
+            return false;
+    }
+
+    return true;
+}
+
+// The fused estimates match the unfused ones, and are exactly the same with
+// and without a parallel loop over the blocks
+template <typename Run>
+inline bool algorithm_smc_fuse_sampler(
+    std::size_t N, std::size_t n, Run &&run)
+{
+    const mckl::Vector<std::size_t> dims = {1, 3, 2};
+    const std::size_t m = dims.size();
+
+    AlgorithmSMCFuseSampler ref(N);
+    algorithm_smc_fuse_init(ref, dims);
+    ref.iterate(n);
+
+    AlgorithmSMCFuseSampler sampler(N);
+    algorithm_smc_fuse_init(sampler, dims);
+    run(sampler);
+    sampler.iterate(n);
+
+    bool pass = true;
+    for (std::size_t j = 0; j != m; ++j) {
+        const auto &unfused = sampler.mutation_estimator(j);
+        const auto &fused = sampler.mutation_estimator(m + j);
+        pass = pass && !unfused.fused() && fused.fused();
+        pass = pass && unfused.num_iter() == n && fused.num_iter() == n;
+        pass = pass &&
+            algorithm_smc_fuse_close(
+                n * dims[j], fused.data(), unfused.data());
+        pass = pass &&
+            std::equal(fused.data(), fused.data() + n * dims[j],
+                ref.mutation_estimator(m + j).data());
+    }
+
+    const auto &record = sampler.mutation_estimator(2 * m);
+    pass = pass && !record.fused() && record.num_iter() == n;
+    for (std::size_t i = 0; i != n; ++i) {
+        pass = pass && record.data()[i * 2] == static_cast<double>(i);
+        pass = pass && record.data()[i * 2 + 1] == static_cast<double>(i + N);
+    }
+
+    return pass;
+}
+
+inline bool algorithm_smc_fuse_none(std::size_t N, std::size_t n)
+{
+    return algorithm_smc_fuse_sampler(N, n, [](AlgorithmSMCFuseSampler &) {});
+}
+
+template <typename Backend>
+inline bool algorithm_smc_fuse_smp(std::size_t N, std::size_t n)
+{
+    return algorithm_smc_fuse_sampler(N, n, [](AlgorithmSMCFuseSampler &s) {
+        s.estimate_run(mckl::RunSMP<Backend>());
+    });
+}
+
+inline void algorithm_smc_fuse_test(std::size_t N, std::size_t n)
+{
+    std::stringstream ss;
+    ss << "N = " << N;
+    const std::string name(ss.str());
+
+    const bool pass1 = algorithm_smc_fuse_none(N, n);
+    std::cout << std::setw(40) << std::left << "SMCSampler fused";
+    std::cout << std::setw(20) << std::left << name;
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_smc_fuse_smp<mckl::BackendSTD>(N, n);
+    std::cout << std::setw(40) << std::left << "SMCSampler fused BackendSTD";
+    std::cout << std::setw(20) << std::left << name;
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_smc_fuse_smp<mckl::BackendOMP>(N, n);
+    std::cout << std::setw(40) << std::left << "SMCSampler fused BackendOMP";
+    std::cout << std::setw(20) << std::left << name;
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+inline void algorithm_smc_fuse(std::size_t N, std::size_t n)
+{
+    const std::size_t block = mckl::internal::BufferSize<double>::value;
+
+    std::cout << std::string(80, '=') << std::endl;
+    algorithm_smc_fuse_test(0, n);
+    algorithm_smc_fuse_test(1, n);
+    algorithm_smc_fuse_test(block - 1, n);
+    algorithm_smc_fuse_test(block, n);
+    algorithm_smc_fuse_test(block * 3 + 17, n);
+    algorithm_smc_fuse_test(N, n);
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_SMC_FUSE_HPP
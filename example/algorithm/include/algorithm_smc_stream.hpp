@@ -0,0 +1,340 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_smc_stream.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_SMC_STREAM_HPP
+#define MCKL_EXAMPLE_ALGORITHM_SMC_STREAM_HPP
+
+#define MCKL_NO_RUNTIME_ASSERT 0
+#define MCKL_RUNTIME_ASSERT_AS_EXCEPTION 1
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/estimate_matrix.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using AlgorithmSMCStreamState = mckl::StateMatrix<mckl::RowMajor, double, 1>;
+
+using AlgorithmSMCStreamSampler = mckl::SMCSampler<AlgorithmSMCStreamState>;
+
+// Collect the chunks handed to the sink of an EstimateMatrix, and check that
+// they are contiguous and no larger than the capacity
+class AlgorithmSMCStreamSink
+{
+  public:
+    AlgorithmSMCStreamSink(std::size_t capacity)
+        : capacity_(capacity), pass_(true)
+    {
+    }
+
+    bool pass() const { return pass_; }
+
+    const mckl::Vector<double> &data() const { return data_; }
+
+    mckl::EstimateMatrix<double>::sink_type sink()
+    {
+        return [this](std::size_t offset, std::size_t n, std::size_t dim,
+                   const double *data) {
+            pass_ = pass_ && n != 0 && n <= capacity_;
+            pass_ = pass_ && offset * dim == data_.size();
+            data_.insert(data_.end(), data, data + n * dim);
+        };
+    }
+
+  private:
+    std::size_t capacity_;
+    bool pass_;
+    mckl::Vector<double> data_;
+}; // class AlgorithmSMCStreamSink
+
+inline bool algorithm_smc_stream_equal(std::size_t n, const double *x,
+    const double *y, std::size_t m = 0)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        if (std::isnan(x[i]) && std::isnan(y[i]))
+            continue;
+        if (x[i] != y[i])
+            return false;
+    }
+
+    return m == 0 || m == n;
+}
+
+// All estimates are passed to the sink in order, while the buffer is never
+// reallocated
+inline bool algorithm_smc_stream_matrix(
+    std::size_t n, std::size_t capacity, std::size_t dim)
+{
+    AlgorithmSMCStreamSink sink(capacity);
+    mckl::EstimateMatrix<double> m(dim);
+    m.stream(capacity, sink.sink());
+    const double *data = m.data();
+
+    mckl::Vector<double> r(n * dim);
+    for (std::size_t i = 0; i != r.size(); ++i)
+        r[i] = static_cast<double>(i);
+
+    bool pass = m.capacity() == capacity;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (i % 2 == 0)
+            m.insert_estimate(r.data() + i * dim);
+        else
+            m.insert_estimate(i, r.data() + i * dim);
+        pass = pass && m.num_iter() <= capacity;
+        pass = pass && m.offset() + m.num_iter() == i + 1;
+        pass = pass && m.data() == data;
+    }
+    pass = pass && sink.data().size() == m.offset() * dim;
+    pass = pass &&
+        algorithm_smc_stream_equal(m.num_iter() * dim, m.data(),
+            r.data() + m.offset() * dim);
+
+    m.flush();
+    pass = pass && sink.pass() && m.num_iter() == 0 && m.offset() == n;
+    pass = pass &&
+        algorithm_smc_stream_equal(
+            r.size(), sink.data().data(), r.data(), sink.data().size());
+
+    return pass;
+}
+
+// Skipped iterations are filled with NaN, even across a flush, and flushed
+// iterations can no longer be written
+inline bool algorithm_smc_stream_gap()
+{
+    const std::size_t dim = 2;
+    const std::size_t capacity = 4;
+    AlgorithmSMCStreamSink sink(capacity);
+    mckl::EstimateMatrix<double> m(dim);
+    m.stream(capacity, sink.sink());
+
+    const double nan = -mckl::const_nan<double>();
+    const double x[dim] = {1, 2};
+    const double y[dim] = {3, 4};
+    const double z[dim] = {5, 6};
+    m.insert_estimate(0, x);
+    m.insert_estimate(6, y);
+    bool pass = m.offset() == 4 && m.num_iter() == 3;
+
+    m.insert_estimate(5, z);
+    const double head[capacity * dim] = {1, 2, nan, nan, nan, nan, nan, nan};
+    const double tail[3 * dim] = {nan, nan, 5, 6, 3, 4};
+    pass = pass &&
+        algorithm_smc_stream_equal(capacity * dim, sink.data().data(), head,
+            sink.data().size());
+    pass = pass && algorithm_smc_stream_equal(3 * dim, m.data(), tail);
+
+    bool thrown = false;
+    try {
+        m.insert_estimate(2, z);
+    } catch (const mckl::RuntimeAssert &) {
+        thrown = true;
+    }
+
+    return pass && thrown && sink.pass();
+}
+
+// Leaving the streaming mode keeps all subsequent estimates
+inline bool algorithm_smc_stream_leave(std::size_t n, std::size_t capacity)
+{
+    AlgorithmSMCStreamSink sink(capacity);
+    mckl::EstimateMatrix<double> m(1);
+    m.stream(capacity, sink.sink());
+    for (std::size_t i = 0; i != n; ++i) {
+        const double x = static_cast<double>(i);
+        m.insert_estimate(&x);
+    }
+
+    m.stream(0);
+    bool pass = m.capacity() == 0 && m.num_iter() == 0 && m.offset() == n;
+    pass = pass && sink.data().size() == n;
+    for (std::size_t i = 0; i != n; ++i) {
+        const double x = static_cast<double>(i);
+        m.insert_estimate(&x);
+    }
+    pass = pass && m.num_iter() == n && m.offset() == n;
+
+    m.clear();
+    pass = pass && m.num_iter() == 0 && m.offset() == 0;
+
+    return pass && sink.pass();
+}
+
+inline void algorithm_smc_stream_eval(
+    std::size_t iter, mckl::Particle<AlgorithmSMCStreamState> &particle)
+{
+    const std::size_t N = particle.size();
+    mckl::Vector<double> l(N);
+    for (std::size_t i = 0; i != N; ++i) {
+        const double x = static_cast<double>((i + 1) * (iter + 1));
+        particle.state()(i, 0) = std::cos(x);
+        l[i] = 2 * std::sin(x);
+    }
+    particle.weight().set_log(l.data());
+}
+
+inline void algorithm_smc_stream_record(std::size_t iter, std::size_t dim,
+    mckl::Particle<AlgorithmSMCStreamState> &particle, double *r)
+{
+    r[0] = static_cast<double>(iter);
+    for (std::size_t i = 1; i != dim; ++i)
+        r[i] = particle.weight().ess();
+}
+
+inline void algorithm_smc_stream_mean(std::size_t, std::size_t,
+    mckl::Particle<AlgorithmSMCStreamState> &particle, double *r)
+{
+    const std::size_t N = particle.size();
+    for (std::size_t i = 0; i != N; ++i)
+        r[i] = particle.state()(i, 0);
+}
+
+inline void algorithm_smc_stream_init(AlgorithmSMCStreamSampler &sampler)
+{
+    sampler.mutation(algorithm_smc_stream_eval);
+    sampler.mutation_estimator(AlgorithmSMCStreamSampler::estimator_type(
+        2, algorithm_smc_stream_record, mckl::RowMajor, true));
+    sampler.mutation_estimator(AlgorithmSMCStreamSampler::estimator_type(
+        1, algorithm_smc_stream_mean));
+}
+
+// A streaming sampler hands exactly the histories and estimates of a sampler
+// keeping everything to the sinks
+inline bool algorithm_smc_stream_sampler(
+    std::size_t N, std::size_t n, std::size_t capacity)
+{
+    using size_type = AlgorithmSMCStreamSampler::size_type;
+
+    AlgorithmSMCStreamSampler ref(N);
+    algorithm_smc_stream_init(ref);
+    ref.iterate(n);
+
+    mckl::Vector<double> size_history;
+    mckl::Vector<double> ess_history;
+    bool pass = true;
+    AlgorithmSMCStreamSampler sampler(N);
+    algorithm_smc_stream_init(sampler);
+    sampler.stream_history(capacity,
+        [&](std::size_t offset, std::size_t k, const size_type *size,
+            const double *ess) {
+            pass = pass && k != 0 && k <= capacity;
+            pass = pass && offset == size_history.size();
+            size_history.insert(size_history.end(), size, size + k);
+            ess_history.insert(ess_history.end(), ess, ess + k);
+        });
+    AlgorithmSMCStreamSink record(capacity);
+    AlgorithmSMCStreamSink mean(capacity + 1);
+    sampler.mutation_estimator(0).stream(capacity, record.sink());
+    sampler.mutation_estimator(1).stream(capacity + 1, mean.sink());
+
+    sampler.iterate(n / 2);
+    for (std::size_t i = n / 2; i != n; ++i) {
+        sampler.iterate();
+        pass = pass && sampler.history_size() <= capacity;
+        pass = pass && sampler.mutation_estimator(0).num_iter() <= capacity;
+        pass = pass && sampler.num_iter() == i + 1;
+    }
+    pass = pass && sampler.num_iter() == ref.num_iter();
+
+    // The summary includes the most recent iterations stored by all
+    const auto sm = sampler.summary<double, mckl::RowMajor>();
+    const auto rm = ref.summary<double, mckl::RowMajor>();
+    const std::size_t k = std::min(sampler.mutation_estimator(0).num_iter(),
+        sampler.mutation_estimator(1).num_iter());
+    pass = pass && sm.nrow() == k && sm.ncol() == rm.ncol();
+    pass = pass &&
+        algorithm_smc_stream_equal(sm.nrow() * sm.ncol(), sm.data(),
+            rm.row_data(rm.nrow() - k));
+
+    sampler.flush();
+    pass = pass && sampler.history_size() == 0 && sampler.num_iter() == n;
+    pass = pass && record.pass() && mean.pass();
+
+    mckl::Vector<double> ref_size(n);
+    mckl::Vector<double> ref_ess(n);
+    ref.read_size_history(ref_size.begin());
+    ref.read_ess_history(ref_ess.begin());
+    pass = pass &&
+        algorithm_smc_stream_equal(
+            n, size_history.data(), ref_size.data(), size_history.size());
+    pass = pass &&
+        algorithm_smc_stream_equal(
+            n, ess_history.data(), ref_ess.data(), ess_history.size());
+    pass = pass &&
+        algorithm_smc_stream_equal(n * 2, record.data().data(),
+            ref.mutation_estimator(0).data(), record.data().size());
+    pass = pass &&
+        algorithm_smc_stream_equal(n, mean.data().data(),
+            ref.mutation_estimator(1).data(), mean.data().size());
+
+    return pass;
+}
+
+inline void algorithm_smc_stream(std::size_t N, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 = algorithm_smc_stream_matrix(n, 1, 3);
+    std::cout << std::setw(60) << std::left << "EstimateMatrix capacity 1";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_smc_stream_matrix(n, 7, 3);
+    std::cout << std::setw(60) << std::left << "EstimateMatrix capacity 7";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_smc_stream_matrix(n, n, 3);
+    std::cout << std::setw(60) << std::left << "EstimateMatrix capacity n";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = algorithm_smc_stream_gap();
+    std::cout << std::setw(60) << std::left << "EstimateMatrix gap";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = algorithm_smc_stream_leave(n, 7);
+    std::cout << std::setw(60) << std::left << "EstimateMatrix leave";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 = algorithm_smc_stream_sampler(N, n, 1);
+    std::cout << std::setw(60) << std::left << "SMCSampler capacity 1";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass7 = algorithm_smc_stream_sampler(N, n, 7);
+    std::cout << std::setw(60) << std::left << "SMCSampler capacity 7";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass8 = algorithm_smc_stream_sampler(N, n, n);
+    std::cout << std::setw(60) << std::left << "SMCSampler capacity n";
+    std::cout << std::setw(20) << std::right << (pass8 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_SMC_STREAM_HPP
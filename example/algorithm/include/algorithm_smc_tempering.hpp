@@ -0,0 +1,284 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_smc_tempering.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_SMC_TEMPERING_HPP
+#define MCKL_EXAMPLE_ALGORITHM_SMC_TEMPERING_HPP
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using AlgorithmSMCTemperingState =
+    mckl::StateMatrix<mckl::RowMajor, double, 1>;
+
+using AlgorithmSMCTemperingSampler =
+    mckl::SMCSampler<AlgorithmSMCTemperingState>;
+
+using AlgorithmSMCTemperingParticle =
+    mckl::Particle<AlgorithmSMCTemperingState>;
+
+// Observation y ~ N(x, s^2) with prior x ~ N(0, 1), and the likelihood is
+// zero for x below the lower bound c
+class AlgorithmSMCTemperingModel
+{
+  public:
+    AlgorithmSMCTemperingModel(double y, double s, double c)
+        : y_(y), s_(s), c_(c)
+    {
+    }
+
+    void operator()(
+        std::size_t, AlgorithmSMCTemperingParticle &particle, double *l) const
+    {
+        const std::size_t N = particle.size();
+        for (std::size_t i = 0; i != N; ++i) {
+            const double x = particle.state()(i, 0);
+            const double z = (x - y_) / s_;
+            l[i] = x < c_ ? -mckl::const_inf<double>() : -0.5 * z * z;
+        }
+    }
+
+    // Mean and variance of the posterior, a truncated normal distribution
+    void posterior(double &mean, double &var) const
+    {
+        const double v = s_ * s_ / (1 + s_ * s_);
+        const double mu = y_ / (1 + s_ * s_);
+        const double sd = std::sqrt(v);
+        const double a = (c_ - mu) / sd;
+        const double lambda = std::isinf(a) ? 0 :
+            std::exp(-0.5 * a * a) /
+                (std::sqrt(0.5 * mckl::const_pi<double>()) *
+                    std::erfc(a / std::sqrt(2.0)));
+        const double b = std::isinf(a) ? 0 : a * lambda;
+        mean = mu + sd * lambda;
+        var = v * (1 + b - lambda * lambda);
+    }
+
+  private:
+    double y_;
+    double s_;
+    double c_;
+}; // class AlgorithmSMCTemperingModel
+
+// Record the conditional ESS of each tempering step, computed directly from
+// the weights and the log-likelihood before the step, and divided by the
+// total weight of the particles with a positive likelihood
+class AlgorithmSMCTemperingMonitor
+{
+  public:
+    AlgorithmSMCTemperingMonitor(AlgorithmSMCTemperingSampler &sampler,
+        const AlgorithmSMCTemperingModel &model)
+        : sampler_(sampler), model_(model), alpha_(0)
+    {
+    }
+
+    const mckl::Vector<double> &cess() const { return cess_; }
+
+    const mckl::Vector<double> &temperature() const { return temperature_; }
+
+    // Called before the tempering step
+    void selection(std::size_t iter, AlgorithmSMCTemperingParticle &particle)
+    {
+        if (iter == 0) {
+            mckl::NormalDistribution<double> rnorm(0, 1);
+            rnorm(particle.rng(), particle.size(),
+                particle.state().col_data(0));
+            particle.weight().set_equal();
+        }
+        alpha_ = sampler_.temperature();
+        const std::size_t N = particle.size();
+        w_.resize(N);
+        l_.resize(N);
+        particle.weight().read(w_.data());
+        model_(iter, particle, l_.data());
+    }
+
+    // Called after the tempering step
+    void mutation(std::size_t, AlgorithmSMCTemperingParticle &)
+    {
+        const double delta = sampler_.temperature() - alpha_;
+        const std::size_t N = w_.size();
+        double lmax = -mckl::const_inf<double>();
+        for (std::size_t i = 0; i != N; ++i)
+            lmax = std::max(lmax, l_[i]);
+        double s = 0;
+        double q = 0;
+        double wsum = 0;
+        for (std::size_t i = 0; i != N; ++i) {
+            if (l_[i] == -mckl::const_inf<double>())
+                continue;
+            const double v = std::exp(delta * (l_[i] - lmax));
+            s += w_[i] * v;
+            q += w_[i] * v * v;
+            wsum += w_[i];
+        }
+        cess_.push_back(N * s * s / q / wsum);
+        temperature_.push_back(sampler_.temperature());
+    }
+
+  private:
+    AlgorithmSMCTemperingSampler &sampler_;
+    AlgorithmSMCTemperingModel model_;
+    double alpha_;
+    mckl::Vector<double> w_;
+    mckl::Vector<double> l_;
+    mckl::Vector<double> cess_;
+    mckl::Vector<double> temperature_;
+}; // class AlgorithmSMCTemperingMonitor
+
+// Tempering ends exactly at one within a bounded number of steps, each step
+// but the last has the target conditional ESS, and the final weighted sample
+// approximates the posterior
+inline bool algorithm_smc_tempering_gaussian(std::size_t N, double target,
+    const AlgorithmSMCTemperingModel &model, std::size_t nmax)
+{
+    AlgorithmSMCTemperingSampler sampler(N);
+    AlgorithmSMCTemperingMonitor monitor(sampler, model);
+    sampler.selection([&](std::size_t iter,
+                          AlgorithmSMCTemperingParticle &particle) {
+        monitor.selection(iter, particle);
+    });
+    sampler.mutation([&](std::size_t iter,
+                         AlgorithmSMCTemperingParticle &particle) {
+        monitor.mutation(iter, particle);
+    });
+    sampler.tempering(model, target);
+
+    const std::size_t n = sampler.iterate_tempering();
+    bool pass = sampler.temperature() == 1;
+    pass = pass && n != 0 && n <= nmax && n == sampler.num_iter();
+    pass = pass && monitor.cess().size() == n;
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        const double r = monitor.cess()[i] / (target * N);
+        pass = pass && std::abs(r - 1) < 1e-3;
+        pass = pass &&
+            monitor.temperature()[i] < monitor.temperature()[i + 1];
+    }
+    if (n != 0)
+        pass = pass && monitor.cess()[n - 1] >= target * N * (1 - 1e-3);
+
+    double mean = 0;
+    double var = 0;
+    model.posterior(mean, var);
+    const double *w = sampler.particle().weight().data();
+    const double *x = sampler.particle().state().col_data(0);
+    double m1 = 0;
+    double m2 = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        m1 += w[i] * x[i];
+        m2 += w[i] * x[i] * x[i];
+    }
+    m2 -= m1 * m1;
+    pass = pass && std::abs(m1 - mean) < 0.2 * std::sqrt(var);
+    pass = pass && std::abs(m2 / var - 1) < 0.1;
+
+    // Further iterations do not change the temperature
+    pass = pass && sampler.iterate_tempering() == 0;
+    pass = pass && sampler.temperature() == 1;
+
+    return pass;
+}
+
+// With target one, a flat likelihood reaches one in a single step, and
+// otherwise the number of steps is bounded by the argument
+inline bool algorithm_smc_tempering_one(std::size_t N, std::size_t n)
+{
+    const AlgorithmSMCTemperingModel model(2, 0.5, 0);
+
+    AlgorithmSMCTemperingSampler flat(N);
+    AlgorithmSMCTemperingMonitor prior(flat, model);
+    flat.selection([&](std::size_t iter,
+                       AlgorithmSMCTemperingParticle &particle) {
+        prior.selection(iter, particle);
+    });
+    flat.tempering(
+        [](std::size_t, AlgorithmSMCTemperingParticle &particle, double *l) {
+            std::fill_n(l, particle.size(), -3.0);
+        },
+        1.0);
+    bool pass = flat.iterate_tempering(n) == 1;
+    pass = pass && flat.temperature() == 1;
+
+    AlgorithmSMCTemperingSampler sampler(N);
+    AlgorithmSMCTemperingMonitor monitor(sampler, model);
+    sampler.selection([&](std::size_t iter,
+                          AlgorithmSMCTemperingParticle &particle) {
+        monitor.selection(iter, particle);
+    });
+    sampler.tempering(model, 1.0);
+    double alpha = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        pass = pass && sampler.iterate_tempering(1) == 1;
+        pass = pass && sampler.temperature() > alpha;
+        pass = pass && sampler.temperature() < 1;
+        alpha = sampler.temperature();
+    }
+    pass = pass && sampler.num_iter() == n;
+
+    return pass;
+}
+
+inline void algorithm_smc_tempering(std::size_t N)
+{
+    const double inf = mckl::const_inf<double>();
+
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 = algorithm_smc_tempering_gaussian(
+        N, 0.5, AlgorithmSMCTemperingModel(2, 0.5, -inf), 20);
+    std::cout << std::setw(60) << std::left << "Gaussian target 0.5";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = algorithm_smc_tempering_gaussian(
+        N, 0.9, AlgorithmSMCTemperingModel(2, 0.5, -inf), 100);
+    std::cout << std::setw(60) << std::left << "Gaussian target 0.9";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = algorithm_smc_tempering_gaussian(
+        N, 0.5, AlgorithmSMCTemperingModel(2, 0.2, 0), 20);
+    std::cout << std::setw(60) << std::left << "Gaussian target 0.5 with -inf";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = algorithm_smc_tempering_gaussian(
+        N, 0.3, AlgorithmSMCTemperingModel(0, 1e3, 0), 1);
+    std::cout << std::setw(60) << std::left << "Truncation target 0.3";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = algorithm_smc_tempering_one(N, 5);
+    std::cout << std::setw(60) << std::left << "Target 1.0";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_SMC_TEMPERING_HPP
@@ -0,0 +1,340 @@
+//============================================================================
+// MCKL/example/core/include/core_weight.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_WEIGHT_HPP
+#define MCKL_EXAMPLE_CORE_WEIGHT_HPP
+
+#include <mckl/core/weight.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <iomanip>
+#include <iostream>
+
+inline bool core_weight_near(double a, double b, double tol = 1e-12)
+{
+    return std::abs(a - b) <= tol * std::max(std::abs(a), std::abs(b));
+}
+
+// Normalize by the textbook three-pass algorithm
+inline double core_weight_reference(
+    std::size_t N, const double *l, bool use_log, double *w)
+{
+    const double lmax = use_log ? *std::max_element(l, l + N) : 0;
+    for (std::size_t i = 0; i != N; ++i)
+        w[i] = use_log ? std::exp(l[i] - lmax) : l[i];
+    double s = 0;
+    for (std::size_t i = 0; i != N; ++i)
+        s += w[i];
+    double q = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        w[i] /= s;
+        q += w[i] * w[i];
+    }
+
+    return 1 / q;
+}
+
+inline bool core_weight_equal(const mckl::Weight &weight, double ess,
+    const mckl::Vector<double> &w)
+{
+    bool pass = core_weight_near(weight.ess(), ess);
+    for (std::size_t i = 0; i != w.size(); ++i)
+        pass = pass && core_weight_near(weight.data()[i], w[i]);
+
+    return pass;
+}
+
+// The SIMD max and sum kernels agree with plain loops for all remainders
+inline bool core_weight_kernel()
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> rnorm(0, 10);
+
+    bool pass = true;
+    for (std::size_t n = 1; n != 100; ++n) {
+        mckl::Vector<double> x(n);
+        mckl::rand(rng, rnorm, n, x.data());
+        pass = pass &&
+            mckl::internal::weight_max(n, x.data()) ==
+                *std::max_element(x.begin(), x.end());
+
+        double s = 0;
+        double q = 0;
+        mckl::internal::weight_sum_sqr(n, x.data(), s, q);
+        double rs = 0;
+        double rq = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            rs += x[i];
+            rq += x[i] * x[i];
+        }
+        pass = pass && core_weight_near(s, rs, 1e-10) &&
+            core_weight_near(q, rq, 1e-12);
+    }
+
+    return pass;
+}
+
+// Blocks with different maxima on the log scale are combined exactly
+inline mckl::Vector<double> core_weight_log(std::size_t N)
+{
+    const std::size_t k = mckl::internal::BufferSize<double>::value;
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> rnorm(0, 1);
+    mckl::Vector<double> l(N);
+    mckl::rand(rng, rnorm, N, l.data());
+    for (std::size_t i = 0; i != N; ++i)
+        l[i] += 100.0 * static_cast<double>((i / k) % 3);
+
+    return l;
+}
+
+inline void core_weight_normalize(std::size_t N)
+{
+    const mckl::Vector<double> l = core_weight_log(N);
+    mckl::Vector<double> v(N);
+    for (std::size_t i = 0; i != N; ++i)
+        v[i] = std::exp(l[i] / 1000);
+    mckl::Vector<double> w(N);
+    mckl::Vector<double> r(N);
+    double ess = 0;
+
+    mckl::Weight weight(N);
+    mckl::Weight wpar(N);
+    mckl::RunSMP<mckl::BackendSTD> run;
+
+    ess = core_weight_reference(N, v.data(), false, w.data());
+    weight.set(v.data());
+    wpar.set(v.data(), run);
+    const bool pass1 = core_weight_equal(weight, ess, w);
+    std::cout << std::setw(60) << std::left << "set";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = wpar == weight;
+    std::cout << std::setw(60) << std::left << "set (parallel)";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    ess = core_weight_reference(N, l.data(), true, w.data());
+    weight.set_log(l.data());
+    wpar.set_log(l.data(), run);
+    const bool pass3 = core_weight_equal(weight, ess, w);
+    std::cout << std::setw(60) << std::left << "set_log";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 = wpar == weight;
+    std::cout << std::setw(60) << std::left << "set_log (parallel)";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    for (std::size_t i = 0; i != N; ++i)
+        r[i] = std::log(w[i] * v[i]);
+    ess = core_weight_reference(N, r.data(), true, w.data());
+    weight.mul(v.data());
+    wpar.mul(v.data(), run);
+    const bool pass5 = core_weight_equal(weight, ess, w);
+    std::cout << std::setw(60) << std::left << "mul";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 = wpar == weight;
+    std::cout << std::setw(60) << std::left << "mul (parallel)";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    for (std::size_t i = 0; i != N; ++i)
+        r[i] = std::log(w[i]) + l[i];
+    ess = core_weight_reference(N, r.data(), true, w.data());
+    weight.add_log(l.data());
+    wpar.add_log(l.data(), run);
+    const bool pass7 = core_weight_equal(weight, ess, w);
+    std::cout << std::setw(60) << std::left << "add_log";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass8 = wpar == weight;
+    std::cout << std::setw(60) << std::left << "add_log (parallel)";
+    std::cout << std::setw(20) << std::right << (pass8 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    // A block of zero weights
+    const std::size_t k = mckl::internal::BufferSize<double>::value;
+    mckl::Vector<double> z(l);
+    std::fill_n(z.begin(), std::min(N, k), -mckl::const_inf<double>());
+    ess = core_weight_reference(N, z.data(), true, w.data());
+    weight.set_log(z.data());
+    wpar.set_log(z.data(), run);
+    const bool pass9 = core_weight_equal(weight, ess, w) && wpar == weight;
+    std::cout << std::setw(60) << std::left << "set_log (zero block)";
+    std::cout << std::setw(20) << std::right << (pass9 ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+// Compute the conditional ESS by a plain loop
+inline double core_weight_cess_reference(
+    std::size_t N, const double *w, double alpha, const double *l)
+{
+    const double lmax = *std::max_element(l, l + N);
+    double s = 0;
+    double q = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        const double v = std::exp(alpha * (l[i] - lmax));
+        s += w[i] * v;
+        q += w[i] * v * v;
+    }
+
+    return N * s * s / q;
+}
+
+inline bool core_weight_cess_equal(const mckl::Weight &weight,
+    std::size_t m, const double *alpha, const double *l)
+{
+    const std::size_t N = weight.size();
+    mckl::Vector<double> r(m);
+    weight.cess(m, alpha, l, r.data());
+
+    bool pass = true;
+    for (std::size_t j = 0; j != m; ++j) {
+        const double c =
+            core_weight_cess_reference(N, weight.data(), alpha[j], l);
+        pass = pass && core_weight_near(r[j], c, 1e-10);
+        pass = pass && weight.cess(alpha[j], l) == r[j];
+    }
+
+    return pass;
+}
+
+inline void core_weight_cess(std::size_t N)
+{
+    const double alpha[] = {1e-3, 1e-2, 0.1, 1};
+    const std::size_t m = sizeof(alpha) / sizeof(double);
+
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> rnorm(0, 1);
+    mckl::Vector<double> w(N);
+    mckl::rand(rng, rnorm, N, w.data());
+    mckl::Weight weight(N);
+    weight.set_log(w.data());
+
+    mckl::Vector<double> l = core_weight_log(N);
+    const bool pass10 = core_weight_cess_equal(weight, m, alpha, l.data());
+    std::cout << std::setw(60) << std::left << "cess";
+    std::cout << std::setw(20) << std::right << (pass10 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    // A block of zero incremental weights
+    const std::size_t k = mckl::internal::BufferSize<double>::value;
+    std::fill_n(l.begin(), std::min(N, k), -mckl::const_inf<double>());
+    const bool pass11 = core_weight_cess_equal(weight, m, alpha, l.data());
+    std::cout << std::setw(60) << std::left << "cess (zero block)";
+    std::cout << std::setw(20) << std::right << (pass11 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    // All incremental weights zero
+    std::fill(l.begin(), l.end(), -mckl::const_inf<double>());
+    mckl::Vector<double> r(m, 1.0);
+    weight.cess(m, alpha, l.data(), r.data());
+    bool pass = weight.cess(1.0, l.data()) == 0;
+    for (std::size_t j = 0; j != m; ++j)
+        pass = pass && r[j] == 0;
+    std::cout << std::setw(60) << std::left << "cess (all zero)";
+    std::cout << std::setw(20) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+// The alias table is rebuilt after each change of the weights
+inline bool core_weight_alias(std::size_t N)
+{
+    mckl::RNG rng;
+    mckl::Vector<double> w(N, 0.0);
+    mckl::Vector<std::size_t> r(N);
+    mckl::Weight weight(N);
+    bool pass = true;
+
+    auto check = [&](std::size_t k) {
+        weight.draw_alias(rng, N, r.data());
+        pass = pass && weight.draw_alias(rng) == k;
+        pass = pass &&
+            std::all_of(r.begin(), r.end(),
+                [k](std::size_t j) { return j == k; });
+    };
+
+    w[1] = 1;
+    weight.set(w.data());
+    check(1);
+    w[1] = 0;
+    w[N - 1] = 2;
+    weight.set(w.data());
+    check(N - 1);
+    w[N - 1] = 1;
+    w[0] = 1;
+    weight.mul(w.data());
+    check(N - 1);
+    std::fill(w.begin(), w.end(), -mckl::const_inf<double>());
+    w[2] = 0;
+    weight.set_log(w.data());
+    check(2);
+    std::fill(w.begin(), w.end(), 0.0);
+    w[2] = -mckl::const_inf<double>();
+    w[N / 2] = 1e3;
+    weight.set_log(w.data());
+    check(N / 2);
+    std::fill(w.begin(), w.end(), 0.0);
+    w[3] = 1e3;
+    weight.set_equal();
+    weight.add_log(w.data());
+    check(3);
+
+    weight.set_equal();
+    weight.draw_alias(rng, N, r.data());
+    pass = pass && std::count(r.begin(), r.end(), 3) < N / 2;
+
+    return pass;
+}
+
+inline void core_weight(std::size_t N)
+{
+    // More threads than processors if need be
+    mckl::BackendSTD::instance().np(4);
+
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass12 = core_weight_kernel();
+    std::cout << std::setw(60) << std::left << "weight_max and weight_sum_sqr";
+    std::cout << std::setw(20) << std::right << (pass12 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    core_weight_normalize(N);
+    core_weight_cess(N);
+    const bool pass13 = core_weight_alias(std::max(N, std::size_t(8)));
+    std::cout << std::setw(60) << std::left << "draw_alias";
+    std::cout << std::setw(20) << std::right << (pass13 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_WEIGHT_HPP
@@ -0,0 +1,176 @@
+//============================================================================
+// MCKL/example/random/include/random_discrete.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_DISCRETE_HPP
+#define MCKL_EXAMPLE_RANDOM_DISCRETE_HPP
+
+#define MCKL_NO_RUNTIME_ASSERT 0
+#define MCKL_RUNTIME_ASSERT_AS_EXCEPTION 1
+
+#include <mckl/random/discrete_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include "random_common.hpp"
+
+// Each frequency is within five standard errors of its probability
+template <typename IntType>
+inline bool random_discrete_freq(std::size_t N, const IntType *r,
+    const mckl::Vector<double> &weights)
+{
+    const double sum =
+        std::accumulate(weights.begin(), weights.end(), 0.0);
+    mckl::Vector<double> count(weights.size(), 0.0);
+    for (std::size_t i = 0; i != N; ++i) {
+        const std::size_t j = static_cast<std::size_t>(r[i]);
+        if (j >= weights.size())
+            return false;
+        count[j] += 1;
+    }
+
+    for (std::size_t j = 0; j != weights.size(); ++j) {
+        const double p = weights[j] / sum;
+        const double f = count[j] / N;
+        if (std::abs(f - p) > 5 * std::sqrt(p * (1 - p) / N))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename IntType>
+inline void random_discrete(std::size_t N, const std::string &name)
+{
+    mckl::Vector<double> weights;
+    for (std::size_t i = 0; i != 10; ++i)
+        weights.push_back(static_cast<double>(i + 1));
+    weights[5] = 0;
+
+    mckl::Vector<IntType> r1(N);
+    mckl::Vector<IntType> r2(N);
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    bool pass = true;
+
+    // The default sampler draws by a linear scan of the weights
+    mckl::DiscreteDistribution<IntType> dist(weights.begin(), weights.end());
+    mckl::Vector<double> probability(dist.probability());
+    for (std::size_t i = 0; i != N; ++i) {
+        r1[i] = dist(rng1);
+        r2[i] = dist(rng2, probability.begin(), probability.end(), true);
+    }
+    std::cout << std::setw(60) << std::left
+              << "DiscreteDistribution<" + name + "> linear scan";
+    std::cout << std::setw(20) << std::right << random_pass(r1 == r2);
+    std::cout << std::endl;
+
+    rng2 = rng1;
+    for (std::size_t i = 0; i != N; ++i)
+        r1[i] = dist(rng1);
+    mckl::rand(rng2, dist, N, r2.data());
+    const bool pass1 = r1 == r2 && random_discrete_freq(N, r1.data(), weights);
+    std::cout << std::setw(60) << std::left
+              << "DiscreteDistribution<" + name + "> batch";
+    std::cout << std::setw(20) << std::right << random_pass(pass1);
+    std::cout << std::endl;
+
+    // The alias table gives the same distribution
+    mckl::DiscreteAlias<IntType> alias(weights.begin(), weights.end());
+    for (std::size_t i = 0; i != N; ++i)
+        r1[i] = alias(rng1);
+    pass = random_discrete_freq(N, r1.data(), weights);
+    std::cout << std::setw(60) << std::left << "DiscreteAlias<" + name + ">";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    alias(rng1, N, r2.data());
+    pass = random_discrete_freq(N, r2.data(), weights);
+    std::cout << std::setw(60) << std::left
+              << "DiscreteAlias<" + name + "> batch";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    // The table is rebuilt after new weights are assigned
+    std::fill(weights.begin(), weights.end(), 0.0);
+    weights[3] = 1;
+    alias.assign(weights.begin(), weights.end());
+    alias(rng1, N, r2.data());
+    pass = std::all_of(
+        r2.begin(), r2.end(), [](IntType k) { return k == 3; });
+    std::cout << std::setw(60) << std::left
+              << "DiscreteAlias<" + name + "> assign";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    // The free function builds the table once for all samples
+    weights[7] = 2;
+    mckl::discrete_alias_distribution(
+        rng1, N, r2.data(), weights.begin(), weights.end());
+    pass = random_discrete_freq(N, r2.data(), weights);
+    std::cout << std::setw(60) << std::left
+              << "discrete_alias_distribution<" + name + ">";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+}
+
+// The largest index shall fit the result type
+inline bool random_discrete_overflow()
+{
+    mckl::RNG rng;
+    mckl::Vector<double> weights(
+        static_cast<std::size_t>(std::numeric_limits<std::int16_t>::max()) +
+            1,
+        1.0);
+    mckl::DiscreteAlias<std::int16_t> alias(weights.begin(), weights.end());
+    bool pass = alias(rng) >= 0;
+
+    weights.push_back(1.0);
+    alias.assign(weights.begin(), weights.end());
+    try {
+        alias(rng);
+        pass = false;
+    } catch (const mckl::RuntimeAssert &) {
+    }
+
+    return pass;
+}
+
+inline void random_discrete(std::size_t N)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    random_discrete<int>(N, "int");
+    random_discrete<std::size_t>(N, "std::size_t");
+    const bool pass1 = random_discrete_overflow();
+    std::cout << std::setw(60) << std::left << "DiscreteAlias overflow";
+    std::cout << std::setw(20) << std::right << random_pass(pass1);
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_DISCRETE_HPP
@@ -98,6 +98,14 @@
 #define MCKL_EXAMPLE_RANDOM_LOGNORMAL_DISTRIBUTION 0
 #endif
 
+#ifndef MCKL_EXAMPLE_RANDOM_LOGNORMAL_ZIGGURAT_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_LOGNORMAL_ZIGGURAT_DISTRIBUTION 0
+#endif
+
+#ifndef MCKL_EXAMPLE_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION 0
+#endif
+
 #ifndef MCKL_EXAMPLE_RANDOM_PARETO_DISTRIBUTION
 #define MCKL_EXAMPLE_RANDOM_PARETO_DISTRIBUTION 0
 #endif
@@ -142,6 +150,22 @@
 #define MCKL_EXAMPLE_RANDOM_UNIFORM_INT_DISTRIBUTION 0
 #endif
 
+#ifndef MCKL_EXAMPLE_RANDOM_POISSON_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_POISSON_DISTRIBUTION 0
+#endif
+
+#ifndef MCKL_EXAMPLE_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION 0
+#endif
+
+#ifndef MCKL_EXAMPLE_RANDOM_BINOMIAL_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_BINOMIAL_DISTRIBUTION 0
+#endif
+
+#ifndef MCKL_EXAMPLE_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION
+#define MCKL_EXAMPLE_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION 0
+#endif
+
 #include <mckl/math/beta.hpp>
 #include <mckl/math/erf.hpp>
 #include <mckl/math/gamma.hpp>
@@ -248,6 +272,50 @@ class RandomDistributionTraitBase
         return probability;
     }
 
+    // pmf[i] is the probability of dist.min() + i; consecutive values are
+    // merged until each cell expects at least five of the n samples
+    template <typename DistType>
+    mckl::Vector<ResultType> partition_pmf(std::size_t n,
+        const mckl::Vector<double> &pmf, const DistType &dist) const
+    {
+        const double t = 5.0 / n;
+        mckl::Vector<ResultType> partition;
+        double p = 0;
+        double q = 1;
+        for (std::size_t i = 0; i != pmf.size(); ++i) {
+            p += pmf[i];
+            q -= pmf[i];
+            if (p >= t && q >= t) {
+                partition.push_back(dist.min() + static_cast<ResultType>(i));
+                p = 0;
+            }
+        }
+        partition.push_back(dist.max());
+
+        return partition;
+    }
+
+    mckl::Vector<double> probability_pmf(
+        std::size_t n, const mckl::Vector<double> &pmf) const
+    {
+        const double t = 5.0 / n;
+        mckl::Vector<double> probability;
+        double p = 0;
+        double q = 1;
+        for (std::size_t i = 0; i != pmf.size(); ++i) {
+            p += pmf[i];
+            q -= pmf[i];
+            if (p >= t && q >= t) {
+                probability.push_back(p);
+                p = 0;
+            }
+        }
+        probability.push_back(1 -
+            std::accumulate(probability.begin(), probability.end(), 0.0));
+
+        return probability;
+    }
+
     template <typename ParamType>
     static void add_param(mckl::Vector<std::array<ParamType, 0>> &params)
     {
@@ -830,6 +898,47 @@ class RandomDistributionTrait<mckl::LognormalDistribution<RealType>>
 
 #endif // MCKL_EXAMPLE_RANDOM_LOGNORMAL_DISTRIBUTION
 
+#if MCKL_EXAMPLE_RANDOM_LOGNORMAL_ZIGGURAT_DISTRIBUTION
+
+template <typename RealType>
+class RandomDistributionTrait<mckl::LognormalZigguratDistribution<RealType>>
+    : public RandomDistributionTraitBase<RealType, 2>
+{
+  public:
+    using dist_type = mckl::LognormalZigguratDistribution<RealType>;
+    using std_type = std::lognormal_distribution<RealType>;
+
+    std::string distname() const { return "LognormalZiggurat"; }
+
+    mckl::Vector<RealType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_quantile(n,
+            [&](double p) {
+                double q =
+                    mckl::const_sqrt_2<double>() * mckl::erfinv(2 * p - 1);
+                return std::exp(
+                    dist.m() + dist.s() * static_cast<RealType>(q));
+            },
+            dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &) const
+    {
+        return this->probability_quantile(n);
+    }
+
+    mckl::Vector<std::array<RealType, 2>> params() const
+    {
+        mckl::Vector<std::array<RealType, 2>> params;
+        this->add_param(params, 0, 1);
+        this->add_param(params, 1, 0.5);
+
+        return params;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_LOGNORMAL_ZIGGURAT_DISTRIBUTION
+
 #if MCKL_EXAMPLE_RANDOM_NORMAL_DISTRIBUTION
 
 template <typename RealType>
@@ -869,6 +978,46 @@ class RandomDistributionTrait<mckl::NormalDistribution<RealType>>
 
 #endif // MCKL_EXAMPLE_RANDOM_NORMAL_DISTRIBUTION
 
+#if MCKL_EXAMPLE_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION
+
+template <typename RealType>
+class RandomDistributionTrait<mckl::NormalZigguratDistribution<RealType>>
+    : public RandomDistributionTraitBase<RealType, 2>
+{
+  public:
+    using dist_type = mckl::NormalZigguratDistribution<RealType>;
+    using std_type = std::normal_distribution<RealType>;
+
+    std::string distname() const { return "NormalZiggurat"; }
+
+    mckl::Vector<RealType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_quantile(n,
+            [&](double p) {
+                double q =
+                    mckl::const_sqrt_2<double>() * mckl::erfinv(2 * p - 1);
+                return dist.mean() + dist.stddev() * static_cast<RealType>(q);
+            },
+            dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &) const
+    {
+        return this->probability_quantile(n);
+    }
+
+    mckl::Vector<std::array<RealType, 2>> params() const
+    {
+        mckl::Vector<std::array<RealType, 2>> params;
+        this->add_param(params, 0, 1);
+        this->add_param(params, 1, 2);
+
+        return params;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION
+
 #if MCKL_EXAMPLE_RANDOM_PARETO_DISTRIBUTION
 
 template <typename RealType>
@@ -1395,6 +1544,226 @@ class RandomDistributionTrait<mckl::UniformIntDistribution<IntType>>
 
 #endif // MCKL_EXAMPLE_RANDOM_UNIFORM_INT_DISTRIBUTION
 
+#if MCKL_EXAMPLE_RANDOM_POISSON_DISTRIBUTION
+
+template <typename IntType>
+class RandomDistributionTrait<mckl::PoissonDistribution<IntType>>
+    : public RandomDistributionTraitBase<IntType, 1>
+{
+  public:
+    using dist_type = mckl::PoissonDistribution<IntType>;
+    using std_type = std::poisson_distribution<IntType>;
+
+    std::string distname() const { return "Poisson"; }
+
+    mckl::Vector<std::array<double, 1>> params() const
+    {
+        mckl::Vector<std::array<double, 1>> params;
+        this->add_param(params, 0.5);
+        this->add_param(params, 1);
+        this->add_param(params, 5);
+        this->add_param(params, 10);
+        this->add_param(params, 50);
+
+        return params;
+    }
+
+    mckl::Vector<IntType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_pmf(n, pmf(n, dist), dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &dist)
+    {
+        return this->probability_pmf(n, pmf(n, dist));
+    }
+
+  private:
+    mckl::Vector<double> pmf(std::size_t n, const dist_type &dist) const
+    {
+        const double t = 1 - 5.0 / n;
+        mckl::Vector<double> pmf;
+        pmf.push_back(std::exp(-dist.mean()));
+        double s = pmf.back();
+        for (double k = 1; s < t; ++k) {
+            pmf.push_back(pmf.back() * dist.mean() / k);
+            s += pmf.back();
+        }
+
+        return pmf;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_POISSON_DISTRIBUTION
+
+#if MCKL_EXAMPLE_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION
+
+template <typename IntType>
+class RandomDistributionTrait<mckl::NegativeBinomialDistribution<IntType>>
+    : public RandomDistributionTraitBase<IntType, 2>
+{
+  public:
+    using dist_type = mckl::NegativeBinomialDistribution<IntType>;
+    using std_type = std::negative_binomial_distribution<IntType>;
+
+    std::string distname() const { return "NegativeBinomial"; }
+
+    mckl::Vector<std::array<double, 2>> params() const
+    {
+        mckl::Vector<std::array<double, 2>> params;
+        this->add_param(params, 1, 0.5);
+        this->add_param(params, 1, 0.1);
+        this->add_param(params, 5, 0.5);
+        this->add_param(params, 10, 0.3);
+        this->add_param(params, 10, 0.9);
+
+        return params;
+    }
+
+    mckl::Vector<IntType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_pmf(n, pmf(n, dist), dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &dist)
+    {
+        return this->probability_pmf(n, pmf(n, dist));
+    }
+
+  private:
+    mckl::Vector<double> pmf(std::size_t n, const dist_type &dist) const
+    {
+        const double t = 1 - 5.0 / n;
+        mckl::Vector<double> pmf;
+        pmf.push_back(std::pow(dist.p(), dist.k()));
+        double s = pmf.back();
+        for (double i = 1; s < t; ++i) {
+            pmf.push_back(
+                pmf.back() * (dist.k() + i - 1) / i * (1 - dist.p()));
+            s += pmf.back();
+        }
+
+        return pmf;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION
+
+#if MCKL_EXAMPLE_RANDOM_BINOMIAL_DISTRIBUTION
+
+template <typename IntType>
+class RandomDistributionTrait<mckl::BinomialDistribution<IntType>>
+    : public RandomDistributionTraitBase<IntType, 2>
+{
+  public:
+    using dist_type = mckl::BinomialDistribution<IntType>;
+    using std_type = std::binomial_distribution<IntType>;
+
+    std::string distname() const { return "Binomial"; }
+
+    mckl::Vector<std::array<double, 2>> params() const
+    {
+        mckl::Vector<std::array<double, 2>> params;
+        this->add_param(params, 1, 0.5);
+        this->add_param(params, 10, 0.5);
+        this->add_param(params, 20, 0.1);
+        this->add_param(params, 100, 0.3);
+        this->add_param(params, 100, 0.95);
+        this->add_param(params, 1000, 0.5);
+
+        return params;
+    }
+
+    mckl::Vector<IntType> partition(std::size_t n, const dist_type &dist)
+    {
+        return this->partition_pmf(n, pmf(dist), dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &dist)
+    {
+        return this->probability_pmf(n, pmf(dist));
+    }
+
+  private:
+    mckl::Vector<double> pmf(const dist_type &dist) const
+    {
+        const double t = static_cast<double>(dist.t());
+        const double p = dist.p();
+        mckl::Vector<double> pmf;
+        pmf.push_back(std::exp(t * std::log1p(-p)));
+        for (double k = 1; k <= t; ++k)
+            pmf.push_back(pmf.back() * (t - k + 1) / k * p / (1 - p));
+
+        return pmf;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_BINOMIAL_DISTRIBUTION
+
+#if MCKL_EXAMPLE_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION
+
+template <typename RealType>
+class RandomDistributionTrait<mckl::TruncatedNormalDistribution<RealType>>
+    : public RandomDistributionTraitBase<RealType, 4>
+{
+  public:
+    using dist_type = mckl::TruncatedNormalDistribution<RealType>;
+    using std_type = dist_type;
+
+    std::string distname() const { return "TruncatedNormal"; }
+
+    mckl::Vector<RealType> partition(std::size_t n, const dist_type &dist)
+    {
+        const double m = dist.mean();
+        const double s = dist.stddev();
+        const double a = (dist.lower() - m) / s / mckl::const_sqrt_2<double>();
+        const double b = (dist.upper() - m) / s / mckl::const_sqrt_2<double>();
+
+        // The quantile is computed from the tail that contains the interval
+        // to retain accuracy far from the mean
+        return this->partition_quantile(n,
+            [&](double p) {
+                double q = 0;
+                if (a >= 0) {
+                    const double ca = std::erfc(a);
+                    const double cb = std::erfc(b);
+                    q = mckl::erfcinv(ca - p * (ca - cb));
+                } else {
+                    const double ca = std::erfc(-a);
+                    const double cb = std::erfc(-b);
+                    q = -mckl::erfcinv(ca + p * (cb - ca));
+                }
+                q *= mckl::const_sqrt_2<double>();
+                return static_cast<RealType>(m + s * q);
+            },
+            dist);
+    }
+
+    mckl::Vector<double> probability(std::size_t n, const dist_type &) const
+    {
+        return this->probability_quantile(n);
+    }
+
+    mckl::Vector<std::array<RealType, 4>> params() const
+    {
+        const RealType inf = mckl::const_inf<RealType>();
+
+        mckl::Vector<std::array<RealType, 4>> params;
+        this->add_param(params, 0, 1, -inf, inf);
+        this->add_param(params, 0, 1, -1, 2);
+        this->add_param(params, 1, 2, 0.5, 1.5);
+        this->add_param(params, 0, 1, 1, inf);
+        this->add_param(params, 0, 1, -inf, -2);
+        this->add_param(params, 0, 1, 3, 3.5);
+        this->add_param(params, 0, 1, 5, 10);
+        this->add_param(params, 2, 0.5, -inf, 1);
+
+        return params;
+    }
+}; // class RandomDistributionTrait
+
+#endif // MCKL_EXAMPLE_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION
+
 template <typename DistType, typename ParamType>
 inline DistType random_distribution_init(const std::array<ParamType, 0> &)
 {
@@ -0,0 +1,261 @@
+//============================================================================
+// MCKL/example/random/include/random_multinomial.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_MULTINOMIAL_HPP
+#define MCKL_EXAMPLE_RANDOM_MULTINOMIAL_HPP
+
+#include <mckl/math/gamma.hpp>
+#include <mckl/random/multinomial_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include "random_common.hpp"
+
+template <typename IntType>
+inline void random_multinomial_rand(std::size_t N,
+    mckl::MultinomialDistribution<IntType> &dist, IntType *r, bool batch)
+{
+    mckl::RNG rng;
+    if (batch) {
+        mckl::rand(rng, dist, N, r);
+    } else {
+        for (std::size_t i = 0; i != N; ++i)
+            mckl::rand(rng, dist, r + i * dist.dim());
+    }
+}
+
+// Each vector has nonnegative counts that sum to the number of trials, and
+// categories of zero probability are never counted
+template <typename IntType>
+inline bool random_multinomial_support(std::size_t N, IntType t,
+    std::size_t dim, const double *prob, bool batch)
+{
+    mckl::MultinomialDistribution<IntType> dist(t, dim, prob);
+    mckl::Vector<IntType> r(N * dim);
+    random_multinomial_rand(N, dist, r.data(), batch);
+
+    bool pass = true;
+    for (std::size_t i = 0; i != N; ++i) {
+        const IntType *v = r.data() + i * dim;
+        IntType s = 0;
+        for (std::size_t j = 0; j != dim; ++j) {
+            pass = pass && v[j] >= 0 && v[j] <= t;
+            pass = pass && (prob[j] > 0 || v[j] == 0);
+            s += v[j];
+        }
+        pass = pass && s == t;
+    }
+
+    return pass;
+}
+
+// The same vectors are generated after the distribution is written to and
+// read back from a stream, and by a distribution constructed with the
+// parameters passed to operator()
+template <typename IntType>
+inline bool random_multinomial_deterministic(std::size_t N, IntType t,
+    std::size_t dim, const double *prob)
+{
+    using param_type =
+        typename mckl::MultinomialDistribution<IntType>::param_type;
+
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    mckl::MultinomialDistribution<IntType> dist;
+    mckl::Vector<IntType> r1(N * dim);
+    mckl::Vector<IntType> r2(N * dim);
+    bool pass = true;
+
+    mckl::MultinomialDistribution<IntType> dist1(t, dim, prob);
+    std::stringstream ss;
+    ss.precision(20);
+    ss << dist1;
+    ss >> dist;
+    pass = pass && dist == dist1;
+    mckl::rand(rng1, dist1, N, r1.data());
+    mckl::rand(rng2, dist, N, r2.data());
+    pass = pass && r1 == r2;
+
+    const param_type param(t, dim, prob);
+    mckl::MultinomialDistribution<IntType> dist2(param);
+    dist = mckl::MultinomialDistribution<IntType>(t + 1, dim);
+    dist(rng1, N, r1.data(), param);
+    dist2(rng2, N, r2.data());
+    pass = pass && r1 == r2;
+
+    return pass;
+}
+
+// Pearson's chi-squared test of the joint counts, with outcomes expected
+// fewer than five times pooled into one cell, and of the total counts of
+// each category, which are multinomial with N * t trials, at level 0.001
+template <typename IntType>
+inline bool random_multinomial_chi2(std::size_t N, IntType t,
+    std::size_t dim, const double *prob, bool batch)
+{
+    mckl::MultinomialDistribution<IntType> dist(t, dim, prob);
+    mckl::Vector<IntType> r(N * dim);
+    random_multinomial_rand(N, dist, r.data(), batch);
+
+    const double s = std::accumulate(prob, prob + dim, 0.0);
+    mckl::Vector<double> p(dim);
+    for (std::size_t j = 0; j != dim; ++j)
+        p[j] = prob[j] / s;
+
+    // The outcome is indexed by the counts of the first dim - 1 categories,
+    // and the joint test is skipped if there are too many of them
+    const std::size_t T = static_cast<std::size_t>(t);
+    std::size_t k = 1;
+    for (std::size_t j = 0; j != dim - 1 && k != 0; ++j)
+        k = k * (T + 1) > (1U << 20) ? 0 : k * (T + 1);
+    mckl::Vector<double> count(k, 0);
+    mckl::Vector<double> total(dim, 0);
+    for (std::size_t i = 0; i != N; ++i) {
+        const IntType *v = r.data() + i * dim;
+        if (k != 0) {
+            std::size_t idx = 0;
+            for (std::size_t j = dim - 1; j != 0; --j)
+                idx = idx * (T + 1) + static_cast<std::size_t>(v[j - 1]);
+            ++count[idx];
+        }
+        for (std::size_t j = 0; j != dim; ++j)
+            total[j] += static_cast<double>(v[j]);
+    }
+
+    const double lt = std::lgamma(T + 1.0);
+    double chi2 = 0;
+    double df = -1;
+    double pool_e = 0;
+    double pool_c = 0;
+    for (std::size_t idx = 0; idx != k; ++idx) {
+        double e = lt;
+        std::size_t m = T;
+        std::size_t x = idx;
+        for (std::size_t j = 0; j != dim - 1; ++j, x /= T + 1) {
+            const std::size_t c = x % (T + 1);
+            if (c > m) {
+                e = -mckl::const_inf<double>();
+                break;
+            }
+            if (c != 0)
+                e += c * std::log(p[j]) - std::lgamma(c + 1.0);
+            m -= c;
+        }
+        if (m != 0)
+            e += m * std::log(p[dim - 1]) - std::lgamma(m + 1.0);
+        e = N * std::exp(e);
+        if (e < 5) {
+            pool_e += e;
+            pool_c += count[idx];
+        } else {
+            chi2 += (count[idx] - e) * (count[idx] - e) / e;
+            ++df;
+        }
+    }
+    if (pool_e > 0) {
+        chi2 += (pool_c - pool_e) * (pool_c - pool_e) / pool_e;
+        ++df;
+    }
+    bool pass = df < 1 || mckl::gammap(0.5 * df, 0.5 * chi2) < 0.999;
+
+    double chi2_total = 0;
+    double df_total = -1;
+    for (std::size_t j = 0; j != dim; ++j) {
+        const double e = static_cast<double>(N * T) * p[j];
+        if (e > 0) {
+            chi2_total += (total[j] - e) * (total[j] - e) / e;
+            ++df_total;
+        }
+    }
+    pass = pass && mckl::gammap(0.5 * df_total, 0.5 * chi2_total) < 0.999;
+
+    return pass;
+}
+
+template <typename IntType>
+inline void random_multinomial(std::size_t N)
+{
+    const double p3[] = {1, 2, 3};
+    const double p2[] = {1, 1};
+    const double p5[] = {0, 1, 0.5, 2, 0};
+    const double p4[] = {0.1, 0.2, 0.3, 0.4};
+    const std::size_t n = N / 10;
+
+    const std::string name =
+        "MultinomialDistribution<" + random_typename<IntType>() + ">";
+    bool pass = true;
+    for (bool batch : {false, true}) {
+        pass = pass && random_multinomial_support<IntType>(n, 0, 3, p3, batch);
+        pass = pass && random_multinomial_support<IntType>(n, 1, 3, p3, batch);
+        pass = pass && random_multinomial_support<IntType>(n, 7, 5, p5, batch);
+        pass =
+            pass && random_multinomial_support<IntType>(n, 100, 5, p5, batch);
+        pass = pass && random_multinomial_support<IntType>(n, 9, 1, p2, batch);
+    }
+    std::cout << std::setw(60) << std::left << name + " support";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    pass = true;
+    pass = pass && random_multinomial_deterministic<IntType>(n, 4, 3, p3);
+    pass = pass && random_multinomial_deterministic<IntType>(n, 100, 4, p4);
+    std::cout << std::setw(60) << std::left << name + " deterministic";
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    for (bool batch : {false, true}) {
+        const std::string method = batch ? " batch" : " scalar";
+        pass = true;
+        pass = pass && random_multinomial_chi2<IntType>(N, 4, 3, p3, batch);
+        pass = pass && random_multinomial_chi2<IntType>(N, 12, 3, p3, batch);
+        std::cout << std::setw(60) << std::left << name + " count" + method;
+        std::cout << std::setw(20) << std::right << random_pass(pass);
+        std::cout << std::endl;
+
+        pass = true;
+        pass = pass && random_multinomial_chi2<IntType>(N, 9, 2, p2, batch);
+        pass = pass && random_multinomial_chi2<IntType>(N, 13, 3, p3, batch);
+        pass = pass && random_multinomial_chi2<IntType>(N, 30, 5, p5, batch);
+        pass =
+            pass && random_multinomial_chi2<IntType>(N, 1000, 4, p4, batch);
+        std::cout << std::setw(60) << std::left << name + " binomial" + method;
+        std::cout << std::setw(20) << std::right << random_pass(pass);
+        std::cout << std::endl;
+    }
+}
+
+inline void random_multinomial(std::size_t N)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    random_multinomial<int>(N);
+    random_multinomial<long long>(N);
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_MULTINOMIAL_HPP
@@ -36,13 +36,12 @@
 #include <mckl/random/normal_mv_distribution.hpp>
 #include "random_distribution.hpp"
 
-template <typename RealType>
+template <typename RealType, typename DistType>
 inline void random_normal_mv(std::size_t N, std::size_t M,
-    const RealType *mean, const RealType *chol, bool scalar_mean,
-    bool scalar_chol)
+    const std::string &name, const RealType *mean, const RealType *chol,
+    bool scalar_mean, bool scalar_chol)
 {
-    using param_type =
-        typename mckl::NormalMVDistribution<RealType>::param_type;
+    using param_type = typename DistType::param_type;
 
     MCKLRNGType rng;
     MCKLRNGType rng1;
@@ -52,7 +51,7 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
 #endif
 
     mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
-    mckl::NormalMVDistribution<RealType> dist;
+    DistType dist;
     if (scalar_mean && scalar_chol)
         dist.param(param_type(2, mean[0], chol[0]));
     else if (scalar_mean && !scalar_chol)
@@ -151,13 +150,13 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
     }
 
     std::stringstream ss;
-    ss << "NormalMV" << '<' << random_typename<RealType>() << ">(";
+    ss << name << '<' << random_typename<RealType>() << ">(";
     const RealType *m = dist.mean();
     const RealType *c = dist.chol();
     ss << '{' << m[0] << ", " << m[1] << "}, ";
     ss << '{' << c[0] << ", " << c[1] << ", " << c[2] << "})";
 
-    std::cout << std::setw(40) << std::left << ss.str();
+    std::cout << std::setw(50) << std::left << ss.str();
     std::cout << std::setw(12) << std::right << c1;
     std::cout << std::setw(12) << std::right << c2;
 #if MCKL_HAS_MKL
@@ -184,16 +183,21 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
     txt.close();
 }
 
-template <typename RealType>
-inline void random_normal_mv(std::size_t N, std::size_t M)
+template <typename RealType, typename DistType>
+inline void random_normal_mv(
+    std::size_t N, std::size_t M, const std::string &name)
 {
     std::array<RealType, 2> mean = {{0, 1}};
     std::array<RealType, 3> chol = {{1, 2, 3}};
 
-    random_normal_mv(N, M, mean.data(), chol.data(), false, false);
-    random_normal_mv(N, M, mean.data(), chol.data(), false, true);
-    random_normal_mv(N, M, mean.data(), chol.data(), true, false);
-    random_normal_mv(N, M, mean.data(), chol.data(), true, true);
+    random_normal_mv<RealType, DistType>(
+        N, M, name, mean.data(), chol.data(), false, false);
+    random_normal_mv<RealType, DistType>(
+        N, M, name, mean.data(), chol.data(), false, true);
+    random_normal_mv<RealType, DistType>(
+        N, M, name, mean.data(), chol.data(), true, false);
+    random_normal_mv<RealType, DistType>(
+        N, M, name, mean.data(), chol.data(), true, true);
 }
 
 inline void random_normal_mv(std::size_t N, std::size_t M)
@@ -202,10 +206,10 @@ inline void random_normal_mv(std::size_t N, std::size_t M)
     txt << "V1\tV2\tDistribution\tImplementation\n";
     txt.close();
 
-    constexpr std::size_t lwid = 40 + 12 * (2 + MCKL_HAS_MKL) + 15;
+    constexpr std::size_t lwid = 50 + 12 * (2 + MCKL_HAS_MKL) + 15;
 
     std::cout << std::string(lwid, '=') << std::endl;
-    std::cout << std::setw(40) << std::left << "Distribution";
+    std::cout << std::setw(50) << std::left << "Distribution";
     if (mckl::StopWatch::has_cycles()) {
         std::cout << std::setw(12) << std::right << "cpE (S)";
         std::cout << std::setw(12) << std::right << "cpE (B)";
@@ -222,9 +226,15 @@ inline void random_normal_mv(std::size_t N, std::size_t M)
     std::cout << std::setw(15) << std::right << "Deterministics";
     std::cout << std::endl;
     std::cout << std::string(lwid, '-') << std::endl;
-    random_normal_mv<float>(N, M);
+    random_normal_mv<float, mckl::NormalMVDistribution<float>>(
+        N, M, "NormalMV");
+    random_normal_mv<float, mckl::NormalMVZigguratDistribution<float>>(
+        N, M, "NormalMVZiggurat");
     std::cout << std::string(lwid, '-') << std::endl;
-    random_normal_mv<double>(N, M);
+    random_normal_mv<double, mckl::NormalMVDistribution<double>>(
+        N, M, "NormalMV");
+    random_normal_mv<double, mckl::NormalMVZigguratDistribution<double>>(
+        N, M, "NormalMVZiggurat");
     std::cout << std::string(lwid, '-') << std::endl;
 }
 
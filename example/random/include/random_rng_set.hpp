@@ -0,0 +1,187 @@
+//============================================================================
+// MCKL/example/random/include/random_rng_set.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
+#define MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
+
+#include <mckl/random/philox.hpp>
+#include <mckl/random/rng_set.hpp>
+#include "random_common.hpp"
+#include <thread>
+
+template <typename T>
+inline bool random_rng_set_unique(mckl::Vector<T> r)
+{
+    std::sort(r.begin(), r.end());
+
+    return std::adjacent_find(r.begin(), r.end()) == r.end();
+}
+
+// Draw n numbers for each particle in each of m rounds, visiting the
+// particles in a different order in each round. The numbers of the i-th
+// particle are appended to r[i]
+template <typename RNGSetType, typename T>
+inline void random_rng_set_draw(RNGSetType &rng_set, std::size_t n,
+    std::size_t m, mckl::Vector<mckl::Vector<T>> &r)
+{
+    const std::size_t N = rng_set.size();
+    for (std::size_t k = 0; k != m; ++k) {
+        for (std::size_t j = 0; j != N; ++j) {
+            const std::size_t i = k % 2 == 0 ? (j + k * N / 3) % N : N - 1 - j;
+            auto &rng = rng_set[i];
+            for (std::size_t l = 0; l != n; ++l)
+                r[i].push_back(rng());
+        }
+    }
+}
+
+// Interleaving the particles, the numbers of all particles are distinct
+template <typename RNGType>
+inline bool random_rng_set_interleave(std::size_t N, std::size_t n)
+{
+    using result_type = typename RNGType::result_type;
+
+    mckl::RNGSetCounter<RNGType> rng_set(N);
+    mckl::Vector<mckl::Vector<result_type>> r(N);
+    random_rng_set_draw(rng_set, n, 4, r);
+    for (std::size_t l = 0; l != n; ++l)
+        for (std::size_t i = 0; i != N; ++i)
+            r[i].push_back(rng_set[i]());
+
+    mckl::Vector<result_type> all;
+    for (std::size_t i = 0; i != N; ++i)
+        all.insert(all.end(), r[i].begin(), r[i].end());
+
+    return all.size() == N * n * 5 && random_rng_set_unique(all);
+}
+
+// The numbers of a particle depend only on the calls made for it, not on how
+// they are interleaved with other particles or on which thread makes them
+template <typename RNGType>
+inline bool random_rng_set_order(std::size_t N, std::size_t n)
+{
+    using result_type = typename RNGType::result_type;
+
+    mckl::RNGSetCounter<RNGType> rng_set(N);
+    mckl::RNGSetCounter<RNGType> rng_seq(rng_set);
+    mckl::RNGSetCounter<RNGType> rng_thr(rng_set);
+
+    mckl::Vector<mckl::Vector<result_type>> r(N);
+    random_rng_set_draw(rng_set, n, 4, r);
+
+    mckl::Vector<mckl::Vector<result_type>> s(N);
+    for (std::size_t i = 0; i != N; ++i) {
+        for (std::size_t k = 0; k != 4; ++k) {
+            auto &rng = rng_seq[i];
+            for (std::size_t l = 0; l != n; ++l)
+                s[i].push_back(rng());
+        }
+    }
+
+    const std::size_t np = 4;
+    mckl::Vector<mckl::Vector<result_type>> t(N);
+    mckl::Vector<std::thread> threads;
+    for (std::size_t p = 0; p != np; ++p) {
+        threads.emplace_back([&, p]() {
+            for (std::size_t k = 0; k != 4; ++k) {
+                for (std::size_t i = p; i < N; i += np) {
+                    auto &rng = rng_thr[i];
+                    for (std::size_t l = 0; l != n; ++l)
+                        t[i].push_back(rng());
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    return r == s && r == t;
+}
+
+// Particles removed and added back do not repeat their numbers, and reset
+// starts all particles over with a new key
+template <typename RNGType>
+inline bool random_rng_set_resize(std::size_t N, std::size_t n)
+{
+    using result_type = typename RNGType::result_type;
+
+    mckl::RNGSetCounter<RNGType> rng_set(N);
+    mckl::Vector<mckl::Vector<result_type>> r(N);
+    random_rng_set_draw(rng_set, n, 1, r);
+    rng_set.resize(N / 2);
+    rng_set.resize(N);
+    random_rng_set_draw(rng_set, n, 1, r);
+
+    bool pass = rng_set.size() == N;
+    mckl::Vector<result_type> all;
+    for (std::size_t i = 0; i != N; ++i)
+        all.insert(all.end(), r[i].begin(), r[i].end());
+    pass = pass && random_rng_set_unique(all);
+
+    mckl::RNGSetCounter<RNGType> rng_copy(rng_set);
+    rng_set.reset();
+    mckl::Vector<mckl::Vector<result_type>> s(N);
+    mckl::Vector<mckl::Vector<result_type>> t(N);
+    random_rng_set_draw(rng_set, n, 1, s);
+    random_rng_set_draw(rng_copy, n, 1, t);
+    for (std::size_t i = 0; i != N; ++i)
+        pass = pass && s[i] != r[i] && s[i] != t[i];
+
+    return pass;
+}
+
+template <typename RNGType>
+inline void random_rng_set(
+    std::size_t N, std::size_t n, const std::string &name)
+{
+    const bool pass1 = random_rng_set_interleave<RNGType>(N, n);
+    std::cout << std::setw(60) << std::left << name + " interleave";
+    std::cout << std::setw(20) << std::right << random_pass(pass1);
+    std::cout << std::endl;
+    const bool pass2 = random_rng_set_order<RNGType>(N, n);
+    std::cout << std::setw(60) << std::left << name + " order";
+    std::cout << std::setw(20) << std::right << random_pass(pass2);
+    std::cout << std::endl;
+    const bool pass3 = random_rng_set_resize<RNGType>(N, n);
+    std::cout << std::setw(60) << std::left << name + " resize";
+    std::cout << std::setw(20) << std::right << random_pass(pass3);
+    std::cout << std::endl;
+}
+
+inline void random_rng_set(std::size_t N, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    random_rng_set<mckl::Philox4x32_64>(N, n, "Philox4x32_64");
+    random_rng_set<mckl::Philox4x64_64>(N, n, "Philox4x64_64");
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_RNG_SET_HPP
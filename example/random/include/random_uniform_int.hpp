@@ -0,0 +1,278 @@
+//============================================================================
+// MCKL/example/random/include/random_uniform_int.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_UNIFORM_INT_HPP
+#define MCKL_EXAMPLE_RANDOM_UNIFORM_INT_HPP
+
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_bits_distribution.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include "random_common.hpp"
+
+inline bool random_uniform_int_reference(std::size_t n,
+    const std::uint32_t *u, std::uint32_t s, std::uint32_t t,
+    std::uint32_t *r)
+{
+    bool reject = false;
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::uint64_t m = static_cast<std::uint64_t>(u[i]) * s;
+        r[i] = static_cast<std::uint32_t>(m >> 32);
+        reject = reject || static_cast<std::uint32_t>(m) < t;
+    }
+
+    return reject;
+}
+
+// The multiply-shift kernel against the reference, for all lengths up to N
+// and ranges with no, rare and frequent rejections. Some inputs are zero,
+// which are rejected whenever the threshold is not zero.
+template <typename Impl>
+inline bool random_uniform_int_kernel(std::size_t N)
+{
+    const std::uint32_t range[] = {1, 3, 1000, 0x80000001, 0xFFFFFFFF};
+
+    mckl::RNG rng;
+    mckl::UniformBitsDistribution<std::uint32_t> ubits;
+    mckl::Vector<std::uint32_t> u(N);
+    mckl::Vector<std::uint32_t> r1(N);
+    mckl::Vector<std::uint32_t> r2(N);
+    bool pass = true;
+    for (std::uint32_t s : range) {
+        const std::uint32_t t = static_cast<std::uint32_t>(0 - s) % s;
+        for (std::size_t n = 0; n <= N; ++n) {
+            for (std::size_t i = 0; i != n; ++i) {
+                const std::uint32_t v = ubits(rng);
+                u[i] = v % 16 == 0 ? 0 : v;
+            }
+            const bool reject1 = random_uniform_int_reference(
+                n, u.data(), s, t, r1.data());
+            const bool reject2 = Impl::eval(n, u.data(), s, t, r2.data());
+            pass = pass && reject1 == reject2;
+            pass = pass && std::equal(r1.begin(), r1.begin() + n, r2.begin());
+        }
+    }
+
+    return pass;
+}
+
+// Map all 2^32 inputs by the kernel used by UniformIntDistribution, and
+// check that every integer in [0, s) is the result of exactly the same
+// number of accepted inputs
+inline bool random_uniform_int_exact(std::uint32_t s)
+{
+    constexpr std::size_t K = 4096;
+    constexpr std::uint64_t M = std::uint64_t(1) << 32;
+
+    const std::uint32_t t = static_cast<std::uint32_t>(0 - s) % s;
+    mckl::Vector<std::uint32_t> u(K);
+    mckl::Vector<std::uint32_t> r(K);
+    mckl::Vector<std::uint64_t> count(s, 0);
+    bool pass = true;
+    for (std::uint64_t x = 0; x < M; x += K) {
+        for (std::size_t i = 0; i != K; ++i)
+            u[i] = static_cast<std::uint32_t>(x + i);
+        const bool reject =
+            mckl::internal::UniformIntImpl::eval(K, u.data(), s, t, r.data());
+        bool rejected = false;
+        for (std::size_t i = 0; i != K; ++i) {
+            const std::uint64_t m = static_cast<std::uint64_t>(u[i]) * s;
+            if (static_cast<std::uint32_t>(m) < t)
+                rejected = true;
+            else
+                ++count[r[i]];
+        }
+        pass = pass && reject == rejected;
+    }
+    for (std::uint32_t k = 0; k != s; ++k)
+        pass = pass && count[k] == M / s;
+
+    return pass;
+}
+
+// All integers generated by the scalar and batch methods are within [a, b]
+template <typename IntType>
+inline bool random_uniform_int_range(std::size_t N, IntType a, IntType b)
+{
+    mckl::RNG rng;
+    mckl::UniformIntDistribution<IntType> dist(a, b);
+    mckl::Vector<IntType> r(N);
+    bool pass = true;
+
+    mckl::rand(rng, dist, N, r.data());
+    for (std::size_t i = 0; i != N; ++i)
+        pass = pass && r[i] >= a && r[i] <= b;
+    for (std::size_t i = 0; i != N; ++i) {
+        const IntType x = dist(rng);
+        pass = pass && x >= a && x <= b;
+    }
+    if (a == b)
+        return pass;
+
+    // Both ends are hit for small ranges
+    if (mckl::internal::uniform_int_distribution_range(a, b) < 10) {
+        pass = pass && std::find(r.begin(), r.end(), a) != r.end();
+        pass = pass && std::find(r.begin(), r.end(), b) != r.end();
+    }
+
+    return pass;
+}
+
+template <typename IntType>
+inline bool random_uniform_int_range(std::size_t N)
+{
+    constexpr IntType lmin = std::numeric_limits<IntType>::min();
+    constexpr IntType lmax = std::numeric_limits<IntType>::max();
+
+    bool pass = true;
+    pass = pass && random_uniform_int_range<IntType>(N, 0, 0);
+    pass = pass && random_uniform_int_range<IntType>(N, lmax, lmax);
+    pass = pass && random_uniform_int_range<IntType>(N, lmin, lmin + 1);
+    pass = pass && random_uniform_int_range<IntType>(N, lmax - 1, lmax);
+    pass = pass && random_uniform_int_range<IntType>(N, 0, 9);
+    pass = pass && random_uniform_int_range<IntType>(N, lmin, lmax);
+    pass = pass && random_uniform_int_range<IntType>(N, lmin, lmax / 2);
+    pass = pass && random_uniform_int_range<IntType>(N, lmax / 2, lmax);
+    if (sizeof(IntType) == sizeof(std::uint64_t)) {
+        constexpr IntType m32 = static_cast<IntType>(
+            std::numeric_limits<std::uint32_t>::max());
+        pass = pass && random_uniform_int_range<IntType>(N, 0, m32 - 1);
+        pass = pass && random_uniform_int_range<IntType>(N, 0, m32);
+        pass = pass && random_uniform_int_range<IntType>(N, 0, m32 + 1);
+        pass = pass && random_uniform_int_range<IntType>(N, 1, m32 + 1);
+    }
+
+    return pass;
+}
+
+// Pearson's chi-squared test of 10 equally likely bins of the integers
+// a + k * w + j, 0 <= j < w, at level 0.001
+template <typename IntType>
+inline bool random_uniform_int_chi2(
+    std::size_t N, IntType a, std::uint64_t w, bool batch)
+{
+    mckl::RNG rng;
+    const IntType b = mckl::internal::uniform_int_distribution_shift(
+        a, 10 * w - 1);
+    mckl::UniformIntDistribution<IntType> dist(a, b);
+    mckl::Vector<IntType> r(N);
+    if (batch) {
+        mckl::rand(rng, dist, N, r.data());
+    } else {
+        for (std::size_t i = 0; i != N; ++i)
+            r[i] = dist(rng);
+    }
+
+    std::array<double, 10> count;
+    count.fill(0);
+    for (std::size_t i = 0; i != N; ++i) {
+        ++count[static_cast<std::size_t>(
+            mckl::internal::uniform_int_distribution_range(a, r[i]) / w)];
+    }
+    const double e = N / 10.0;
+    double chi2 = 0;
+    for (double c : count)
+        chi2 += (c - e) * (c - e) / e;
+
+    return chi2 < 27.877;
+}
+
+template <typename IntType>
+inline bool random_uniform_int_chi2(std::size_t N, bool batch)
+{
+    bool pass = true;
+    pass = pass && random_uniform_int_chi2<IntType>(N, 0, 1, batch);
+    pass = pass && random_uniform_int_chi2<IntType>(N, 5, 1000, batch);
+    pass = pass &&
+        random_uniform_int_chi2<IntType>(N, 0, 0xCCCCCCC, batch);
+    if (sizeof(IntType) == sizeof(std::uint64_t)) {
+        pass = pass &&
+            random_uniform_int_chi2<IntType>(
+                N, 3, std::uint64_t(1) << 40, batch);
+    }
+    if (std::is_signed<IntType>::value)
+        pass = pass && random_uniform_int_chi2<IntType>(N, -5, 3, batch);
+
+    return pass;
+}
+
+template <typename IntType>
+inline void random_uniform_int(std::size_t N)
+{
+    const std::string name =
+        "UniformIntDistribution<" + random_typename<IntType>() + ">";
+    const bool pass1 = random_uniform_int_range<IntType>(N);
+    std::cout << std::setw(60) << std::left << name + " range";
+    std::cout << std::setw(20) << std::right << random_pass(pass1);
+    std::cout << std::endl;
+    const bool pass2 = random_uniform_int_chi2<IntType>(N, false);
+    std::cout << std::setw(60) << std::left << name + " scalar";
+    std::cout << std::setw(20) << std::right << random_pass(pass2);
+    std::cout << std::endl;
+    const bool pass3 = random_uniform_int_chi2<IntType>(N, true);
+    std::cout << std::setw(60) << std::left << name + " batch";
+    std::cout << std::setw(20) << std::right << random_pass(pass3);
+    std::cout << std::endl;
+}
+
+inline void random_uniform_int(std::size_t N, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass4 =
+        random_uniform_int_kernel<mckl::internal::UniformIntGenericImpl>(n);
+    std::cout << std::setw(60) << std::left << "UniformIntGenericImpl";
+    std::cout << std::setw(20) << std::right << random_pass(pass4);
+    std::cout << std::endl;
+#if MCKL_USE_AVX2
+    const bool pass5 =
+        random_uniform_int_kernel<mckl::internal::UniformIntAVX2Impl>(n);
+    std::cout << std::setw(60) << std::left << "UniformIntAVX2Impl";
+    std::cout << std::setw(20) << std::right << random_pass(pass5);
+    std::cout << std::endl;
+#endif
+#if MCKL_USE_AVX512
+    const bool pass6 =
+        random_uniform_int_kernel<mckl::internal::UniformIntAVX512Impl>(n);
+    std::cout << std::setw(60) << std::left << "UniformIntAVX512Impl";
+    std::cout << std::setw(20) << std::right << random_pass(pass6);
+    std::cout << std::endl;
+#endif
+    const bool pass7 = random_uniform_int_exact(1000);
+    std::cout << std::setw(60) << std::left << "UniformIntImpl exact 1000";
+    std::cout << std::setw(20) << std::right << random_pass(pass7);
+    std::cout << std::endl;
+    random_uniform_int<int>(N);
+    random_uniform_int<unsigned>(N);
+    random_uniform_int<long long>(N);
+    random_uniform_int<unsigned long long>(N);
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_UNIFORM_INT_HPP
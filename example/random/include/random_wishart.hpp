@@ -0,0 +1,270 @@
+//============================================================================
+// MCKL/example/random/include/random_wishart.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_WISHART_HPP
+#define MCKL_EXAMPLE_RANDOM_WISHART_HPP
+
+#include <mckl/random/inverse_wishart_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/wishart_distribution.hpp>
+#include "random_common.hpp"
+
+template <typename RealType>
+inline RealType random_wishart_eps()
+{
+    return std::sqrt(std::numeric_limits<RealType>::epsilon());
+}
+
+// The packed lower triangular elements of L * L^T for a packed lower
+// triangular L
+inline mckl::Vector<double> random_wishart_scale(
+    std::size_t dim, const double *chol)
+{
+    mckl::Vector<double> scale;
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            double s = 0;
+            for (std::size_t l = 0; l <= j; ++l)
+                s += chol[i * (i + 1) / 2 + l] * chol[j * (j + 1) / 2 + l];
+            scale.push_back(s);
+        }
+    }
+
+    return scale;
+}
+
+// The cross products of upper triangular matrices against the naive sums
+template <typename RealType>
+inline bool random_wishart_crossprod(std::size_t n, std::size_t dim)
+{
+    const std::size_t dd = dim * dim;
+    const std::size_t dp = dim * (dim + 1) / 2;
+    const RealType scale = static_cast<RealType>(1.5);
+
+    mckl::RNG rng;
+    mckl::NormalDistribution<RealType> normal(0, 1);
+    mckl::Vector<RealType> g(n * dd, 0);
+    mckl::Vector<RealType> r(n * dp);
+    for (std::size_t k = 0; k != n; ++k)
+        for (std::size_t i = 0; i != dim; ++i)
+            for (std::size_t j = i; j != dim; ++j)
+                g[k * dd + i * dim + j] = normal(rng);
+    mckl::internal::wishart_distribution_crossprod(
+        n, r.data(), dim, g.data(), scale);
+
+    bool pass = true;
+    const RealType *x = r.data();
+    for (std::size_t k = 0; k != n; ++k) {
+        const RealType *a = g.data() + k * dd;
+        for (std::size_t i = 0; i != dim; ++i) {
+            for (std::size_t j = 0; j <= i; ++j, ++x) {
+                RealType s = 0;
+                for (std::size_t l = 0; l <= j; ++l)
+                    s += a[l * dim + i] * a[l * dim + j];
+                s *= scale;
+                pass = pass &&
+                    std::abs(*x - s) <=
+                        random_wishart_eps<RealType>() * (1 + std::abs(s));
+            }
+        }
+    }
+
+    return pass;
+}
+
+// A scalar scale c and the Cholesky factor c * I give the same matrices
+template <typename DistType>
+inline bool random_wishart_scalar(std::size_t n, std::size_t dim)
+{
+    using result_type = typename DistType::result_type;
+
+    const std::size_t dp = dim * (dim + 1) / 2;
+    const result_type c = 2;
+    const result_type df = static_cast<result_type>(dim + 2);
+    mckl::Vector<result_type> chol(dp, 0);
+    for (std::size_t i = 0; i != dim; ++i)
+        chol[i * (i + 1) / 2 + i] = c;
+
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    DistType dist1(dim, df, c);
+    DistType dist2(dim, df, chol.data());
+    mckl::Vector<result_type> r1(n * dp);
+    mckl::Vector<result_type> r2(n * dp);
+    mckl::rand(rng1, dist1, n, r1.data());
+    mckl::rand(rng2, dist2, n, r2.data());
+
+    bool pass = true;
+    for (std::size_t i = 0; i != n * dp; ++i) {
+        pass = pass &&
+            std::abs(r1[i] - r2[i]) <=
+                random_wishart_eps<result_type>() * (1 + std::abs(r1[i]));
+    }
+
+    return pass;
+}
+
+// The same matrices are generated after the distribution is written to and
+// read back from a stream, and by a distribution with other parameters when
+// the parameters are passed to operator()
+template <typename DistType>
+inline bool random_wishart_deterministic(
+    std::size_t n, std::size_t dim, const double *chol)
+{
+    using result_type = typename DistType::result_type;
+
+    const std::size_t dp = dim * (dim + 1) / 2;
+    mckl::Vector<result_type> L(chol, chol + dp);
+    DistType dist1(dim, static_cast<result_type>(dim + 4), L.data());
+    DistType dist;
+
+    mckl::RNG rng1;
+    mckl::RNG rng2;
+    mckl::Vector<result_type> r1(n * dp);
+    mckl::Vector<result_type> r2(n * dp);
+    bool pass = true;
+
+    std::stringstream ss;
+    ss.precision(20);
+    ss << dist1;
+    ss >> dist;
+    pass = pass && dist == dist1;
+    mckl::rand(rng1, dist1, n, r1.data());
+    mckl::rand(rng2, dist, n, r2.data());
+    pass = pass && r1 == r2;
+
+    dist = DistType(dim);
+    dist(rng1, n, r1.data(), dist1.param());
+    dist1(rng2, n, r2.data());
+    pass = pass && r1 == r2;
+
+    return pass;
+}
+
+// The mean of each element is within five standard errors of df * S for
+// the Wishart distribution, and of S / (df - dim - 1) for the inverse
+// Wishart distribution, where S = L * L^T
+template <typename DistType>
+inline bool random_wishart_mean(std::size_t N, std::size_t dim,
+    const double *chol, double df, bool inverse)
+{
+    using result_type = typename DistType::result_type;
+
+    const std::size_t dp = dim * (dim + 1) / 2;
+    mckl::Vector<result_type> L(chol, chol + dp);
+    DistType dist(dim, static_cast<result_type>(df), L.data());
+    mckl::RNG rng;
+    mckl::Vector<result_type> r(N * dp);
+    mckl::rand(rng, dist, N, r.data());
+
+    mckl::Vector<double> mean = random_wishart_scale(dim, chol);
+    const double c = inverse ? 1 / (df - dim - 1) : df;
+    bool pass = true;
+    for (std::size_t j = 0; j != dp; ++j) {
+        double s = 0;
+        double ss = 0;
+        for (std::size_t i = 0; i != N; ++i) {
+            const double x = static_cast<double>(r[i * dp + j]);
+            s += x;
+            ss += x * x;
+        }
+        const double m = s / N;
+        const double v = (ss - s * m) / (N - 1);
+        pass = pass && std::abs(m - c * mean[j]) <= 5 * std::sqrt(v / N);
+    }
+
+    return pass;
+}
+
+template <typename RealType>
+inline void random_wishart(std::size_t N, std::size_t n)
+{
+    const double chol[] = {1, 0.5, 2, -0.3, 0.2, 1.5};
+    const std::size_t D = 6;
+
+    using wishart = mckl::WishartDistribution<RealType>;
+    using inverse_wishart = mckl::InverseWishartDistribution<RealType>;
+
+    const std::string type = "<" + random_typename<RealType>() + ">";
+    bool pass = true;
+    for (std::size_t dim = 1; dim <= D; ++dim)
+        pass = pass && random_wishart_crossprod<RealType>(n, dim);
+    std::cout << std::setw(60) << std::left
+              << "wishart_distribution_crossprod" + type;
+    std::cout << std::setw(20) << std::right << random_pass(pass);
+    std::cout << std::endl;
+
+    for (bool inverse : {false, true}) {
+        const std::string name =
+            (inverse ? "InverseWishartDistribution" : "WishartDistribution") +
+            type;
+
+        pass = true;
+        for (std::size_t dim = 1; dim <= D; ++dim) {
+            pass = pass &&
+                (inverse ? random_wishart_scalar<inverse_wishart>(n, dim) :
+                           random_wishart_scalar<wishart>(n, dim));
+        }
+        std::cout << std::setw(60) << std::left << name + " scalar";
+        std::cout << std::setw(20) << std::right << random_pass(pass);
+        std::cout << std::endl;
+
+        pass = inverse ?
+            random_wishart_deterministic<inverse_wishart>(n, 3, chol) :
+            random_wishart_deterministic<wishart>(n, 3, chol);
+        std::cout << std::setw(60) << std::left << name + " deterministic";
+        std::cout << std::setw(20) << std::right << random_pass(pass);
+        std::cout << std::endl;
+
+        pass = true;
+        for (std::size_t dim = 1; dim <= 3; ++dim) {
+            const double df = dim + 6.5;
+            pass = pass &&
+                (inverse ? random_wishart_mean<inverse_wishart>(
+                               N, dim, chol, df, true) :
+                           random_wishart_mean<wishart>(
+                               N, dim, chol, df, false));
+        }
+        std::cout << std::setw(60) << std::left << name + " mean";
+        std::cout << std::setw(20) << std::right << random_pass(pass);
+        std::cout << std::endl;
+    }
+}
+
+inline void random_wishart(std::size_t N, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    random_wishart<float>(N, n);
+    random_wishart<double>(N, n);
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_WISHART_HPP
@@ -0,0 +1,260 @@
+//============================================================================
+// MCKL/example/random/src/random_dispatch.cpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION); HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE);
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#include <mckl/random/threefry.hpp>
+#include <mckl/random/u01.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include <iomanip>
+#include <iostream>
+#include "random_common.hpp"
+
+#if MCKL_USE_RUNTIME_DISPATCH
+#include <mckl/random/internal/threefry_dispatch.hpp>
+#include <mckl/random/internal/u01_dispatch.hpp>
+#include <mckl/random/internal/uniform_int_dispatch.hpp>
+#endif
+
+#if MCKL_USE_RUNTIME_DISPATCH
+
+// Every kernel the dispatcher may select gives the same output and the same
+// final counter as the portable implementation
+template <typename T, std::size_t K>
+inline void random_dispatch_threefry(const std::string &name)
+{
+    using constants = mckl::ThreefryConstants<T, K>;
+    using generic = mckl::internal::ThreefryGeneratorGenericImpl<T, K,
+        MCKL_THREEFRY_ROUNDS, constants>;
+    using dispatch = mckl::internal::ThreefryGeneratorDispatchImpl<T, K,
+        MCKL_THREEFRY_ROUNDS, constants, generic>;
+    using kernel_type = void (*)(mckl::Counter<T, K> &, std::size_t,
+        std::uint32_t *, const std::array<T, K + 4> &);
+
+    const std::size_t n = 1003;
+    const std::size_t R = sizeof(T) * K / sizeof(std::uint32_t);
+
+    std::array<T, K + 4> par;
+    for (std::size_t i = 0; i != par.size(); ++i)
+        par[i] = static_cast<T>(0x9E3779B97F4A7C15ULL * (i + 1));
+
+    mckl::Counter<T, K> ctr;
+    ctr.fill(0);
+    mckl::Vector<std::uint32_t> r(n * R);
+    generic::eval(ctr, n, r.data(), par);
+
+    auto check = [&](const std::string &isa, kernel_type kernel) {
+        mckl::Counter<T, K> c;
+        c.fill(0);
+        mckl::Vector<std::uint32_t> s(n * R);
+        kernel(c, n, s.data(), par);
+        const bool pass1 = c == ctr && s == r;
+        std::cout << std::setw(60) << std::left << name + " " + isa;
+        std::cout << std::setw(20) << std::right << random_pass(pass1);
+        std::cout << std::endl;
+    };
+
+    check("Dispatch", dispatch::template eval<std::uint32_t>);
+    if (mckl::internal::CPUID::avx2()) {
+        check("AVX2",
+            mckl::internal::threefry_avx2_kernel<T, K, MCKL_THREEFRY_ROUNDS,
+                constants, std::uint32_t>);
+    }
+    if (mckl::internal::CPUID::avx512()) {
+        check("AVX512",
+            mckl::internal::threefry_avx512_kernel<T, K, MCKL_THREEFRY_ROUNDS,
+                constants, std::uint32_t>);
+    }
+}
+
+template <typename UIntType, typename RealType, typename Lower,
+    typename Upper>
+inline void random_dispatch_u01(const std::string &name)
+{
+    using generic =
+        mckl::internal::U01GenericImpl<UIntType, RealType, Lower, Upper>;
+    using dispatch = mckl::internal::U01DispatchImpl<UIntType, RealType,
+        Lower, Upper, generic>;
+    using kernel_type = mckl::internal::U01KernelType<UIntType, RealType>;
+
+    const std::size_t n = 1003;
+
+    mckl::Vector<UIntType> u(n);
+    for (std::size_t i = 0; i != n; ++i)
+        u[i] = static_cast<UIntType>(0x9E3779B97F4A7C15ULL * i);
+    u.front() = 0;
+    u.back() = std::numeric_limits<UIntType>::max();
+
+    mckl::Vector<RealType> r(n);
+    generic::eval(n, u.data(), r.data());
+
+    auto check = [&](const std::string &isa, kernel_type kernel) {
+        mckl::Vector<RealType> s(n);
+        kernel(n, u.data(), s.data());
+        std::cout << std::setw(60) << std::left << name + " " + isa;
+        std::cout << std::setw(20) << std::right << random_pass(s == r);
+        std::cout << std::endl;
+    };
+
+    check("Dispatch", dispatch::eval);
+    if (mckl::internal::CPUID::avx2()) {
+        check("AVX2",
+            mckl::internal::u01_avx2_kernel<UIntType, RealType, Lower,
+                Upper>);
+    }
+    if (mckl::internal::CPUID::avx512()) {
+        check("AVX512",
+            mckl::internal::u01_avx512_kernel<UIntType, RealType, Lower,
+                Upper>);
+    }
+}
+
+template <typename UIntType, typename RealType, int M>
+inline void random_dispatch_u01_canonical(const std::string &name)
+{
+    using generic =
+        mckl::internal::U01CanonicalGenericImpl<UIntType, RealType, M>;
+    using dispatch = mckl::internal::U01CanonicalDispatchImpl<UIntType,
+        RealType, M, generic>;
+    using kernel_type = mckl::internal::U01KernelType<UIntType, RealType>;
+
+    const std::size_t n = 1003;
+
+    mckl::Vector<UIntType> u(n * M);
+    for (std::size_t i = 0; i != n * M; ++i)
+        u[i] = static_cast<UIntType>(0x9E3779B97F4A7C15ULL * i);
+
+    mckl::Vector<RealType> r(n);
+    generic::eval(n, u.data(), r.data());
+
+    auto check = [&](const std::string &isa, kernel_type kernel) {
+        mckl::Vector<RealType> s(n);
+        kernel(n, u.data(), s.data());
+        std::cout << std::setw(60) << std::left << name + " " + isa;
+        std::cout << std::setw(20) << std::right << random_pass(s == r);
+        std::cout << std::endl;
+    };
+
+    check("Dispatch", dispatch::eval);
+    if (mckl::internal::CPUID::avx2()) {
+        check("AVX2",
+            mckl::internal::u01_canonical_avx2_kernel<UIntType, RealType,
+                M>);
+    }
+    if (mckl::internal::CPUID::avx512()) {
+        check("AVX512",
+            mckl::internal::u01_canonical_avx512_kernel<UIntType, RealType,
+                M>);
+    }
+}
+
+template <typename UIntType, typename RealType>
+inline void random_dispatch_u01(const std::string &name)
+{
+    random_dispatch_u01<UIntType, RealType, mckl::Closed, mckl::Closed>(
+        name + " [0, 1]");
+    random_dispatch_u01<UIntType, RealType, mckl::Closed, mckl::Open>(
+        name + " [0, 1)");
+    random_dispatch_u01<UIntType, RealType, mckl::Open, mckl::Closed>(
+        name + " (0, 1]");
+    random_dispatch_u01<UIntType, RealType, mckl::Open, mckl::Open>(
+        name + " (0, 1)");
+}
+
+inline void random_dispatch_uniform_int(const std::string &name)
+{
+    using generic = mckl::internal::UniformIntGenericImpl;
+    using dispatch = mckl::internal::UniformIntDispatchImpl<generic>;
+    using kernel_type = mckl::internal::UniformIntKernelType;
+
+    const std::size_t n = 1003;
+    const std::uint32_t range[] = {1, 3, 1000, 0x80000001, 0xFFFFFFFF};
+
+    mckl::Vector<std::uint32_t> u(n);
+    for (std::size_t i = 0; i != n; ++i)
+        u[i] = static_cast<std::uint32_t>(0x9E3779B97F4A7C15ULL * i);
+
+    auto check = [&](const std::string &isa, kernel_type kernel) {
+        bool pass1 = true;
+        for (std::uint32_t s : range) {
+            const std::uint32_t t = static_cast<std::uint32_t>(0 - s) % s;
+            for (std::size_t k = n - 32; k <= n; ++k) {
+                mckl::Vector<std::uint32_t> r(k);
+                mckl::Vector<std::uint32_t> v(k);
+                const bool reject1 =
+                    generic::eval(k, u.data(), s, t, r.data());
+                const bool reject2 = kernel(k, u.data(), s, t, v.data());
+                pass1 = pass1 && reject1 == reject2 && r == v;
+            }
+        }
+        std::cout << std::setw(60) << std::left << name + " " + isa;
+        std::cout << std::setw(20) << std::right << random_pass(pass1);
+        std::cout << std::endl;
+    };
+
+    check("Dispatch", dispatch::eval);
+    if (mckl::internal::CPUID::avx2())
+        check("AVX2", mckl::internal::uniform_int_avx2_kernel);
+    if (mckl::internal::CPUID::avx512())
+        check("AVX512", mckl::internal::uniform_int_avx512_kernel);
+}
+
+#endif // MCKL_USE_RUNTIME_DISPATCH
+
+int main()
+{
+#if MCKL_USE_RUNTIME_DISPATCH
+    std::cout << std::string(80, '=') << std::endl;
+    random_dispatch_threefry<std::uint32_t, 2>("Threefry2x32");
+    random_dispatch_threefry<std::uint32_t, 4>("Threefry4x32");
+    random_dispatch_threefry<std::uint64_t, 2>("Threefry2x64");
+    random_dispatch_threefry<std::uint64_t, 4>("Threefry4x64");
+    random_dispatch_threefry<std::uint64_t, 8>("Threefry8x64");
+    random_dispatch_threefry<std::uint64_t, 16>("Threefry16x64");
+    std::cout << std::string(80, '-') << std::endl;
+    random_dispatch_u01<std::uint32_t, float>("U01<uint32_t, float>");
+    random_dispatch_u01<std::uint32_t, double>("U01<uint32_t, double>");
+    random_dispatch_u01<std::uint64_t, float>("U01<uint64_t, float>");
+    random_dispatch_u01<std::uint64_t, double>("U01<uint64_t, double>");
+    std::cout << std::string(80, '-') << std::endl;
+    random_dispatch_u01_canonical<std::uint32_t, float, 1>(
+        "U01Canonical<uint32_t, float, 1>");
+    random_dispatch_u01_canonical<std::uint32_t, double, 2>(
+        "U01Canonical<uint32_t, double, 2>");
+    random_dispatch_u01_canonical<std::uint64_t, double, 1>(
+        "U01Canonical<uint64_t, double, 1>");
+    random_dispatch_u01_canonical<std::uint64_t, long double, 2>(
+        "U01Canonical<uint64_t, long double, 2>");
+    std::cout << std::string(80, '-') << std::endl;
+    random_dispatch_uniform_int("UniformInt");
+    std::cout << std::string(80, '-') << std::endl;
+#endif
+
+    return 0;
+}
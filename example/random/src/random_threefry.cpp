@@ -0,0 +1,91 @@
+//============================================================================
+// MCKL/example/random/src/random_threefry.cpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION); HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE);
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#include <mckl/random/threefry.hpp>
+#include <iomanip>
+#include <iostream>
+
+// Batch generation with the counter near its maximum gives the same output
+// and the same final counter as repeated single block generation
+template <typename RNGType>
+inline bool random_threefry_overflow(std::size_t d, bool carry)
+{
+    using generator_type = typename RNGType::generator_type;
+    using ctr_type = typename RNGType::ctr_type;
+    using T = typename ctr_type::value_type;
+
+    const std::size_t n = 100;
+    const std::size_t R = generator_type::size() / sizeof(std::uint32_t);
+
+    generator_type generator;
+    ctr_type ctr1;
+    ctr1.fill(carry ? std::numeric_limits<T>::max() : 0);
+    ctr1.front() = std::numeric_limits<T>::max() - static_cast<T>(d);
+    ctr_type ctr2 = ctr1;
+
+    mckl::Vector<std::uint32_t> r1(n * R);
+    mckl::Vector<std::uint32_t> r2(n * R);
+    for (std::size_t i = 0; i != n; ++i)
+        generator(ctr1, r1.data() + i * R);
+    generator(ctr2, n, r2.data());
+
+    return ctr1 == ctr2 && r1 == r2;
+}
+
+template <typename RNGType>
+inline void random_threefry(const std::string &name)
+{
+    bool pass = true;
+    for (std::size_t d = 0; d != 64; ++d) {
+        pass = pass && random_threefry_overflow<RNGType>(d, false);
+        pass = pass && random_threefry_overflow<RNGType>(d, true);
+    }
+    std::cout << std::setw(60) << std::left << (name + " counter overflow")
+              << std::setw(20) << std::right << (pass ? "Passed" : "Failed")
+              << std::endl;
+}
+
+int main()
+{
+    std::cout << std::string(80, '=') << std::endl;
+    random_threefry<mckl::Threefry2x32>("Threefry2x32");
+    random_threefry<mckl::Threefry4x32>("Threefry4x32");
+    random_threefry<mckl::Threefry2x64>("Threefry2x64");
+    random_threefry<mckl::Threefry4x64>("Threefry4x64");
+    random_threefry<mckl::Threefry8x64>("Threefry8x64");
+    random_threefry<mckl::Threefry16x64>("Threefry16x64");
+    random_threefry<mckl::Threefish256>("Threefish256");
+    random_threefry<mckl::Threefish512>("Threefish512");
+    random_threefry<mckl::Threefish1024>("Threefish1024");
+    std::cout << std::string(80, '-') << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+//============================================================================
+// MCKL/example/smp/include/smp_backend_omp.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_SMP_BACKEND_OMP_HPP
+#define MCKL_EXAMPLE_SMP_BACKEND_OMP_HPP
+
+#include <mckl/smp/backend_omp.hpp>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+
+// Each index is passed to work exactly once
+inline bool smp_backend_omp_coverage(std::size_t N)
+{
+    mckl::Vector<std::atomic<int>> count(N);
+    for (auto &c : count)
+        c = 0;
+    mckl::RunSMP<mckl::BackendOMP>()(
+        N, [&](std::size_t ibegin, std::size_t iend) {
+            for (std::size_t i = ibegin; i != iend; ++i)
+                ++count[i];
+        });
+
+    for (auto &c : count)
+        if (c != 1)
+            return false;
+
+    return true;
+}
+
+// The affinity of the calling thread is the same before and after a
+// parallel region
+inline bool smp_backend_omp_affinity(std::size_t N)
+{
+    mckl::BackendOMP &backend = mckl::BackendOMP::instance();
+    backend.affinity(true);
+#if MCKL_HAS_THREAD_AFFINITY
+    ::cpu_set_t before;
+    ::cpu_set_t after;
+    CPU_ZERO(&before);
+    CPU_ZERO(&after);
+    ::pthread_getaffinity_np(::pthread_self(), sizeof(before), &before);
+    bool pass = smp_backend_omp_coverage(N);
+    ::pthread_getaffinity_np(::pthread_self(), sizeof(after), &after);
+    pass = pass && CPU_EQUAL(&before, &after);
+#else
+    bool pass = smp_backend_omp_coverage(N);
+#endif
+    backend.affinity(false);
+
+    return pass;
+}
+
+inline void smp_backend_omp(std::size_t N)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 = smp_backend_omp_coverage(N);
+    std::cout << std::setw(60) << std::left << "Coverage";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = smp_backend_omp_affinity(N);
+    std::cout << std::setw(60) << std::left << "Caller affinity restored";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = smp_backend_omp_coverage(N);
+    std::cout << std::setw(60) << std::left
+              << "Coverage after affinity disabled";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_SMP_BACKEND_OMP_HPP
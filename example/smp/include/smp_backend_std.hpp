@@ -0,0 +1,205 @@
+//============================================================================
+// MCKL/example/smp/include/smp_backend_std.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_SMP_BACKEND_STD_HPP
+#define MCKL_EXAMPLE_SMP_BACKEND_STD_HPP
+
+#define MCKL_NO_RUNTIME_ASSERT 0
+#define MCKL_RUNTIME_ASSERT_AS_EXCEPTION 1
+
+#include <mckl/smp/backend_std.hpp>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+// Each index is passed to work exactly once
+inline bool smp_backend_std_coverage(std::size_t N, std::size_t grainsize)
+{
+    mckl::Vector<std::atomic<int>> count(N);
+    for (auto &c : count)
+        c = 0;
+    mckl::BackendSTD::instance().run(
+        N, grainsize, [&](std::size_t ibegin, std::size_t iend) {
+            for (std::size_t i = ibegin; i != iend; ++i)
+                ++count[i];
+        });
+
+    for (auto &c : count)
+        if (c != 1)
+            return false;
+
+    return true;
+}
+
+// A nested run is executed by the calling worker
+inline bool smp_backend_std_nested(std::size_t N)
+{
+    const std::size_t M = 10;
+    mckl::Vector<std::atomic<int>> count(N * M);
+    for (auto &c : count)
+        c = 0;
+    mckl::BackendSTD::instance().run(
+        N, 1, [&](std::size_t ibegin, std::size_t iend) {
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                mckl::BackendSTD::instance().run(
+                    M, 1, [&](std::size_t jbegin, std::size_t jend) {
+                        for (std::size_t j = jbegin; j != jend; ++j)
+                            ++count[i * M + j];
+                    });
+            }
+        });
+
+    for (auto &c : count)
+        if (c != 1)
+            return false;
+
+    return true;
+}
+
+// The first exception is rethrown and the pool remains usable
+inline bool smp_backend_std_exception(std::size_t N)
+{
+    bool thrown = false;
+    try {
+        mckl::BackendSTD::instance().run(
+            N, 1, [N](std::size_t ibegin, std::size_t iend) {
+                if (ibegin <= N / 2 && N / 2 < iend)
+                    throw std::runtime_error("smp_backend_std_exception");
+            });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+
+    return thrown && smp_backend_std_coverage(N, 1);
+}
+
+// Reconfiguring the pool from within run is refused instead of deadlocking
+inline bool smp_backend_std_reconfigure(std::size_t N, unsigned np)
+{
+    std::atomic<int> refused(0);
+    try {
+        mckl::BackendSTD::instance().run(
+            N, 1, [&](std::size_t, std::size_t) {
+                try {
+                    mckl::BackendSTD::instance().np(np + 1);
+                } catch (const mckl::RuntimeAssert &) {
+                    ++refused;
+                }
+                try {
+                    mckl::BackendSTD::instance().affinity(true);
+                } catch (const mckl::RuntimeAssert &) {
+                    ++refused;
+                }
+            });
+    } catch (...) {
+        return false;
+    }
+
+    bool pass = refused > 0 && refused % 2 == 0;
+    pass = pass && mckl::BackendSTD::instance().np() == np;
+    pass = pass && !mckl::BackendSTD::instance().affinity();
+
+    return pass && smp_backend_std_coverage(N, 1);
+}
+
+// The affinity of the calling thread is the same before and after run
+inline bool smp_backend_std_affinity(std::size_t N)
+{
+    mckl::BackendSTD &backend = mckl::BackendSTD::instance();
+    backend.affinity(true);
+#if MCKL_HAS_THREAD_AFFINITY
+    ::cpu_set_t before;
+    ::cpu_set_t after;
+    CPU_ZERO(&before);
+    CPU_ZERO(&after);
+    ::pthread_getaffinity_np(::pthread_self(), sizeof(before), &before);
+    bool pass = smp_backend_std_coverage(N, 1);
+    ::pthread_getaffinity_np(::pthread_self(), sizeof(after), &after);
+    pass = pass && CPU_EQUAL(&before, &after);
+#else
+    bool pass = smp_backend_std_coverage(N, 1);
+#endif
+    backend.affinity(false);
+
+    return pass;
+}
+
+inline void smp_backend_std(std::size_t N, unsigned np)
+{
+    mckl::BackendSTD &backend = mckl::BackendSTD::instance();
+    backend.np(np);
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(60) << std::left << "Number of workers"
+              << std::setw(20) << std::right << backend.np() << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    bool pass = true;
+    for (std::size_t n : {std::size_t(1), std::size_t(7), N})
+        for (std::size_t g : {std::size_t(1), std::size_t(10), n})
+            pass = pass && smp_backend_std_coverage(n, g);
+    std::cout << std::setw(60) << std::left << "Coverage";
+    std::cout << std::setw(20) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass1 = smp_backend_std_nested(N / 100);
+    std::cout << std::setw(60) << std::left << "Nested run";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 = smp_backend_std_exception(N);
+    std::cout << std::setw(60) << std::left << "Exception";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 = smp_backend_std_reconfigure(N, np);
+    std::cout << std::setw(60) << std::left << "Reconfiguration within run";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    const bool pass4 = smp_backend_std_affinity(N);
+    std::cout << std::setw(60) << std::left << "Caller affinity restored";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    backend.np(1);
+    const bool pass5 = smp_backend_std_coverage(N, 1);
+    std::cout << std::setw(60) << std::left << "Single worker";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    backend.np(np);
+    const bool pass6 = smp_backend_std_coverage(N, 1);
+    std::cout << std::setw(60) << std::left << "Restarted workers";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_SMP_BACKEND_STD_HPP
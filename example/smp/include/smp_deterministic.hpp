@@ -0,0 +1,276 @@
+//============================================================================
+// MCKL/example/smp/include/smp_deterministic.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_SMP_DETERMINISTIC_HPP
+#define MCKL_EXAMPLE_SMP_DETERMINISTIC_HPP
+
+#define MCKL_NO_RUNTIME_ASSERT 0
+#define MCKL_RUNTIME_ASSERT_AS_EXCEPTION 1
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/smp/backend_seq.hpp>
+#include <mckl/smp/backend_std.hpp>
+#if MCKL_USE_OMP
+#include <mckl/smp/backend_omp.hpp>
+#endif
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng_set.hpp>
+#include <iomanip>
+#include <iostream>
+
+template <typename RNGSetType>
+class SMPDeterministicState : public mckl::StateMatrix<mckl::RowMajor, double>
+{
+  public:
+    using rng_set_type = RNGSetType;
+
+    SMPDeterministicState(std::size_t N, std::size_t dim)
+        : mckl::StateMatrix<mckl::RowMajor, double>(N, dim)
+    {
+    }
+}; // class SMPDeterministicState
+
+// A random walk step weighted by a Gaussian likelihood, using only the RNG of
+// the first particle of each range
+template <typename T, typename Backend>
+class SMPDeterministicMutation
+    : public mckl::SMCSamplerEvalSMP<T, SMPDeterministicMutation<T, Backend>,
+          Backend>
+{
+  public:
+    SMPDeterministicMutation(std::size_t grainsize) : grainsize_(grainsize) {}
+
+    void operator()(std::size_t iter, mckl::Particle<T> &particle)
+    {
+        this->run(iter, particle, grainsize_);
+    }
+
+    void eval_first(std::size_t, mckl::Particle<T> &particle)
+    {
+        w_.resize(particle.size());
+    }
+
+    void eval_last(std::size_t, mckl::Particle<T> &particle)
+    {
+        particle.weight().add_log(w_.data());
+    }
+
+    void eval_range(std::size_t, const mckl::ParticleRange<T> &range)
+    {
+        auto &rng = range.begin().rng();
+        const std::size_t n = range.size();
+        const std::size_t d = range.particle().state().dim();
+        double *const x = range.particle().state().row_data(range.ibegin());
+        double *const w = w_.data() + range.ibegin();
+
+        mckl::Vector<double> z(n * d);
+        mckl::NormalDistribution<double> normal(0, 0.5);
+        mckl::rand(rng, normal, n * d, z.data());
+        for (std::size_t i = 0; i != n; ++i) {
+            w[i] = 0;
+            for (std::size_t j = 0; j != d; ++j) {
+                x[i * d + j] += z[i * d + j];
+                w[i] -= 0.5 * x[i * d + j] * x[i * d + j];
+            }
+        }
+    }
+
+  private:
+    std::size_t grainsize_;
+    mckl::Vector<double> w_;
+}; // class SMPDeterministicMutation
+
+template <typename T, typename Backend>
+class SMPDeterministicEstimator
+    : public mckl::SMCEstimatorEvalSMP<T,
+          SMPDeterministicEstimator<T, Backend>, Backend>
+{
+  public:
+    SMPDeterministicEstimator(std::size_t grainsize) : grainsize_(grainsize)
+    {
+    }
+
+    void operator()(std::size_t iter, std::size_t dim,
+        mckl::Particle<T> &particle, double *r)
+    {
+        this->run(iter, dim, particle, r, grainsize_);
+    }
+
+    void eval_range(std::size_t, std::size_t dim,
+        const mckl::ParticleRange<T> &range, double *r)
+    {
+        const double *x = range.particle().state().row_data(range.ibegin());
+        std::copy_n(x, range.size() * dim, r);
+    }
+
+  private:
+    std::size_t grainsize_;
+}; // class SMPDeterministicEstimator
+
+// Run n iterations of an SMC sampler from a copy of a particle system
+template <typename T, typename Backend>
+inline mckl::SMCSampler<T> smp_deterministic_run(
+    const mckl::Particle<T> &particle, std::size_t n, std::size_t grainsize)
+{
+    const std::size_t N = particle.size();
+    const std::size_t dim = particle.state().dim();
+
+    mckl::SMCSampler<T> sampler(N, dim);
+    sampler.particle() = particle;
+    sampler.resample_threshold(0.5);
+    sampler.resample(mckl::Stratified);
+    sampler.mutation(SMPDeterministicMutation<T, Backend>(grainsize));
+    sampler.mutation_estimator(typename mckl::SMCSampler<T>::estimator_type(
+        dim, SMPDeterministicEstimator<T, Backend>(grainsize)));
+    sampler.iterate(n);
+
+    return sampler;
+}
+
+template <typename T>
+inline bool smp_deterministic_equal(
+    const mckl::SMCSampler<T> &s1, const mckl::SMCSampler<T> &s2)
+{
+    const auto &p1 = s1.particle();
+    const auto &p2 = s2.particle();
+    const std::size_t N = p1.size();
+
+    bool pass = s1.num_iter() == s2.num_iter();
+    pass = pass &&
+        std::equal(p1.state().data(),
+            p1.state().data() + N * p1.state().dim(), p2.state().data());
+    pass = pass &&
+        std::equal(p1.weight().data(), p1.weight().data() + N,
+            p2.weight().data());
+
+    const auto &e1 = s1.mutation_estimator(0);
+    const auto &e2 = s2.mutation_estimator(0);
+    pass = pass && e1.num_iter() == e2.num_iter();
+    pass = pass &&
+        std::equal(e1.data(), e1.data() + e1.num_iter() * e1.dim(),
+            e2.data());
+
+    return pass;
+}
+
+// The results of the parallel backends are identical to those of the
+// sequential backend, for any number of threads and grain size
+template <typename RNGSetType>
+inline bool smp_deterministic(
+    std::size_t N, std::size_t dim, std::size_t n, std::size_t block)
+{
+    using T = SMPDeterministicState<RNGSetType>;
+
+    mckl::smp_deterministic_block(block);
+
+    mckl::Particle<T> particle(N, dim);
+    std::fill_n(particle.state().data(), N * dim, 0.0);
+
+    const auto seq =
+        smp_deterministic_run<T, mckl::BackendSEQ>(particle, n, 1);
+
+    const unsigned nps[] = {1, 2, 4};
+    const std::size_t grainsizes[] = {1, 100};
+    bool pass = true;
+    for (auto np : nps) {
+        mckl::BackendSTD::instance().np(np);
+        for (auto grainsize : grainsizes) {
+            pass = pass &&
+                smp_deterministic_equal(seq,
+                    smp_deterministic_run<T, mckl::BackendSTD>(
+                        particle, n, grainsize));
+        }
+#if MCKL_USE_OMP
+        ::omp_set_num_threads(static_cast<int>(np));
+        for (auto grainsize : grainsizes) {
+            pass = pass &&
+                smp_deterministic_equal(seq,
+                    smp_deterministic_run<T, mckl::BackendOMP>(
+                        particle, n, grainsize));
+        }
+#endif
+    }
+
+    mckl::smp_deterministic_block(0);
+
+    return pass;
+}
+
+// The deterministic mode refuses an RNG set smaller than the particle system
+inline bool smp_deterministic_scalar(std::size_t N, std::size_t dim)
+{
+    using T = SMPDeterministicState<mckl::RNGSetScalar<>>;
+
+    mckl::smp_deterministic_block(7);
+
+    mckl::Particle<T> particle(N, dim);
+    SMPDeterministicMutation<T, mckl::BackendSTD> mutation(1);
+    bool thrown = false;
+    try {
+        mutation(0, particle);
+    } catch (const mckl::RuntimeAssert &) {
+        thrown = true;
+    }
+
+    mckl::smp_deterministic_block(0);
+
+    return thrown;
+}
+
+inline void smp_deterministic(std::size_t N, std::size_t dim, std::size_t n)
+{
+    const std::size_t blocks[] = {1, 7, 64, N};
+
+    std::cout << std::string(80, '=') << std::endl;
+    for (auto block : blocks) {
+        const std::string b(" block " + std::to_string(block));
+        const bool pass1 =
+            smp_deterministic<mckl::RNGSetVector<>>(N, dim, n, block);
+        std::cout << std::setw(60) << std::left << "RNGSetVector" + b;
+        std::cout << std::setw(20) << std::right
+                  << (pass1 ? "Passed" : "Failed");
+        std::cout << std::endl;
+        const bool pass2 =
+            smp_deterministic<mckl::RNGSetCounter<>>(N, dim, n, block);
+        std::cout << std::setw(60) << std::left << "RNGSetCounter" + b;
+        std::cout << std::setw(20) << std::right
+                  << (pass2 ? "Passed" : "Failed");
+        std::cout << std::endl;
+    }
+    const bool pass3 = smp_deterministic_scalar(N, dim);
+    std::cout << std::setw(60) << std::left << "RNGSetScalar";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_SMP_DETERMINISTIC_HPP
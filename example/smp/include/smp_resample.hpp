@@ -0,0 +1,136 @@
+//============================================================================
+// MCKL/example/smp/include/smp_resample.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_SMP_RESAMPLE_HPP
+#define MCKL_EXAMPLE_SMP_RESAMPLE_HPP
+
+#include <mckl/smp/backend_seq.hpp>
+#include <mckl/smp/backend_std.hpp>
+#if MCKL_USE_OMP
+#include <mckl/smp/backend_omp.hpp>
+#endif
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/rng_set.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <iomanip>
+#include <iostream>
+
+// One RNG per particle, such that the results do not depend on the number
+// of threads
+template <mckl::MatrixLayout Layout>
+class SMPResampleState : public mckl::StateMatrix<Layout, double>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    SMPResampleState(std::size_t N, std::size_t dim)
+        : mckl::StateMatrix<Layout, double>(N, dim)
+    {
+    }
+}; // class SMPResampleState
+
+// Parallel resampling gives the same states and weights as the sequential
+// backend for every scheme and grain size
+template <template <typename> class ResampleEval,
+    mckl::MatrixLayout Layout>
+inline bool smp_resample(std::size_t N, std::size_t dim)
+{
+    using T = SMPResampleState<Layout>;
+
+    const mckl::ResampleScheme schemes[] = {mckl::Multinomial,
+        mckl::Stratified, mckl::Systematic, mckl::Residual,
+        mckl::ResidualStratified, mckl::ResidualSystematic};
+    const std::size_t grainsizes[] = {1, 7, 64, 4096};
+
+    mckl::RNG rng;
+    mckl::U01Distribution<double> u01;
+    mckl::Vector<double> w(N);
+
+    bool pass = true;
+    for (auto scheme : schemes) {
+        for (auto grainsize : grainsizes) {
+            mckl::Particle<T> particle(N, dim);
+            mckl::rand(rng, u01, N * dim, particle.state().data());
+            mckl::rand(rng, u01, N, w.data());
+            particle.weight().set(w.data());
+            mckl::Particle<T> serial(particle);
+
+            ResampleEval<T> eval(scheme, grainsize);
+            mckl::ResampleEvalSEQ<T> eval_seq(scheme, grainsize);
+            for (std::size_t k = 0; k != 3; ++k) {
+                eval(k, particle);
+                eval_seq(k, serial);
+                pass = pass &&
+                    std::equal(particle.state().begin(),
+                        particle.state().end(), serial.state().begin());
+                pass = pass &&
+                    std::equal(particle.weight().data(),
+                        particle.weight().data() + N,
+                        serial.weight().data());
+            }
+        }
+    }
+
+    return pass;
+}
+
+inline void smp_resample(std::size_t N, std::size_t dim)
+{
+    // More threads than processors if need be
+    mckl::BackendSTD::instance().np(4);
+
+    std::cout << std::string(80, '=') << std::endl;
+    const bool pass1 =
+        smp_resample<mckl::ResampleEvalSTD, mckl::RowMajor>(N, dim);
+    std::cout << std::setw(60) << std::left << "ResampleEvalSTD RowMajor";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 =
+        smp_resample<mckl::ResampleEvalSTD, mckl::ColMajor>(N, dim);
+    std::cout << std::setw(60) << std::left << "ResampleEvalSTD ColMajor";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+#if MCKL_USE_OMP
+    const bool pass3 =
+        smp_resample<mckl::ResampleEvalOMP, mckl::RowMajor>(N, dim);
+    std::cout << std::setw(60) << std::left << "ResampleEvalOMP RowMajor";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 =
+        smp_resample<mckl::ResampleEvalOMP, mckl::ColMajor>(N, dim);
+    std::cout << std::setw(60) << std::left << "ResampleEvalOMP ColMajor";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+#endif
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_SMP_RESAMPLE_HPP
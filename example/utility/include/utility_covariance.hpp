@@ -0,0 +1,261 @@
+//============================================================================
+// MCKL/example/utility/include/utility_covariance.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
+#define MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
+
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_real_distribution.hpp>
+#include <mckl/utility/covariance.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+template <typename RealType>
+inline bool utility_covariance_equal(
+    std::size_t n, const RealType *x, const RealType *y)
+{
+    const RealType tol = sizeof(RealType) == sizeof(float) ? 1e-3 : 1e-9;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (std::abs(x[i] - y[i]) > tol * (1 + std::abs(y[i])))
+            return false;
+    }
+
+    return true;
+}
+
+// Correlated samples with a non-zero mean, in row major order, and weights,
+// some of which are zero
+template <typename RealType>
+inline void utility_covariance_sample(std::size_t n, std::size_t p,
+    mckl::Vector<RealType> &x, mckl::Vector<RealType> &w)
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<RealType> normal(0, 1);
+    mckl::UniformRealDistribution<RealType> runif(0, 1);
+    x.resize(n * p);
+    w.resize(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        RealType s = 0;
+        for (std::size_t j = 0; j != p; ++j) {
+            s += normal(rng);
+            x[i * p + j] = s + static_cast<RealType>(j + 1);
+        }
+        w[i] = i % 7 == 0 ? 0 : runif(rng);
+    }
+}
+
+template <typename RealType>
+inline mckl::Vector<RealType> utility_covariance_transpose(
+    std::size_t n, std::size_t p, const mckl::Vector<RealType> &x)
+{
+    mckl::Vector<RealType> y(n * p);
+    for (std::size_t i = 0; i != n; ++i) {
+        for (std::size_t j = 0; j != p; ++j) {
+            y[j * n + i] = x[i * p + j];
+        }
+    }
+
+    return y;
+}
+
+// Compare the results of OnlineCovariance with those of Covariance
+template <typename RealType>
+inline bool utility_covariance_check(std::size_t n, std::size_t p,
+    const RealType *x, const RealType *w,
+    const mckl::OnlineCovariance<RealType> &online)
+{
+    mckl::Covariance<RealType> covariance;
+    mckl::Vector<RealType> m1(p);
+    mckl::Vector<RealType> m2(p);
+    mckl::Vector<RealType> c1(p * p);
+    mckl::Vector<RealType> c2(p * p);
+    bool pass = online.dim() == p && online.size() == n;
+
+    covariance(mckl::RowMajor, n, p, x, w, m1.data(), c1.data());
+    online(m2.data(), c2.data());
+    pass = pass && utility_covariance_equal(p, m2.data(), m1.data());
+    pass = pass && utility_covariance_equal(p * p, c2.data(), c1.data());
+
+    const mckl::MatrixLayout layouts[] = {mckl::RowMajor, mckl::ColMajor};
+    for (auto layout : layouts) {
+        for (int upper = 0; upper != 2; ++upper) {
+            std::fill(c1.begin(), c1.end(), 0);
+            std::fill(c2.begin(), c2.end(), 0);
+            covariance(mckl::RowMajor, n, p, x, w, nullptr, c1.data(), layout,
+                upper != 0, true);
+            online(nullptr, c2.data(), layout, upper != 0, true);
+            pass = pass &&
+                utility_covariance_equal(
+                    p * (p + 1) / 2, c2.data(), c1.data());
+        }
+    }
+
+    return pass;
+}
+
+template <typename RealType>
+inline bool utility_covariance_chunk(
+    std::size_t n, std::size_t p, mckl::MatrixLayout layout, bool weighted)
+{
+    mckl::Vector<RealType> x;
+    mckl::Vector<RealType> w;
+    utility_covariance_sample(n, p, x, w);
+    const RealType *const wptr = weighted ? w.data() : nullptr;
+
+    mckl::OnlineCovariance<RealType> online(p);
+    if (layout == mckl::RowMajor) {
+        online.add(layout, n, x.data(), wptr);
+    } else {
+        auto y = utility_covariance_transpose(n, p, x);
+        online.add(layout, n, y.data(), wptr);
+    }
+
+    return utility_covariance_check(n, p, x.data(), wptr, online);
+}
+
+template <typename RealType>
+inline bool utility_covariance_single(std::size_t n, std::size_t p)
+{
+    mckl::Vector<RealType> x;
+    mckl::Vector<RealType> w;
+    utility_covariance_sample(n, p, x, w);
+
+    mckl::OnlineCovariance<RealType> online(p);
+    for (std::size_t i = 0; i != n; ++i)
+        online.add(x.data() + i * p, w[i]);
+
+    return utility_covariance_check(n, p, x.data(), w.data(), online);
+}
+
+// Split the samples into chunks of different sizes added to separate
+// accumulators, one of them left empty, and merge them
+template <typename RealType>
+inline bool utility_covariance_merge(std::size_t n, std::size_t p)
+{
+    mckl::Vector<RealType> x;
+    mckl::Vector<RealType> w;
+    utility_covariance_sample(n, p, x, w);
+
+    const std::size_t k = 4;
+    const std::size_t b[k + 1] = {0, 0, n / 5, n / 5 + 1, n};
+    mckl::OnlineCovariance<RealType> online(p);
+    for (std::size_t i = 0; i != k; ++i) {
+        mckl::OnlineCovariance<RealType> partial(p);
+        if (i % 2 == 0) {
+            partial.add(mckl::RowMajor, b[i + 1] - b[i], x.data() + b[i] * p,
+                w.data() + b[i]);
+        } else {
+            for (std::size_t j = b[i]; j != b[i + 1]; ++j)
+                partial.add(x.data() + j * p, w[j]);
+        }
+        online.merge(partial);
+    }
+
+    return utility_covariance_check(n, p, x.data(), w.data(), online);
+}
+
+template <typename RealType>
+inline bool utility_covariance_clear(std::size_t n, std::size_t p)
+{
+    mckl::Vector<RealType> x;
+    mckl::Vector<RealType> w;
+    utility_covariance_sample(n, p, x, w);
+
+    mckl::OnlineCovariance<RealType> online(p + 1);
+    online.add(x.data(), 1);
+    online.reset(p);
+    online.add(mckl::RowMajor, n, x.data(), w.data());
+    bool pass = utility_covariance_check(n, p, x.data(), w.data(), online);
+
+    online.clear();
+    pass = pass && online.size() == 0 && online.sum_weight() == 0;
+    online.add(mckl::RowMajor, n, x.data(), w.data());
+    pass = pass && utility_covariance_check(n, p, x.data(), w.data(), online);
+
+    return pass;
+}
+
+template <typename RealType>
+inline void utility_covariance(
+    std::size_t n, std::size_t p, const std::string &name)
+{
+    const bool pass1 =
+        utility_covariance_chunk<RealType>(n, p, mckl::RowMajor, false);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> RowMajor";
+    std::cout << std::setw(20) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass2 =
+        utility_covariance_chunk<RealType>(n, p, mckl::ColMajor, false);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> ColMajor";
+    std::cout << std::setw(20) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass3 =
+        utility_covariance_chunk<RealType>(n, p, mckl::RowMajor, true);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> RowMajor weighted";
+    std::cout << std::setw(20) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass4 =
+        utility_covariance_chunk<RealType>(n, p, mckl::ColMajor, true);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> ColMajor weighted";
+    std::cout << std::setw(20) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass5 = utility_covariance_single<RealType>(n, p);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> single";
+    std::cout << std::setw(20) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass6 = utility_covariance_merge<RealType>(n, p);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> merge";
+    std::cout << std::setw(20) << std::right << (pass6 ? "Passed" : "Failed");
+    std::cout << std::endl;
+    const bool pass7 = utility_covariance_clear<RealType>(n, p);
+    std::cout << std::setw(60) << std::left
+              << "OnlineCovariance<" + name + "> clear";
+    std::cout << std::setw(20) << std::right << (pass7 ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+inline void utility_covariance(std::size_t n, std::size_t p)
+{
+    std::cout << std::string(80, '=') << std::endl;
+    utility_covariance<float>(n, p, "float");
+    utility_covariance<double>(n, p, "double");
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
@@ -34,6 +34,7 @@
 
 #include <mckl/internal/config.h>
 #include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/mh.hpp>
 #include <mckl/algorithm/pmcmc.hpp>
 #include <mckl/algorithm/resample.hpp>
 #include <mckl/algorithm/smc.hpp>
@@ -36,6 +36,7 @@
 #include <mckl/core/estimator.hpp>
 #include <mckl/core/sampler.hpp>
 #include <mckl/random/rng.hpp>
+#include <mckl/random/rng_set.hpp>
 
 namespace mckl {
 
@@ -113,6 +114,7 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
         Sampler<MCMCSampler<T, U>>::clear();
         iter_ = 0;
         accept_history_.clear();
+        accept_count_.clear();
     }
 
     /// \brief Add a new evaluation object for the mutation step
@@ -172,6 +174,12 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
             accept_history_[i].begin(), accept_history_[i].end(), first);
     }
 
+    /// \brief The total accept count of a mutation step
+    std::size_t accept_count(std::size_t i) const
+    {
+        return i < accept_count_.size() ? accept_count_[i] : 0;
+    }
+
     /// \brief Read all accept count history into a matrix
     template <typename OutputIter>
     OutputIter read_accept_history(MatrixLayout layout, OutputIter first) const
@@ -199,12 +207,16 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
     state_type state_;
     std::size_t iter_;
     Vector<Vector<std::size_t>> accept_history_;
+    Vector<std::size_t> accept_count_;
 
     void do_iterate()
     {
         accept_history_.resize(this->eval(0).size());
+        accept_count_.resize(this->eval(0).size(), 0);
         for (std::size_t i = 0; i != this->eval(0).size(); ++i) {
-            accept_history_[i].push_back(this->eval(0)[i](iter_, state_));
+            const std::size_t a = this->eval(0)[i](iter_, state_);
+            accept_history_[i].push_back(a);
+            accept_count_[i] += a;
         }
 
         for (auto &e : Sampler<MCMCSampler<T, U>>::estimator(0)) {
@@ -215,6 +227,284 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
     }
 }; // class MCMCSampler
 
+/// \brief Independent MCMC chains run concurrently
+/// \ingroup MCMC
+///
+/// \details
+/// Each chain is an MCMCSampler with its own RNG engine. The engines share a
+/// key from the seed generator, and the counter of the `k`-th one starts at
+/// the `k`-th stream of RNGSetCounter. Therefore the chains use disjoint
+/// streams, independent of the seed generator state when they are used,
+/// each of which contains \f$2^{32}\f$ counter blocks. The chains are
+/// iterated by `run(n, work)`, which shall call `work(ibegin, iend)` on
+/// disjoint subranges covering `[0, n)`, possibly in parallel, such as
+/// `RunSMP<Backend>()`. By default, they are iterated by the calling
+/// thread.
+///
+/// The summary statistics of a monitored function of the states are updated
+/// after each iteration of each chain, without storing the chains. They are
+/// the mean, the potential scale reduction factor (R-hat) of Gelman and
+/// Rubin, and the effective sample size, estimated by non-overlapping batch
+/// means within each chain and summed over the chains.
+template <typename T, typename U = double, typename RNGType = RNG>
+class MCMCChains
+{
+  public:
+    using state_type = T;
+    using sampler_type = MCMCSampler<T, U>;
+    using rng_type = RNGType;
+    using monitor_type =
+        std::function<void(std::size_t, std::size_t, T &, double *)>;
+    using run_type = BlockRun;
+
+    /// \brief Construct `K` chains
+    ///
+    /// \details
+    /// All arguments after `K` are passed to the constructor of each
+    /// MCMCSampler
+    template <typename... Args>
+    explicit MCMCChains(std::size_t K, Args &&... args)
+        : rng_set_(K), dim_(0), batch_(0)
+    {
+        chains_.reserve(K);
+        rng_.reserve(K);
+        for (std::size_t k = 0; k != K; ++k) {
+            chains_.push_back(sampler_type(args...));
+            rng_.push_back(rng_set_[k]);
+        }
+        stats_.resize(K);
+    }
+
+    MCMCChains(const MCMCChains<T, U, RNGType> &) = delete;
+
+    MCMCChains<T, U, RNGType> &operator=(
+        const MCMCChains<T, U, RNGType> &) = delete;
+
+    /// \brief The number of chains
+    std::size_t size() const { return chains_.size(); }
+
+    /// \brief The `k`-th chain
+    sampler_type &chain(std::size_t k) { return chains_.at(k); }
+
+    /// \brief The `k`-th chain
+    const sampler_type &chain(std::size_t k) const { return chains_.at(k); }
+
+    /// \brief The RNG engine of the `k`-th chain
+    rng_type &rng(std::size_t k) { return rng_.at(k); }
+
+    /// \brief Add a new evaluation object to the mutation step of each chain
+    ///
+    /// \details
+    /// `make(k, rng)` shall return the evaluation object of the `k`-th chain,
+    /// which may keep a reference to the RNG engine `rng` of the chain.
+    template <typename Make>
+    std::size_t mutation(Make &&make)
+    {
+        std::size_t r = 0;
+        for (std::size_t k = 0; k != size(); ++k) {
+            r = chains_[k].mutation(make(k, rng_[k]));
+        }
+
+        return r;
+    }
+
+    /// \brief Set the loop over the chains
+    void run(run_type run) { run_ = std::move(run); }
+
+    /// \brief Monitor a `dim` dimensional function of the states
+    ///
+    /// \details
+    /// `eval(iter, dim, state, r)` shall write the values to `r`. The batch
+    /// size `batch` of the effective sample size should be large enough
+    /// such that batch means are nearly uncorrelated. The statistics are
+    /// cleared.
+    void monitor(std::size_t dim, monitor_type eval, std::size_t batch = 100)
+    {
+        dim_ = dim;
+        batch_ = std::max(batch, std::size_t(1));
+        monitor_ = std::move(eval);
+        clear_monitor();
+    }
+
+    /// \brief Clear the monitored statistics, for example after burn-in
+    void clear_monitor()
+    {
+        for (auto &s : stats_) {
+            s.n = 0;
+            s.nb = 0;
+            s.v.resize(dim_ * 6);
+            std::fill(s.v.begin(), s.v.end(), 0.0);
+        }
+    }
+
+    /// \brief Iterate all chains
+    void iterate(std::size_t n = 1)
+    {
+        auto work = [this, n](std::size_t kbegin, std::size_t kend) {
+            for (std::size_t k = kbegin; k != kend; ++k) {
+                iterate_chain(k, n);
+            }
+        };
+        if (run_) {
+            run_(size(), work);
+        } else {
+            work(0, size());
+        }
+    }
+
+    /// \brief The acceptance rate of a mutation step pooled over all chains
+    double accept_rate(std::size_t i) const
+    {
+        std::size_t a = 0;
+        std::size_t n = 0;
+        for (const auto &c : chains_) {
+            a += c.accept_count(i);
+            n += c.num_iter();
+        }
+
+        return n == 0 ? 0.0 : static_cast<double>(a) / n;
+    }
+
+    /// \brief The number of monitored iterations of each chain
+    std::size_t num_monitor() const
+    {
+        return stats_.empty() ? 0 : stats_.front().n;
+    }
+
+    /// \brief The pooled mean of the monitored function
+    template <typename OutputIter>
+    OutputIter mean(OutputIter first) const
+    {
+        for (std::size_t j = 0; j != dim_; ++j) {
+            double m = 0;
+            for (const auto &s : stats_) {
+                m += s.v[j];
+            }
+            *first++ = m / size();
+        }
+
+        return first;
+    }
+
+    /// \brief The potential scale reduction factor of each component of the
+    /// monitored function
+    ///
+    /// \details
+    /// It requires at least two chains of at least two monitored iterations,
+    /// otherwise NaN is returned.
+    template <typename OutputIter>
+    OutputIter rhat(OutputIter first) const
+    {
+        const std::size_t K = size();
+        const std::size_t n = num_monitor();
+        for (std::size_t j = 0; j != dim_; ++j) {
+            if (K < 2 || n < 2) {
+                *first++ = const_nan<double>();
+                continue;
+            }
+            double m = 0;
+            double w = 0;
+            for (const auto &s : stats_) {
+                m += s.v[j];
+                w += s.v[dim_ + j] / (n - 1);
+            }
+            m /= K;
+            w /= K;
+            double b = 0;
+            for (const auto &s : stats_) {
+                b += (s.v[j] - m) * (s.v[j] - m);
+            }
+            b /= K - 1;
+            const double v = (n - 1.0) / n * w + b;
+            *first++ = std::sqrt(v / w);
+        }
+
+        return first;
+    }
+
+    /// \brief The effective sample size of each component of the monitored
+    /// function, summed over all chains
+    ///
+    /// \details
+    /// Chains with fewer than two complete batches are skipped.
+    template <typename OutputIter>
+    OutputIter ess(OutputIter first) const
+    {
+        for (std::size_t j = 0; j != dim_; ++j) {
+            double e = 0;
+            for (const auto &s : stats_) {
+                if (s.nb < 2) {
+                    continue;
+                }
+                const double var = s.v[dim_ + j] / (s.n - 1);
+                const double bvar = s.v[dim_ * 4 + j] / (s.nb - 1) * batch_;
+                e += bvar > 0 ? s.n * var / bvar : 0;
+            }
+            *first++ = e;
+        }
+
+        return first;
+    }
+
+  private:
+    // v holds the mean, the sum of squares, the current batch sum, the mean
+    // of the batch means, the sum of squares of the batch means, and scratch
+    struct stats_type {
+        std::size_t n;
+        std::size_t nb;
+        Vector<double> v;
+    }; // struct stats_type
+
+    Vector<sampler_type> chains_;
+    RNGSetCounter<rng_type> rng_set_;
+    Vector<rng_type> rng_;
+    std::size_t dim_;
+    std::size_t batch_;
+    monitor_type monitor_;
+    run_type run_;
+    Vector<stats_type> stats_;
+
+    void iterate_chain(std::size_t k, std::size_t n)
+    {
+        sampler_type &chain = chains_[k];
+        stats_type &s = stats_[k];
+        if (n > 1) {
+            chain.reserve(n);
+        }
+        for (std::size_t t = 0; t != n; ++t) {
+            chain.iterate(1);
+            if (!monitor_) {
+                continue;
+            }
+
+            double *const mean = s.v.data();
+            double *const ssq = mean + dim_;
+            double *const bsum = ssq + dim_;
+            double *const bmean = bsum + dim_;
+            double *const bssq = bmean + dim_;
+            double *const x = bssq + dim_;
+            monitor_(chain.num_iter() - 1, dim_, chain.state(), x);
+            ++s.n;
+            add(dim_, x, bsum, bsum);
+            for (std::size_t j = 0; j != dim_; ++j) {
+                const double d = x[j] - mean[j];
+                mean[j] += d / s.n;
+                ssq[j] += d * (x[j] - mean[j]);
+            }
+            if (s.n % batch_ == 0) {
+                ++s.nb;
+                for (std::size_t j = 0; j != dim_; ++j) {
+                    const double y = bsum[j] / batch_;
+                    const double d = y - bmean[j];
+                    bmean[j] += d / s.nb;
+                    bssq[j] += d * (y - bmean[j]);
+                }
+                std::fill_n(bsum, dim_, 0.0);
+            }
+        }
+    }
+}; // class MCMCChains
+
 } // namespace mckl
 
 #endif // MCKL_ALGORITHM_MCMC_HPP
@@ -0,0 +1,532 @@
+//============================================================================
+// MCKL/include/mckl/algorithm/mh.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_ALGORITHM_MH_HPP
+#define MCKL_ALGORITHM_MH_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/core/particle.hpp>
+#include <mckl/core/sampler.hpp>
+#include <mckl/random/normal_mv_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/seed.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/utility/covariance.hpp>
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+
+namespace mckl {
+
+/// \brief Proposal of AdaptiveMH
+/// \ingroup MH
+enum class MHProposal {
+    RandomWalk, ///< Gaussian random walk around the current value
+    Independent ///< Gaussian centered at the mean of the population
+};              // enum MHProposal
+
+/// \brief Adaptive Metropolis-Hastings move
+/// \ingroup MH
+///
+/// \details
+/// The target is given by a vectorized log density, called as
+/// `eval(iter, n, dim, x, r)`, which shall write the log densities, up to a
+/// constant, of the `n` points stored row by row in `x` to `r`.
+///
+/// Used as a mutation evaluation object of SMCSampler, with a state derived
+/// from StateMatrix, the proposal is a Gaussian with the weighted covariance
+/// of the particles (computed by Covariance), multiplied by `scale()^2`.
+/// Particles are moved in cache sized blocks, each of which draws all of its
+/// proposals at once, evaluates their log densities with a single call of
+/// `eval`, and accepts or rejects them together. After the first sweep, the
+/// number of sweeps is chosen such that each particle is moved with
+/// probability at least `1 - miss()`, given the observed acceptance rate,
+/// bounded by `max_repeat()`. The blocks are processed by a BlockRun set by
+/// `run()`, such as `RunSMP<Backend>()`, and by default by the calling
+/// thread. The proposals of each block are drawn from the RNG of the first
+/// particle in the block.
+///
+/// Used as a mutation evaluation object of MCMCSampler, with a state of
+/// contiguous `RealType` values with `data()` and `size()`, it is the
+/// adaptive Metropolis algorithm. The proposal covariance is the running
+/// covariance of the chain (computed by OnlineCovariance), refreshed every
+/// `dim` iterations once the chain is longer than `2 * dim`. Before that, it
+/// is the identity. The independent proposal is centered at the running mean
+/// of the chain, which is the initial value before the first refreshment. The
+/// scale of the random walk proposal is adapted by a Robbins-Monro recursion
+/// towards the acceptance rate `0.234`. The log density of the current state
+/// is evaluated on each call, since other moves may have changed the state or
+/// the target may depend on the iteration. If neither is the case, `cache()`
+/// saves this evaluation by reusing the value of the previous call. It
+/// returns one if the proposal is accepted, and zero otherwise. The proposals
+/// are drawn from `rng()`, which is seeded by Seed unless an engine is given
+/// to the constructor.
+template <typename RealType = double>
+class AdaptiveMH
+{
+    static_assert(internal::is_blas_floating_point<RealType>::value,
+        "**AdaptiveMH** used with RealType other than float or double");
+
+  public:
+    using result_type = RealType;
+    using eval_type = std::function<void(std::size_t, std::size_t,
+        std::size_t, const result_type *, result_type *)>;
+    using run_type = BlockRun;
+    using rng_type = RNG;
+
+    template <typename Eval>
+    AdaptiveMH(std::size_t dim, Eval &&eval,
+        MHProposal proposal = MHProposal::RandomWalk)
+        : AdaptiveMH(dim, std::forward<Eval>(eval),
+              rng_type(Seed<rng_type>::instance().get()), proposal)
+    {
+    }
+
+    template <typename Eval>
+    AdaptiveMH(std::size_t dim, Eval &&eval, const rng_type &rng,
+        MHProposal proposal = MHProposal::RandomWalk)
+        : dim_(dim)
+        , eval_(std::forward<Eval>(eval))
+        , proposal_(proposal)
+        , scale_(proposal == MHProposal::RandomWalk ?
+                  2.38 / std::sqrt(static_cast<double>(dim)) :
+                  1.0)
+        , miss_(0.01)
+        , max_repeat_(100)
+        , num_repeat_(0)
+        , accept_rate_(0)
+        , num_iter_(0)
+        , cache_(false)
+        , rng_(rng)
+    {
+        runtime_assert(dim != 0, "**AdaptiveMH** used with zero dimension");
+    }
+
+    /// \brief The dimension of the target
+    std::size_t dim() const { return dim_; }
+
+    /// \brief Set the loop over the blocks of particles
+    void run(run_type run) { run_ = std::move(run); }
+
+    /// \brief The RNG engine used by the MCMC move
+    rng_type &rng() { return rng_; }
+
+    /// \brief The RNG engine used by the MCMC move
+    const rng_type &rng() const { return rng_; }
+
+    /// \brief The scale of the proposal covariance
+    double scale() const { return scale_; }
+
+    /// \brief Set the scale of the proposal covariance
+    void scale(double s) { scale_ = s; }
+
+    /// \brief The targeted probability that a particle is never moved
+    double miss() const { return miss_; }
+
+    /// \brief Set the targeted probability that a particle is never moved
+    void miss(double p) { miss_ = p; }
+
+    /// \brief The maximum number of sweeps over the particles
+    std::size_t max_repeat() const { return max_repeat_; }
+
+    /// \brief Set the maximum number of sweeps over the particles
+    void max_repeat(std::size_t n)
+    {
+        max_repeat_ = std::max(n, std::size_t(1));
+    }
+
+    /// \brief The number of sweeps over the particles of the last move
+    std::size_t num_repeat() const { return num_repeat_; }
+
+    /// \brief The acceptance rate of the last move, or the running acceptance
+    /// rate of the chain
+    double accept_rate() const { return accept_rate_; }
+
+    /// \brief If the log density of the state of an MCMC sampler is cached
+    bool cache() const { return cache_; }
+
+    /// \brief Set if the log density of the state of an MCMC sampler is
+    /// cached between calls
+    ///
+    /// \details
+    /// This is only valid if the target does not depend on the iteration
+    /// number and the state is not changed except by this object.
+    void cache(bool c) { cache_ = c; }
+
+    /// \brief Move the particles of an SMC sampler, and return the total
+    /// number of accepted proposals
+    template <typename T>
+    std::size_t operator()(std::size_t iter, Particle<T> &particle)
+    {
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        if (N == 0) {
+            return 0;
+        }
+
+        auto &state = particle.state();
+        runtime_assert(static_cast<std::size_t>(state.dim()) == dim_,
+            "**AdaptiveMH** used with a state of a different dimension");
+
+        mean_.resize(dim_);
+        cov_.resize(dim_ * dim_);
+        w_.resize(N);
+        std::copy_n(particle.weight().data(), N, w_.data());
+        Covariance<result_type>()(state.layout(), N, dim_, state.data(),
+            w_.data(), mean_.data(), cov_.data());
+        update_chol();
+
+        const std::size_t k = block_size();
+        const std::size_t nblocks = (N + k - 1) / k;
+        lp_.resize(N);
+        lq_.resize(N);
+        lpy_.resize(N);
+        lqy_.resize(N);
+        u_.resize(N);
+        xs_.resize(N * dim_);
+        ys_.resize(N * dim_);
+        zs_.resize(nblocks * dim_);
+        accept_.resize(nblocks);
+        sweep(iter, particle, nblocks, false);
+
+        std::size_t naccept = 0;
+        num_repeat_ = 0;
+        std::size_t nrepeat = 1;
+        while (num_repeat_ < nrepeat) {
+            sweep(iter, particle, nblocks, true);
+            const std::size_t a =
+                std::accumulate(accept_.begin(), accept_.end(), std::size_t());
+            naccept += a;
+            if (num_repeat_++ == 0) {
+                accept_rate_ = static_cast<double>(a) / N;
+                nrepeat = repeat(accept_rate_);
+            }
+        }
+        accept_rate_ = static_cast<double>(naccept) / (N * num_repeat_);
+
+        return naccept;
+    }
+
+    /// \brief Move the state of an MCMC sampler, and return one if the
+    /// proposal is accepted, zero otherwise
+    template <typename T>
+    std::size_t operator()(std::size_t iter, T &state)
+    {
+        runtime_assert(static_cast<std::size_t>(state.size()) == dim_,
+            "**AdaptiveMH** used with a state of a different dimension");
+
+        result_type *const x = state.data();
+        if (num_iter_ == 0) {
+            chain_.reset(dim_);
+            mean_.resize(dim_);
+            std::copy_n(x, dim_, mean_.data());
+            cov_.resize(dim_ * dim_);
+            chol_.resize(dim_ * dim_);
+            std::fill(chol_.begin(), chol_.end(), 0);
+            for (std::size_t i = 0; i != dim_; ++i) {
+                chol_[i * dim_ + i] = 1;
+            }
+            lp_.resize(1);
+            y_.resize(dim_);
+            z_.resize(dim_);
+        }
+
+        ++num_iter_;
+        chain_.add(x);
+        if (num_iter_ > 2 * dim_ && num_iter_ % dim_ == 0) {
+            chain_(mean_.data(), cov_.data());
+            update_chol();
+        }
+        if (!cache_ || num_iter_ == 1) {
+            eval_(iter, 1, dim_, x, lp_.data());
+        }
+
+        const result_type s = static_cast<result_type>(scale_);
+        result_type *const y = y_.data();
+        normal_distribution(rng_, dim_, y, const_zero<result_type>(),
+            const_one<result_type>());
+        internal::normal_mv_distribution_mulchol(1, y, dim_, chol_.data());
+        if (proposal_ == MHProposal::RandomWalk) {
+            muladd(dim_, y, s, x, y);
+        } else {
+            muladd(dim_, y, s, mean_.data(), y);
+        }
+        result_type lpy = 0;
+        eval_(iter, 1, dim_, y, &lpy);
+        result_type r = lpy - lp_[0];
+        if (proposal_ == MHProposal::Independent) {
+            r += log_proposal(x, z_.data()) - log_proposal(y, z_.data());
+        }
+        result_type u = 0;
+        u01_distribution(rng_, 1, &u);
+        const bool accepted = std::log(u) < r;
+        if (accepted) {
+            std::copy_n(y, dim_, x);
+            lp_[0] = lpy;
+        }
+
+        const double a = accepted ? 1.0 : 0.0;
+        if (proposal_ == MHProposal::RandomWalk) {
+            // Robbins-Monro recursion of the log scale
+            const double gamma =
+                std::pow(static_cast<double>(num_iter_), -0.6);
+            scale_ *= std::exp(gamma * (a - 0.234));
+        }
+        accept_rate_ += (a - accept_rate_) / num_iter_;
+
+        return accepted ? 1 : 0;
+    }
+
+    /// \brief Reset the adaptation of the chain
+    void reset() { num_iter_ = 0; }
+
+  private:
+    std::size_t dim_;
+    eval_type eval_;
+    MHProposal proposal_;
+    double scale_;
+    double miss_;
+    std::size_t max_repeat_;
+    std::size_t num_repeat_;
+    double accept_rate_;
+    std::size_t num_iter_;
+    bool cache_;
+    run_type run_;
+    rng_type rng_;
+    OnlineCovariance<result_type> chain_;
+    Vector<result_type> mean_;
+    Vector<result_type> cov_;
+    Vector<result_type> chol_;
+    Vector<result_type> lp_;
+    Vector<result_type> lq_;
+    Vector<result_type> w_;
+    Vector<result_type> y_;
+    Vector<result_type> z_;
+    Vector<result_type> lpy_;
+    Vector<result_type> lqy_;
+    Vector<result_type> u_;
+    Vector<result_type> xs_;
+    Vector<result_type> ys_;
+    Vector<result_type> zs_;
+    Vector<std::size_t> accept_;
+
+    std::size_t block_size() const
+    {
+        return std::max(std::size_t(1),
+            internal::BufferSize<result_type>::value / dim_);
+    }
+
+    std::size_t repeat(double rate) const
+    {
+        if (rate >= 1) {
+            return 1;
+        }
+        if (rate <= 0) {
+            return max_repeat_;
+        }
+
+        const double r = std::ceil(std::log(miss_) / std::log(1 - rate));
+
+        return r < 1 ? 1 :
+                       static_cast<std::size_t>(
+                           std::min(r, static_cast<double>(max_repeat_)));
+    }
+
+    // Set the full lower triangular Cholesky factor of cov_, or of its
+    // diagonal if it is not positive definite
+    void update_chol()
+    {
+        Vector<result_type> packed(dim_ * (dim_ + 1) / 2);
+        chol_.resize(dim_ * dim_);
+        std::fill(chol_.begin(), chol_.end(), 0);
+        if (cov_chol(dim_, cov_.data(), packed.data()) == 0) {
+            const result_type *l = packed.data();
+            for (std::size_t i = 0; i != dim_; ++i) {
+                for (std::size_t j = 0; j <= i; ++j) {
+                    chol_[i * dim_ + j] = *l++;
+                }
+            }
+        } else {
+            for (std::size_t i = 0; i != dim_; ++i) {
+                const result_type v = cov_[i * dim_ + i];
+                chol_[i * dim_ + i] = v > 0 ? std::sqrt(v) : 1;
+            }
+        }
+    }
+
+    // Log density of the independent proposal, up to a constant, by solving
+    // scale * L * z = x - mean
+    result_type log_proposal(const result_type *x, result_type *z) const
+    {
+        sub(dim_, x, mean_.data(), z);
+        for (std::size_t i = 0; i != dim_; ++i) {
+            const result_type *const li = chol_.data() + i * dim_;
+            for (std::size_t j = 0; j != i; ++j) {
+                z[i] -= li[j] * z[j];
+            }
+            z[i] /= li[i];
+        }
+
+        return -static_cast<result_type>(0.5 / (scale_ * scale_)) * dot(z);
+    }
+
+    result_type dot(const result_type *z) const
+    {
+        result_type s = 0;
+        for (std::size_t i = 0; i != dim_; ++i) {
+            s += z[i] * z[i];
+        }
+
+        return s;
+    }
+
+    template <typename T>
+    void sweep(std::size_t iter, Particle<T> &particle, std::size_t nblocks,
+        bool move)
+    {
+        auto work = [this, iter, &particle, move](
+                        std::size_t bbegin, std::size_t bend) {
+            if (move) {
+                move_blocks(iter, particle, bbegin, bend);
+            } else {
+                init_blocks(iter, particle, bbegin, bend);
+            }
+        };
+        if (run_) {
+            run_(nblocks, work);
+        } else {
+            work(0, nblocks);
+        }
+    }
+
+    template <typename T>
+    void init_blocks(std::size_t iter, Particle<T> &particle,
+        std::size_t bbegin, std::size_t bend)
+    {
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        const std::size_t k = block_size();
+        for (std::size_t b = bbegin; b != bend; ++b) {
+            const std::size_t ibegin = b * k;
+            const std::size_t n = std::min(k, N - ibegin);
+            result_type *const x = xs_.data() + ibegin * dim_;
+            result_type *const z = zs_.data() + b * dim_;
+            gather(particle, ibegin, n, x);
+            eval_(iter, n, dim_, x, lp_.data() + ibegin);
+            if (proposal_ == MHProposal::Independent) {
+                for (std::size_t i = 0; i != n; ++i) {
+                    lq_[ibegin + i] = log_proposal(x + i * dim_, z);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void move_blocks(std::size_t iter, Particle<T> &particle,
+        std::size_t bbegin, std::size_t bend)
+    {
+        using size_type = typename Particle<T>::size_type;
+
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        const std::size_t k = block_size();
+        const result_type s = static_cast<result_type>(scale_);
+        auto &state = particle.state();
+        for (std::size_t b = bbegin; b != bend; ++b) {
+            const std::size_t ibegin = b * k;
+            const std::size_t n = std::min(k, N - ibegin);
+            auto &rng = particle.rng(static_cast<size_type>(ibegin));
+            result_type *const x = xs_.data() + ibegin * dim_;
+            result_type *const y = ys_.data() + ibegin * dim_;
+            result_type *const lpy = lpy_.data() + ibegin;
+            result_type *const lqy = lqy_.data() + ibegin;
+            result_type *const u = u_.data() + ibegin;
+
+            normal_distribution(rng, n * dim_, y, const_zero<result_type>(),
+                const_one<result_type>());
+            if (proposal_ == MHProposal::Independent) {
+                for (std::size_t i = 0; i != n; ++i) {
+                    lqy[i] =
+                        -static_cast<result_type>(0.5) * dot(y + i * dim_);
+                }
+            }
+            internal::normal_mv_distribution_mulchol(n, y, dim_, chol_.data());
+            if (proposal_ == MHProposal::RandomWalk) {
+                gather(particle, ibegin, n, x);
+                muladd(n * dim_, y, s, x, y);
+            } else {
+                for (std::size_t i = 0; i != n; ++i) {
+                    muladd(dim_, y + i * dim_, s, mean_.data(), y + i * dim_);
+                }
+            }
+            eval_(iter, n, dim_, y, lpy);
+            u01_distribution(rng, n, u);
+            log(n, u, u);
+
+            std::size_t a = 0;
+            for (std::size_t i = 0; i != n; ++i) {
+                const std::size_t j = ibegin + i;
+                result_type r = lpy[i] - lp_[j];
+                if (proposal_ == MHProposal::Independent) {
+                    r += lq_[j] - lqy[i];
+                }
+                if (u[i] < r) {
+                    const result_type *const yi = y + i * dim_;
+                    for (std::size_t d = 0; d != dim_; ++d) {
+                        state(static_cast<size_type>(j),
+                            static_cast<size_type>(d)) = yi[d];
+                    }
+                    lp_[j] = lpy[i];
+                    lq_[j] = lqy[i];
+                    ++a;
+                }
+            }
+            accept_[b] = a;
+        }
+    }
+
+    template <typename T>
+    void gather(const Particle<T> &particle, std::size_t ibegin,
+        std::size_t n, result_type *x) const
+    {
+        using size_type = typename Particle<T>::size_type;
+
+        const auto &state = particle.state();
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t d = 0; d != dim_; ++d) {
+                *x++ = state(static_cast<size_type>(ibegin + i),
+                    static_cast<size_type>(d));
+            }
+        }
+    }
+}; // class AdaptiveMH
+
+} // namespace mckl
+
+MCKL_POP_CLANG_WARNING
+
+#endif // MCKL_ALGORITHM_MH_HPP
@@ -34,14 +34,67 @@
 
 #include <mckl/internal/common.hpp>
 #include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/resample.hpp>
 #include <mckl/algorithm/smc.hpp>
 #include <mckl/core/state_matrix.hpp>
+#include <mckl/math/vmf.hpp>
+#include <mckl/random/normal_distribution.hpp>
 #include <mckl/random/rng.hpp>
 
 MCKL_PUSH_CLANG_WARNING("-Wpadded")
 
 namespace mckl {
 
+namespace internal {
+
+// Whether the state has `aux(size, u)` to receive the auxiliary random
+// numbers of the correlated mode
+template <typename T>
+class PMCMCHasAuxImpl
+{
+    class char2
+    {
+        char c1;
+        char c2;
+    };
+
+    template <typename U>
+    static char test(decltype(std::declval<U &>().aux(
+        std::declval<std::size_t>(), std::declval<const double *>())) *);
+
+    template <typename U>
+    static char2 test(...);
+
+  public:
+    static constexpr bool value = sizeof(test<T>(nullptr)) == sizeof(char);
+};
+
+template <typename T>
+class PMCMCHasAux
+    : public std::integral_constant<bool, PMCMCHasAuxImpl<T>::value>
+{
+};
+
+template <typename T>
+inline void pmcmc_aux(
+    T &state, std::size_t size, const double *u, std::true_type)
+{
+    state.aux(size, u);
+}
+
+template <typename T>
+inline void pmcmc_aux(T &, std::size_t, const double *, std::false_type)
+{
+}
+
+template <typename T>
+inline void pmcmc_aux(T &state, std::size_t size, const double *u)
+{
+    pmcmc_aux(state, size, u, PMCMCHasAux<T>());
+}
+
+} // namespace internal
+
 template <typename Param, MatrixLayout Layout, typename T, std::size_t Dim = 0>
 class PMCMCStateMatrix : public StateMatrix<Layout, T, Dim>
 {
@@ -62,11 +115,161 @@ class PMCMCStateMatrix : public StateMatrix<Layout, T, Dim>
         log_nc_ = nc;
     }
 
+    /// \brief The auxiliary standard normal random numbers of the selection
+    /// step of iteration `iter`, or a null pointer if the particle filter is
+    /// not run in the correlated mode
+    ///
+    /// \details
+    /// See PMCMCMutation::correlate. There are `aux_size()` of them.
+    const double *aux(std::size_t iter) const
+    {
+        return aux_ == nullptr ? nullptr :
+                                 aux_ + iter * (aux_size_ + this->size());
+    }
+
+    /// \brief The auxiliary standard normal random numbers of the resampling
+    /// step of iteration `iter`, or a null pointer if the particle filter is
+    /// not run in the correlated mode
+    ///
+    /// \details
+    /// There are `size()` of them. See PMCMCResample.
+    const double *aux_resample(std::size_t iter) const
+    {
+        return aux_ == nullptr ? nullptr : aux(iter) + aux_size_;
+    }
+
+    /// \brief The number of auxiliary random numbers of the selection step
+    /// of each iteration
+    std::size_t aux_size() const { return aux_size_; }
+
+    /// \brief Set the auxiliary random numbers
+    void aux(std::size_t size, const double *u)
+    {
+        aux_size_ = size;
+        aux_ = u;
+    }
+
   private:
     param_type param_;
     double log_nc_;
+    std::size_t aux_size_ = 0;
+    const double *aux_ = nullptr;
 }; // class PMCMCStateMatrix
 
+/// \brief Resampling driven by the auxiliary random numbers of
+/// PMCMCStateMatrix
+/// \ingroup PMCMC
+///
+/// \details
+/// In the correlated mode of PMCMCMutation, the standard uniform random
+/// numbers are the normal CDF of `aux_resample(iter)` of the state, and
+/// otherwise they are generated by the RNG of the particle collection. It
+/// shall be used instead of the built-in schemes of SMCSampler::resample for
+/// the correlated mode. The buffers are reused across calls.
+///
+/// The resampling is a function of the uniform random numbers and the
+/// weights in the order of the particles. For the likelihood estimates of
+/// the current and the proposed parameters to be correlated, particles
+/// close to each other in the state space shall also be close in this
+/// order, which is not the case after a permutation by an earlier
+/// resampling. Therefore the particles are sorted before resampling, by the
+/// state if its dimension is one, or otherwise by `order(iter, particle,
+/// index)`, which shall write a permutation of `[0, N)` to `index`, such as
+/// that of a Hilbert curve through the states. Without an ordering, the
+/// particles of a multivariate state are resampled in their current order,
+/// and the correlation is mostly lost after the first resampling.
+template <typename T, typename U01SeqType = U01SequenceStratified>
+class PMCMCResample
+{
+  public:
+    using size_type = typename Particle<T>::size_type;
+    using order_type =
+        std::function<void(std::size_t, const Particle<T> &, size_type *)>;
+
+    PMCMCResample() = default;
+
+    template <typename Order>
+    explicit PMCMCResample(Order &&order) : order_(std::forward<Order>(order))
+    {
+    }
+
+    /// \brief Set the ordering of the particles before resampling
+    template <typename Order>
+    void order(Order &&order)
+    {
+        order_ = std::forward<Order>(order);
+    }
+
+    void operator()(std::size_t iter, Particle<T> &particle)
+    {
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        u01_.resize(N);
+        rep_.resize(N);
+        idx_.resize(N);
+        perm_.resize(N);
+        w_.resize(N);
+
+        const double *const z = particle.state().aux_resample(iter);
+        if (z == nullptr) {
+            u01seq_(particle.rng(), N, u01_.data());
+        } else {
+            cdfnorm(N, z, u01_.data());
+            u01seq_(N, u01_.data(), u01_.data());
+        }
+
+        const bool sorted = sort(iter, particle);
+        const double *w = particle.weight().data();
+        if (sorted) {
+            for (std::size_t i = 0; i != N; ++i) {
+                w_[i] = w[perm_[i]];
+            }
+            w = w_.data();
+        }
+        resample_trans_u01_rep(N, N, w, u01_.data(), rep_.data());
+        if (sorted) {
+            // Back to the current order, such that the selection is in place
+            for (std::size_t i = 0; i != N; ++i) {
+                idx_[static_cast<std::size_t>(perm_[i])] = rep_[i];
+            }
+            std::swap(rep_, idx_);
+        }
+        resample_trans_rep_index(N, N, rep_.data(), idx_.data());
+        particle.select(particle.size(), idx_.data());
+    }
+
+  private:
+    order_type order_;
+    U01SeqType u01seq_;
+    Vector<double> u01_;
+    Vector<double> w_;
+    Vector<size_type> rep_;
+    Vector<size_type> idx_;
+    Vector<size_type> perm_;
+
+    // Set perm_ to the order of the particles, and return false if they are
+    // resampled in their current order
+    bool sort(std::size_t iter, const Particle<T> &particle)
+    {
+        if (order_) {
+            order_(iter, particle, perm_.data());
+            return true;
+        }
+
+        const auto &state = particle.state();
+        if (state.dim() != 1) {
+            return false;
+        }
+
+        std::iota(perm_.begin(), perm_.end(), size_type(0));
+        std::stable_sort(
+            perm_.begin(), perm_.end(), [&state](size_type i, size_type j) {
+                return state(i, 0) < state(j, 0);
+            });
+
+        return true;
+    }
+}; // class PMCMCResample
+
 /// \brief Particle Markov chain Monte Carlo mutation
 /// \ingroup PMCMC
 template <typename Param, typename T, typename U = double>
@@ -79,11 +282,23 @@ class PMCMCMutation
     using eval_type =
         std::function<double(typename Particle<T>::rng_type &, param_type &)>;
     using prior_type = std::function<double(const param_type &)>;
+    using bound_type =
+        std::function<double(std::size_t, const param_type &)>;
+    using surrogate_type = std::function<double(const param_type &)>;
     using pf_type = SMCSampler<T, U>;
 
     template <typename Prior, typename... Args>
     PMCMCMutation(std::size_t N, std::size_t M, Prior &&prior, Args &&... args)
-        : M_(M), prior_(prior), pf_(N, std::forward<Args>(args)...)
+        : M_(M)
+        , rho_(0)
+        , aux_size_(0)
+        , correlated_(false)
+        , log_surrogate_(0)
+        , surrogate_valid_(false)
+        , num_early_reject_(0)
+        , num_surrogate_reject_(0)
+        , prior_(prior)
+        , pf_(N, std::forward<Args>(args)...)
     {
     }
 
@@ -113,6 +328,83 @@ class PMCMCMutation
         prior_ = std::forward<Prior>(prior);
     }
 
+    /// \brief Enable the correlated pseudo-marginal mode
+    ///
+    /// \details
+    /// All random numbers used by the particle filter are kept as a vector
+    /// \f$u\f$ of standard normal random numbers. For each iteration, they
+    /// are `aux_size` numbers for the selection step, which shall be read
+    /// from `state().aux(iter)` instead of generated, and `N` numbers for the
+    /// resampling step, which are used by PMCMCResample. For each proposal,
+    /// they are perturbed by a Crank-Nicolson step,
+    /// \f$u' = \rho u + \sqrt{1 - \rho^2}\epsilon\f$, and are kept with
+    /// the parameter if the proposal is accepted. With \f$\rho\f$ close to
+    /// one, the estimates of the likelihood of the current and the proposed
+    /// parameters are positively correlated, and much fewer particles are
+    /// needed for the same acceptance rate. The buffers of \f$u\f$ are
+    /// allocated once. The mode is disabled if `rho` is zero. It requires
+    /// the state to have `aux(size, u)`, such as PMCMCStateMatrix. Other
+    /// states can only be used with the mode disabled.
+    void correlate(double rho, std::size_t aux_size)
+    {
+        runtime_assert(rho >= 0 && rho < 1,
+            "**PMCMCMutation::correlate** used with rho not in [0, 1)");
+        runtime_assert(rho == 0 || internal::PMCMCHasAux<T>::value,
+            "**PMCMCMutation::correlate** used with a state without aux");
+
+        rho_ = rho;
+        aux_size_ = aux_size;
+        correlated_ = rho > 0;
+        if (!correlated_) {
+            internal::pmcmc_aux(pf_.particle().state(), 0, nullptr);
+        }
+    }
+
+    /// \brief Enable early rejection
+    ///
+    /// \details
+    /// `bound(iter, param)` shall return an upper bound of the sum of the
+    /// increments of `log_nc()` of the particle filter in iterations after
+    /// `iter`, for example zero if the observation densities are bounded by
+    /// one. The uniform random number of the acceptance test is drawn
+    /// before the particle filter is run, and the filter is stopped as soon
+    /// as the proposal will be rejected whatever the remaining increments
+    /// are. The chain is the same as without early rejection, only the
+    /// particle filter is run for fewer iterations. An empty `bound`
+    /// disables early rejection.
+    void early_reject(bound_type bound) { bound_ = std::move(bound); }
+
+    /// \brief Enable delayed acceptance
+    ///
+    /// \details
+    /// `eval(param)` shall return an approximation to the log likelihood
+    /// that is cheap to compute. A proposal is first accepted or rejected
+    /// with the likelihood replaced by the approximation, and the particle
+    /// filter is only run for proposals accepted in the first stage. These
+    /// are then accepted with the ratio of the estimated likelihood ratio to
+    /// the approximate one, such that the chain still targets the exact
+    /// posterior. The second stage can use early rejection. An empty `eval`
+    /// disables delayed acceptance.
+    void surrogate(surrogate_type eval)
+    {
+        surrogate_ = std::move(eval);
+        surrogate_valid_ = false;
+    }
+
+    /// \brief The number of proposals rejected before the particle filter
+    /// ran to the end
+    std::size_t num_early_reject() const { return num_early_reject_; }
+
+    /// \brief The number of proposals rejected by the first stage of the
+    /// delayed acceptance
+    std::size_t num_surrogate_reject() const
+    {
+        return num_surrogate_reject_;
+    }
+
+    /// \brief The correlation of the auxiliary random numbers
+    double rho() const { return rho_; }
+
     /// \brief Add a new evaluation object for the update step
     template <typename Eval>
     std::size_t update(Eval &&eval)
@@ -125,45 +417,400 @@ class PMCMCMutation
     std::size_t operator()(std::size_t iter, param_type &param)
     {
         if (iter == 0) {
-            pf_.clear();
-            pf_.particle().state().reset(param, 0);
-            pf_.iterate(M_);
+            if (correlated_) {
+                aux_init();
+            }
+            run_pf(param, aux_.data(), -const_inf<double>());
+            surrogate_valid_ = false;
             return 0;
         }
 
         const double lnc = pf_.particle().state().log_nc();
 
-        double prob = -prior_(param) - lnc;
-        param_type p(param);
+        double prob = -prior_(param);
+        param_ = param;
         for (auto &eval : eval_) {
-            prob += eval(pf_.particle().rng(), p);
+            prob += eval(pf_.particle().rng(), param_);
         }
-        prob += prior_(p);
-
-        pf_.clear();
-        pf_.particle().state().reset(p, 0);
-        pf_.iterate(M_);
-        prob += pf_.particle().state().log_nc();
+        prob += prior_(param_);
 
         mckl::U01Distribution<double> u01;
-        double u = std::log(u01(pf_.particle().rng()));
 
-        if (u < prob) {
-            param = std::move(p);
+        // First stage of the delayed acceptance, after which the likelihood
+        // ratio is tested against the approximate one
+        double ls = 0;
+        if (surrogate_) {
+            if (!surrogate_valid_) {
+                log_surrogate_ = surrogate_(param);
+                surrogate_valid_ = true;
+            }
+            ls = surrogate_(param_);
+            if (std::log(u01(pf_.particle().rng())) >=
+                prob + ls - log_surrogate_) {
+                ++num_surrogate_reject_;
+                return 0;
+            }
+            prob = log_surrogate_ - ls;
+        }
+
+        // The proposal is accepted if and only if log_nc() > threshold
+        const double u = std::log(u01(pf_.particle().rng()));
+        const double threshold = u - prob + lnc;
+
+        if (correlated_) {
+            aux_propose();
+        }
+        const bool accept = run_pf(param_, aux_prop_.data(), threshold) &&
+            pf_.particle().state().log_nc() > threshold;
+
+        if (accept) {
+            std::swap(param, param_);
+            std::swap(aux_, aux_prop_);
+            log_surrogate_ = ls;
         } else {
             pf_.particle().state().reset(param, lnc);
         }
+        if (correlated_) {
+            internal::pmcmc_aux(
+                pf_.particle().state(), aux_size_, aux_.data());
+        }
 
-        return u < prob ? 1 : 0;
+        return accept ? 1 : 0;
     }
 
   private:
     std::size_t M_;
+    double rho_;
+    std::size_t aux_size_;
+    bool correlated_;
+    double log_surrogate_;
+    bool surrogate_valid_;
+    std::size_t num_early_reject_;
+    std::size_t num_surrogate_reject_;
     prior_type prior_;
+    bound_type bound_;
+    surrogate_type surrogate_;
     pf_type pf_;
     Vector<eval_type> eval_;
+    param_type param_;
+    Vector<double> aux_;
+    Vector<double> aux_prop_;
+
+    std::size_t aux_total() const
+    {
+        return M_ * (aux_size_ + static_cast<std::size_t>(pf_.size()));
+    }
+
+    void aux_init()
+    {
+        const std::size_t n = aux_total();
+        aux_.resize(n);
+        aux_prop_.resize(n);
+        NormalDistribution<double> normal(0, 1);
+        rand(pf_.particle().rng(), normal, n, aux_.data());
+    }
+
+    void aux_propose()
+    {
+        const std::size_t n = aux_total();
+        if (aux_.size() != n) {
+            aux_init();
+        }
+        NormalDistribution<double> normal(0, 1);
+        rand(pf_.particle().rng(), normal, n, aux_prop_.data());
+        mul(n, std::sqrt(1 - rho_ * rho_), aux_prop_.data(),
+            aux_prop_.data());
+        muladd(n, aux_.data(), rho_, aux_prop_.data(), aux_prop_.data());
+    }
+
+    // Return false if stopped early since log_nc() cannot exceed threshold
+    bool run_pf(const param_type &p, const double *u, double threshold)
+    {
+        pf_.clear();
+        pf_.particle().state().reset(p, 0);
+        internal::pmcmc_aux(
+            pf_.particle().state(), aux_size_, correlated_ ? u : nullptr);
+        if (!bound_ || !(threshold > -const_inf<double>())) {
+            pf_.iterate(M_);
+            return true;
+        }
+
+        pf_.reserve(M_);
+        for (std::size_t i = 0; i != M_; ++i) {
+            pf_.iterate();
+            if (i + 1 != M_ &&
+                pf_.particle().state().log_nc() + bound_(i, p) <= threshold) {
+                ++num_early_reject_;
+                return false;
+            }
+        }
+
+        return true;
+    }
 }; // class PMCMCMutation
 
+/// \brief A pool of particle filters evaluating the likelihood of a batch of
+/// parameters concurrently
+/// \ingroup PMCMC
+///
+/// \details
+/// The filters are configured through `pf(k)` or `each(f)`, and each has its
+/// own particle collection and RNG engines. A batch of candidates is split
+/// into rounds of at most `size()` candidates, and the candidates of a round
+/// are run by `run(n, work)`, which shall call `work(ibegin, iend)` on
+/// disjoint subranges covering `[0, n)`, possibly in parallel, such as
+/// `RunSMP<Backend>()`.
+///
+/// The filters may use SMCSamplerEvalSMP evaluation objects, which run in
+/// parallel across particles when invoked outside a parallel region of the
+/// same backend, and sequentially otherwise. Rounds with fewer than
+/// `outer_min()` candidates are run one candidate at a time, such that all
+/// threads work on the particles of a single filter instead of idling. It
+/// should be set to about the number of threads when the filters use the
+/// SMP backends.
+template <typename Param, typename T, typename U = double>
+class PMCMCFilterPool
+{
+  public:
+    using param_type = Param;
+    using state_type = T;
+    using pf_type = SMCSampler<T, U>;
+    using run_type = BlockRun;
+
+    /// \brief Construct `K` filters of `N` particles, each run for `M`
+    /// iterations
+    ///
+    /// \details
+    /// All arguments after `M` are passed to the constructor of each filter
+    template <typename... Args>
+    PMCMCFilterPool(std::size_t K, std::size_t N, std::size_t M,
+        Args &&... args)
+        : M_(M), outer_min_(2)
+    {
+        runtime_assert(K > 0, "**PMCMCFilterPool** constructed with K = 0");
+
+        pf_.reserve(K);
+        for (std::size_t k = 0; k != K; ++k) {
+            pf_.push_back(pf_type(N, args...));
+        }
+    }
+
+    /// \brief The number of filters
+    std::size_t size() const { return pf_.size(); }
+
+    /// \brief The `k`-th filter
+    pf_type &pf(std::size_t k) { return pf_.at(k); }
+
+    /// \brief The `k`-th filter
+    const pf_type &pf(std::size_t k) const { return pf_.at(k); }
+
+    /// \brief Call `f(pf)` on each filter
+    template <typename F>
+    void each(F &&f)
+    {
+        for (auto &pf : pf_) {
+            f(pf);
+        }
+    }
+
+    /// \brief Set the loop over the candidates of a round
+    void run(run_type run) { run_ = std::move(run); }
+
+    /// \brief The minimum number of candidates run concurrently
+    std::size_t outer_min() const { return outer_min_; }
+
+    /// \brief Set the minimum number of candidates run concurrently
+    void outer_min(std::size_t n) { outer_min_ = n; }
+
+    /// \brief Compute the log likelihood estimates of `n` parameters
+    void log_nc(std::size_t n, const param_type *param, double *r)
+    {
+        const std::size_t K = size();
+        for (std::size_t i = 0; i < n; i += K) {
+            const std::size_t m = std::min(K, n - i);
+            auto work = [this, param, r, i](
+                            std::size_t jbegin, std::size_t jend) {
+                for (std::size_t j = jbegin; j != jend; ++j) {
+                    r[i + j] = run_pf(pf_[j], param[i + j]);
+                }
+            };
+            if (run_ && m >= outer_min_) {
+                run_(m, work);
+            } else {
+                work(0, m);
+            }
+        }
+    }
+
+  private:
+    std::size_t M_;
+    std::size_t outer_min_;
+    Vector<pf_type> pf_;
+    run_type run_;
+
+    double run_pf(pf_type &pf, const param_type &p)
+    {
+        pf.clear();
+        pf.particle().state().reset(p, 0);
+        internal::pmcmc_aux(pf.particle().state(), 0, nullptr);
+        pf.iterate(M_);
+
+        return pf.particle().state().log_nc();
+    }
+}; // class PMCMCFilterPool
+
+/// \brief Particle marginal multiple-try Metropolis mutation
+/// \ingroup PMCMC
+///
+/// \details
+/// For each iteration, `K` candidates are proposed by the update evaluation
+/// objects, and their likelihoods are estimated concurrently by a
+/// PMCMCFilterPool. One is selected with probability proportional to its
+/// estimated posterior density, and `K - 1` reference points are proposed
+/// from it and estimated likewise, the last one being the current state with
+/// its stored estimate. The selected candidate is accepted with the ratio of
+/// the sums of the estimated densities of the candidates and the reference
+/// points. The update evaluation objects shall be symmetric random walks,
+/// and their return values are ignored. The buffers of the candidates are
+/// allocated once.
+template <typename Param, typename T, typename U = double>
+class PMCMCMultipleTry
+{
+  public:
+    using param_type = Param;
+    using state_type = T;
+    using rng_type = typename Particle<T>::rng_type;
+    using eval_type = std::function<double(rng_type &, param_type &)>;
+    using prior_type = std::function<double(const param_type &)>;
+    using pool_type = PMCMCFilterPool<Param, T, U>;
+
+    /// \brief Construct with `K` tries
+    ///
+    /// \details
+    /// All arguments after `prior` are passed to the constructor of the pool
+    /// after `K`
+    template <typename Prior, typename... Args>
+    PMCMCMultipleTry(std::size_t K, Prior &&prior, Args &&... args)
+        : K_(K)
+        , lnc_(0)
+        , prior_(std::forward<Prior>(prior))
+        , pool_(K, std::forward<Args>(args)...)
+        , rng_(Seed<rng_type>::instance().get())
+        , cand_(K)
+        , ref_(K)
+        , wcand_(K)
+        , wref_(K)
+    {
+    }
+
+    /// \brief The number of tries
+    std::size_t size() const { return K_; }
+
+    /// \brief The pool of particle filters
+    pool_type &pool() { return pool_; }
+
+    /// \brief The pool of particle filters
+    const pool_type &pool() const { return pool_; }
+
+    /// \brief Add a new evaluation object for the update step
+    template <typename Eval>
+    std::size_t update(Eval &&eval)
+    {
+        eval_.push_back(std::forward<Eval>(eval));
+
+        return eval_.size() - 1;
+    }
+
+    std::size_t operator()(std::size_t iter, param_type &param)
+    {
+        if (iter == 0) {
+            pool_.log_nc(1, &param, &lnc_);
+            return 0;
+        }
+
+        for (std::size_t k = 0; k != K_; ++k) {
+            cand_[k] = param;
+            propose(cand_[k]);
+        }
+        pool_.log_nc(K_, cand_.data(), wcand_.data());
+        add_prior(K_, cand_.data(), wcand_.data());
+        const double scand = log_sum(K_, wcand_.data());
+        const std::size_t J = select(scand);
+
+        for (std::size_t k = 0; k != K_ - 1; ++k) {
+            ref_[k] = cand_[J];
+            propose(ref_[k]);
+        }
+        pool_.log_nc(K_ - 1, ref_.data(), wref_.data());
+        add_prior(K_ - 1, ref_.data(), wref_.data());
+        wref_[K_ - 1] = lnc_ + prior_(param);
+        const double sref = log_sum(K_, wref_.data());
+
+        U01Distribution<double> u01;
+        if (std::log(u01(rng_)) < scand - sref) {
+            lnc_ = wcand_[J] - prior_(cand_[J]);
+            std::swap(param, cand_[J]);
+            return 1;
+        }
+
+        return 0;
+    }
+
+  private:
+    std::size_t K_;
+    double lnc_;
+    prior_type prior_;
+    pool_type pool_;
+    rng_type rng_;
+    Vector<eval_type> eval_;
+    Vector<param_type> cand_;
+    Vector<param_type> ref_;
+    Vector<double> wcand_;
+    Vector<double> wref_;
+
+    void propose(param_type &p)
+    {
+        for (auto &eval : eval_) {
+            eval(rng_, p);
+        }
+    }
+
+    void add_prior(std::size_t n, const param_type *p, double *w)
+    {
+        for (std::size_t k = 0; k != n; ++k) {
+            w[k] += prior_(p[k]);
+        }
+    }
+
+    static double log_sum(std::size_t n, const double *w)
+    {
+        const double wmax = *std::max_element(w, w + n);
+        if (!(wmax > -const_inf<double>())) {
+            return wmax;
+        }
+        double s = 0;
+        for (std::size_t k = 0; k != n; ++k) {
+            s += std::exp(w[k] - wmax);
+        }
+
+        return wmax + std::log(s);
+    }
+
+    std::size_t select(double s)
+    {
+        U01Distribution<double> u01;
+        double u = u01(rng_);
+        for (std::size_t k = 0; k != K_ - 1; ++k) {
+            u -= std::exp(wcand_[k] - s);
+            if (u < 0) {
+                return k;
+            }
+        }
+
+        return K_ - 1;
+    }
+}; // class PMCMCMultipleTry
+
 } // namespace mckl
 
 MCKL_POP_CLANG_WARNING
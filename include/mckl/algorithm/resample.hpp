@@ -465,6 +465,28 @@ inline OutputIter resample_trans_rep_index(
     return index;
 }
 
+namespace internal {
+
+// Use the buffer kept by a resampling object as scratch space if it has the
+// requested value type, otherwise the temporary one
+template <typename T>
+inline T *resample_buffer(std::size_t n, Vector<T> &buffer, Vector<T> &)
+{
+    buffer.resize(n);
+
+    return buffer.data();
+}
+
+template <typename T, typename U>
+inline T *resample_buffer(std::size_t n, Vector<U> &, Vector<T> &tmp)
+{
+    tmp.resize(n);
+
+    return tmp.data();
+}
+
+} // namespace internal
+
 /// \brief SMCSampler<T>::eval_type subtype
 /// \ingroup Resample
 template <typename T>
@@ -491,23 +513,31 @@ class ResampleEval
     }
 
     /// \brief Resample a particle collection
+    ///
+    /// \details
+    /// The replication numbers and parent indices are stored in mutable
+    /// buffers kept by this object. Repeated resampling of a particle
+    /// collection of the same size does not allocate memory. Concurrent calls
+    /// on the same object are not thread-safe.
     void operator()(std::size_t, Particle<T> &particle) const
     {
         runtime_assert(static_cast<bool>(eval_),
             "**ResampleEval::operator()** invalid evaluation object");
 
-        using size_type = typename Particle<T>::size_type;
-
         const std::size_t N = static_cast<std::size_t>(particle.size());
-        Vector<size_type> rep(N);
-        Vector<size_type> idx(N);
-        eval_(N, N, particle.rng(), particle.weight().data(), rep.data());
-        resample_trans_rep_index(N, N, rep.data(), idx.data());
-        particle.select(particle.size(), idx.data());
+        rep_.resize(N);
+        idx_.resize(N);
+        eval_(N, N, particle.rng(), particle.weight().data(), rep_.data());
+        resample_trans_rep_index(N, N, rep_.data(), idx_.data());
+        particle.select(particle.size(), idx_.data());
     }
 
   private:
+    using size_type = typename Particle<T>::size_type;
+
     eval_type eval_;
+    mutable Vector<size_type> rep_;
+    mutable Vector<size_type> idx_;
 }; // class ResampleEval
 
 /// \brief Resampling algorithm
@@ -523,6 +553,11 @@ class ResampleAlgorithm
     /// \param rng An RNG engine
     /// \param weight N-vector of normalized weights
     /// \param replication N-vector of replication numbers
+    ///
+    /// \details
+    /// Temporary values of type `double` and `std::size_t` are stored in
+    /// mutable buffers kept by this object and reused by subsequent calls.
+    /// Concurrent calls on the same object are not thread-safe.
     template <typename RNGType, typename InputIter, typename OutputIter>
     void operator()(std::size_t N, std::size_t M, RNGType &rng,
         InputIter weight, OutputIter replication) const
@@ -533,6 +568,9 @@ class ResampleAlgorithm
 
   private:
     U01SeqType u01seq_;
+    mutable Vector<double> u01_;
+    mutable Vector<double> resid_;
+    mutable Vector<std::size_t> integ_;
 
     template <typename RNGType, typename InputIter, typename OutputIter>
     void eval(std::size_t N, std::size_t M, RNGType &rng, InputIter weight,
@@ -540,9 +578,10 @@ class ResampleAlgorithm
     {
         using real_type = typename std::iterator_traits<InputIter>::value_type;
 
-        Vector<real_type> u01(M);
-        u01seq_(rng, M, u01.data());
-        resample_trans_u01_rep(N, M, weight, u01.data(), replication);
+        Vector<real_type> u01tmp;
+        real_type *const u01 = internal::resample_buffer(M, u01_, u01tmp);
+        u01seq_(rng, M, u01);
+        resample_trans_u01_rep(N, M, weight, u01, replication);
     }
 
     template <typename RNGType, typename InputIter, typename OutputIter>
@@ -552,14 +591,18 @@ class ResampleAlgorithm
         using real_type = typename std::iterator_traits<InputIter>::value_type;
         using rep_type = typename std::iterator_traits<OutputIter>::value_type;
 
-        Vector<real_type> resid(N);
-        Vector<rep_type> integ(N);
-        std::size_t R =
-            resample_trans_residual(N, M, weight, resid.data(), integ.data());
-
-        Vector<real_type> u01(R);
-        u01seq_(rng, R, u01.data());
-        resample_trans_u01_rep(N, R, resid.data(), u01.data(), replication);
+        Vector<real_type> residtmp;
+        Vector<rep_type> integtmp;
+        real_type *const resid =
+            internal::resample_buffer(N, resid_, residtmp);
+        rep_type *const integ = internal::resample_buffer(N, integ_, integtmp);
+        const std::size_t R =
+            resample_trans_residual(N, M, weight, resid, integ);
+
+        Vector<real_type> u01tmp;
+        real_type *const u01 = internal::resample_buffer(R, u01_, u01tmp);
+        u01seq_(rng, R, u01);
+        resample_trans_u01_rep(N, R, resid, u01, replication);
         for (std::size_t i = 0; i != N; ++i, ++replication) {
             *replication += integ[i];
         }
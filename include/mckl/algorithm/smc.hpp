@@ -53,10 +53,21 @@ class SMCEstimator
         "**SMCEsimator** used with estimate type U not convertible to double");
 
   public:
+    /// \brief Type of the evaluation object of a fused estimator
+    ///
+    /// \details
+    /// It is called as `eval(iter, dim, range, r)`, where `r` points to the
+    /// `range.size() * dim` values of the particles in `range`, stored in row
+    /// major order.
+    using range_eval_type = std::function<void(
+        std::size_t, std::size_t, const ParticleRange<T> &, double *)>;
+
     SMCEstimator() : layout_(RowMajor), record_only_(false) {}
 
     SMCEstimator(std::size_t dim)
         : Estimator<U, std::size_t, std::size_t, Particle<T> &, U *>(dim)
+        , layout_(RowMajor)
+        , record_only_(false)
     {
     }
 
@@ -73,6 +84,39 @@ class SMCEstimator
     /// \brief If this is a record only estimator
     bool record_only() const { return record_only_; }
 
+    /// \brief Set a range evaluation object and join the fused group
+    ///
+    /// \details
+    /// SMCSampler evaluates all fused estimators of the same step together,
+    /// in a single pass over fixed blocks of particles. Within each block,
+    /// the range evaluation objects of all of them are called in turn, and
+    /// their values are reduced into weighted sums immediately, while the
+    /// block is still in cache. Neither the values of all particles nor the
+    /// evaluation object set by `estimate()` are used. A record only
+    /// estimator is never fused.
+    ///
+    /// The values of a block are written to a buffer local to the calling
+    /// thread and shared by all samplers evaluated on that thread. Thus `eval`
+    /// shall not iterate or estimate another sampler on the same thread.
+    template <typename Eval>
+    void fuse(Eval &&eval)
+    {
+        range_eval_ = std::forward<Eval>(eval);
+    }
+
+    /// \brief If this estimator is evaluated in the fused pass of SMCSampler
+    bool fused() const
+    {
+        return static_cast<bool>(range_eval_) && !record_only_;
+    }
+
+    /// \brief Call the range evaluation object set by `fuse()`
+    void estimate_range(
+        std::size_t iter, const ParticleRange<T> &range, double *r)
+    {
+        range_eval_(iter, this->dim(), range, r);
+    }
+
     /// \brief Set a new evaluation object
     template <typename Eval>
     void estimate(
@@ -123,6 +167,7 @@ class SMCEstimator
     Vector<double> result_;
     MatrixLayout layout_;
     bool record_only_;
+    range_eval_type range_eval_;
 
     double *rptr(std::true_type) { return u_.data(); }
 
@@ -157,7 +202,37 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
     using eval_type = typename Sampler<SMCSampler<T, U>>::eval_type;
     using estimator_type = typename Sampler<SMCSampler<T, U>>::estimator_type;
 
-    SMCSampler() : iter_(0), resample_threshold_(resample_threshold_never()) {}
+    /// \brief Type of the sink of the streaming mode of the histories
+    ///
+    /// \details
+    /// The sink is called as `sink(offset, n, size, ess)`, where `size` and
+    /// `ess` point to the sampler sizes and the values of ESS of iterations
+    /// `offset` to `offset + n - 1`.
+    using history_sink_type = std::function<void(
+        std::size_t, std::size_t, const size_type *, const double *)>;
+
+    /// \brief Type of the loop over the blocks of the fused estimators, see
+    /// BlockRun
+    using estimate_run_type = BlockRun;
+
+    /// \brief Type of the log-likelihood evaluation object of adaptive
+    /// tempering
+    ///
+    /// \details
+    /// It is called as `eval(iter, particle, l)` and shall write the log
+    /// likelihood of each particle to `l`.
+    using tempering_eval_type =
+        std::function<void(std::size_t, Particle<T> &, double *)>;
+
+    SMCSampler()
+        : iter_(0)
+        , resample_threshold_(resample_threshold_never())
+        , history_offset_(0)
+        , history_capacity_(0)
+        , tempering_target_(0.5)
+        , temperature_(0)
+    {
+    }
 
     /// \brief Construct a SMC sampler
     ///
@@ -169,6 +244,10 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         , particle_(N, std::forward<Args>(args)...)
         , iter_(0)
         , resample_threshold_(resample_threshold_never())
+        , history_offset_(0)
+        , history_capacity_(0)
+        , tempering_target_(0.5)
+        , temperature_(0)
     {
     }
 
@@ -187,15 +266,58 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
     size_type size() const { return particle_.size(); }
 
     /// \brief The number of iterations already performed
-    std::size_t num_iter() const { return size_history_.size(); }
+    std::size_t num_iter() const
+    {
+        return history_offset_ + size_history_.size();
+    }
 
     /// \brief Reserve space for a specified number of iterations
     void reserve(std::size_t n)
     {
         Sampler<SMCSampler<T, U>>::reserve(n);
-        n += num_iter();
-        size_history_.reserve(n);
-        ess_history_.reserve(n);
+        if (history_capacity_ == 0) {
+            n += size_history_.size();
+            size_history_.reserve(n);
+            ess_history_.reserve(n);
+        }
+    }
+
+    /// \brief Enter the streaming mode of the histories of sampler sizes and
+    /// values of ESS
+    ///
+    /// \details
+    /// At most `capacity` iterations of the histories are kept in memory. See
+    /// EstimateMatrix::stream for the semantics. The estimators are streamed
+    /// separately by calling `stream()` on each of them.
+    void stream_history(
+        std::size_t capacity, history_sink_type sink = history_sink_type())
+    {
+        flush_history();
+        history_capacity_ = capacity;
+        history_sink_ = std::move(sink);
+        if (history_capacity_ != 0) {
+            size_history_.reserve(history_capacity_);
+            ess_history_.reserve(history_capacity_);
+        }
+    }
+
+    /// \brief Set the loop over the blocks of the fused estimators
+    ///
+    /// \details
+    /// By default, or if `run` is empty, all blocks are evaluated by the
+    /// calling thread. The partial sums of each block are combined in a fixed
+    /// order, and thus the estimates do not depend on how the blocks are
+    /// distributed among threads.
+    void estimate_run(estimate_run_type run)
+    {
+        estimate_run_ = std::move(run);
+    }
+
+    /// \brief Flush the histories and all estimators
+    void flush()
+    {
+        Sampler<SMCSampler<T, U>>::flush();
+        flush_history();
     }
 
     /// \brief Reset the sampler by clear all history, evaluation objects, and
@@ -211,10 +333,43 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
     {
         Sampler<SMCSampler<T, U>>::clear();
         iter_ = 0;
+        history_offset_ = 0;
         size_history_.clear();
         ess_history_.clear();
+        temperature_ = 0;
+    }
+
+    /// \brief Enable adaptive tempering
+    ///
+    /// \details
+    /// At each iteration, after the selection evaluation objects, the log
+    /// likelihoods \f$l_i\f$ are computed by `eval`, and the weights are
+    /// multiplied by \f$\exp(\delta l_i)\f$. The increment \f$\delta\f$
+    /// of the temperature is the largest one, up to the remainder to one, such
+    /// that the conditional ESS (see Weight::cess) is at least `target` times
+    /// the sampler size. If some \f$l_i = -\infty\f$, the conditional ESS of
+    /// any \f$\delta > 0\f$ is at most the size times the total weight of the
+    /// other particles, and the target is scaled by the latter. The increment
+    /// is found by bisection, with several candidates evaluated in each pass
+    /// over the particles. The weights are only modified once \f$\delta\f$
+    /// is accepted. The resampling and mutation steps follow as usual, and the
+    /// mutation evaluation objects can use `temperature()` as the target. An
+    /// empty `eval` disables tempering.
+    void tempering(tempering_eval_type eval, double target = 0.5)
+    {
+        runtime_assert(target > 0 && target <= 1,
+            "**SMCSampler::tempering** used with target not in (0, 1]");
+
+        tempering_eval_ = std::move(eval);
+        tempering_target_ = target;
     }
 
+    /// \brief The current temperature of adaptive tempering
+    double temperature() const { return temperature_; }
+
+    /// \brief Set the temperature of adaptive tempering
+    void temperature(double alpha) { temperature_ = alpha; }
+
     /// \brief Get resampling threshold
     double resample_threshold() const { return resample_threshold_; }
 
@@ -359,6 +514,25 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         }
     }
 
+    /// \brief Iterate the sampler with adaptive tempering until the
+    /// temperature reaches one, or at most `n` iterations, and return the
+    /// number of iterations performed
+    std::size_t iterate_tempering(
+        std::size_t n = std::numeric_limits<std::size_t>::max())
+    {
+        runtime_assert(static_cast<bool>(tempering_eval_),
+            "**SMCSampler::iterate_tempering** used without adaptive "
+            "tempering enabled");
+
+        std::size_t k = 0;
+        while (k < n && temperature_ < 1) {
+            do_iterate();
+            ++k;
+        }
+
+        return k;
+    }
+
     /// \brief Read and write access to the Particle<T> object
     Particle<T> &particle() { return particle_; }
 
@@ -366,6 +540,10 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
     const Particle<T> &particle() const { return particle_; }
 
     /// \brief Read history the sampler sizes
+    ///
+    /// \details
+    /// In the streaming mode, only the iterations still in memory are read,
+    /// the first of which is of iteration `num_iter() - history_size()`.
     template <typename OutputIter>
     OutputIter read_size_history(OutputIter first) const
     {
@@ -379,16 +557,53 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         return std::copy(ess_history_.begin(), ess_history_.end(), first);
     }
 
+    /// \brief The number of iterations of the histories in memory
+    std::size_t history_size() const { return size_history_.size(); }
+
   private:
     Particle<T> particle_;
     std::size_t iter_;
     double resample_threshold_;
     Vector<size_type> size_history_;
     Vector<double> ess_history_;
+    std::size_t history_offset_;
+    std::size_t history_capacity_;
+    history_sink_type history_sink_;
+    estimate_run_type estimate_run_;
+    Vector<estimator_type *> fused_;
+    Vector<std::size_t> fused_offset_;
+    Vector<double> fused_sum_;
+    tempering_eval_type tempering_eval_;
+    double tempering_target_;
+    double temperature_;
+    Vector<double> tempering_llh_;
+
+    void flush_history()
+    {
+        const std::size_t n = size_history_.size();
+        if (n == 0) {
+            return;
+        }
+        if (history_sink_) {
+            history_sink_(history_offset_, n, size_history_.data(),
+                ess_history_.data());
+        }
+        history_offset_ += n;
+        size_history_.clear();
+        ess_history_.clear();
+    }
 
     void do_iterate()
     {
+        if (history_capacity_ != 0 &&
+            size_history_.size() >= history_capacity_) {
+            flush_history();
+        }
+
         do_eval(0);
+        if (tempering_eval_ && temperature_ < 1) {
+            do_tempering();
+        }
         do_estimate(0);
 
         size_history_.push_back(size());
@@ -412,10 +627,138 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         }
     }
 
+    void do_tempering()
+    {
+        constexpr std::size_t m = 8;
+        constexpr std::size_t maxpass = 16;
+        constexpr double tol = 1e-6;
+
+        const std::size_t N = static_cast<std::size_t>(size());
+        tempering_llh_.resize(N);
+        double *const l = tempering_llh_.data();
+        tempering_eval_(iter_, particle_, l);
+
+        // The limit of the conditional ESS as the increment goes to zero
+        const Weight &weight = particle_.weight();
+        const double *const w = weight.data();
+        double wsum = 0;
+        for (std::size_t i = 0; i != N; ++i) {
+            if (l[i] != -const_inf<double>()) {
+                wsum += w[i];
+            }
+        }
+        const double target = tempering_target_ * N * std::min(wsum, 1.0);
+        double hi = 1 - temperature_;
+        double delta = hi;
+        if (weight.cess(hi, l) < target) {
+            // Each pass evaluates m equally spaced points of (lo, hi)
+            std::array<double, m> alpha;
+            std::array<double, m> r;
+            double lo = 0;
+            for (std::size_t p = 0; p != maxpass; ++p) {
+                const double h = (hi - lo) / (m + 1);
+                for (std::size_t j = 0; j != m; ++j) {
+                    alpha[j] = lo + h * (j + 1);
+                }
+                weight.cess(m, alpha.data(), l, r.data());
+                std::size_t j = 0;
+                while (j != m && r[j] >= target) {
+                    ++j;
+                }
+                if (j != 0) {
+                    lo = alpha[j - 1];
+                }
+                if (j != m) {
+                    hi = alpha[j];
+                }
+                if (hi - lo <= hi * tol) {
+                    break;
+                }
+            }
+            delta = lo > 0 ? lo : hi;
+        }
+
+        temperature_ = delta == 1 - temperature_ ? 1 : temperature_ + delta;
+        ::mckl::mul(N, delta, l, l);
+        particle_.weight().add_log(const_cast<const double *>(l));
+    }
+
     void do_estimate(std::size_t step)
     {
+        fused_.clear();
         for (auto &est : this->estimator(step)) {
-            est.estimate(iter_, particle_);
+            if (est.fused()) {
+                fused_.push_back(&est);
+            } else {
+                est.estimate(iter_, particle_);
+            }
+        }
+        if (!fused_.empty()) {
+            do_estimate_fused();
+        }
+    }
+
+    void do_estimate_fused()
+    {
+        const std::size_t block = internal::BufferSize<double>::value;
+        const std::size_t n = static_cast<std::size_t>(size());
+        const std::size_t m = fused_.size();
+        const std::size_t nblocks = (n + block - 1) / block;
+
+        fused_offset_.resize(m + 1);
+        fused_offset_[0] = 0;
+        std::size_t dmax = 0;
+        for (std::size_t j = 0; j != m; ++j) {
+            const std::size_t d = fused_[j]->dim();
+            internal::size_check<MCKL_BLAS_INT>(d, "SMCSampler::estimate");
+            fused_offset_[j + 1] = fused_offset_[j] + d;
+            dmax = std::max(dmax, d);
+        }
+        const std::size_t dsum = fused_offset_[m];
+        fused_sum_.resize(std::max(nblocks, std::size_t(1)) * dsum);
+
+        const double *const w = particle_.weight().data();
+        auto work = [this, block, n, m, dmax, dsum, w](
+                        std::size_t bbegin, std::size_t bend) {
+            // Shared by all samplers on this thread, see SMCEstimator::fuse
+            static thread_local Vector<double> u;
+            if (u.size() < block * dmax) {
+                u.resize(block * dmax);
+            }
+            for (std::size_t b = bbegin; b != bend; ++b) {
+                const std::size_t ibegin = b * block;
+                const std::size_t iend = std::min(n, ibegin + block);
+                const std::size_t k = iend - ibegin;
+                const auto range =
+                    particle_.range(static_cast<size_type>(ibegin),
+                        static_cast<size_type>(iend));
+                double *const s = fused_sum_.data() + b * dsum;
+                for (std::size_t j = 0; j != m; ++j) {
+                    const std::size_t d = fused_[j]->dim();
+                    fused_[j]->estimate_range(iter_, range, u.data());
+                    internal::cblas_dgemv(internal::CblasColMajor,
+                        internal::CblasNoTrans, static_cast<MCKL_BLAS_INT>(d),
+                        static_cast<MCKL_BLAS_INT>(k), 1.0, u.data(),
+                        static_cast<MCKL_BLAS_INT>(d), w + ibegin, 1, 0.0,
+                        s + fused_offset_[j], 1);
+                }
+            }
+        };
+        if (estimate_run_) {
+            estimate_run_(nblocks, work);
+        } else {
+            work(0, nblocks);
+        }
+
+        if (nblocks == 0) {
+            std::fill_n(fused_sum_.data(), dsum, 0.0);
+        }
+        for (std::size_t b = 1; b < nblocks; ++b) {
+            add(dsum, fused_sum_.data() + b * dsum, fused_sum_.data(),
+                fused_sum_.data());
+        }
+        for (std::size_t j = 0; j != m; ++j) {
+            fused_[j]->insert_estimate(fused_sum_.data() + fused_offset_[j]);
         }
     }
 }; // class SMCSampler
@@ -34,6 +34,7 @@
 
 #include <mckl/internal/common.hpp>
 #include <mckl/core/matrix.hpp>
+#include <functional>
 
 namespace mckl {
 
@@ -45,6 +46,15 @@ namespace mckl {
 /// number of iterations of the algorithms. The estimates are collected in an
 /// \f$t\f$ by \f$d\f$ matrix \f$E\f$, where \f$E_{i,j} = \eta_i(j)\f$, the
 /// \f$j\f$-th component of the an estimate at iteration \f$i\f$.
+///
+/// By default all estimates are kept in memory. In the streaming mode, set by
+/// `stream()`, at most `capacity()` estimates are kept. When the buffer is
+/// full, the stored estimates are handed to a sink and then discarded before
+/// a new one is inserted. The buffer is allocated once and reused, such that
+/// the memory usage stays constant however many iterations are performed.
+/// The member functions `num_iter()`, `estimate()`, `variable()`, etc., refer
+/// to the estimates still in memory, the first of which is of iteration
+/// `offset()`.
 template <typename T>
 class EstimateMatrix : public Matrix<T, RowMajor>
 {
@@ -57,7 +67,19 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     using const_estimate_range = typename matrix_type::const_row_range;
     using const_variable_range = typename matrix_type::const_col_range;
 
-    EstimateMatrix(size_type dim) : matrix_type(0, dim) {}
+    /// \brief Type of the sink of the streaming mode
+    ///
+    /// \details
+    /// The sink is called as `sink(offset, n, dim, data)`, where `data` points
+    /// to an \f$n\f$ by \f$d\f$ row major matrix of the estimates of
+    /// iterations `offset` to `offset + n - 1`.
+    using sink_type = std::function<void(
+        std::size_t, std::size_t, std::size_t, const value_type *)>;
+
+    EstimateMatrix(size_type dim)
+        : matrix_type(0, dim), offset_(0), capacity_(0)
+    {
+    }
 
     /// \brief The dimension of the estimator
     std::size_t dim() const noexcept { return this->ncol(); }
@@ -65,13 +87,67 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     /// \brief The number of iterations stored in the estimate matrix
     std::size_t num_iter() const noexcept { return this->nrow(); }
 
+    /// \brief The iteration number of the first estimate stored
+    std::size_t offset() const noexcept { return offset_; }
+
+    /// \brief The maximum number of iterations stored in the streaming mode,
+    /// zero if not streaming
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// \brief Enter the streaming mode
+    ///
+    /// \param capacity The maximum number of iterations stored. If it is
+    /// zero, the streaming mode is left and all subsequent estimates are kept
+    /// \param sink The object receiving the estimates to be discarded. If it
+    /// is empty, the estimates are discarded silently
+    ///
+    /// \details
+    /// The estimates currently stored are flushed first.
+    void stream(std::size_t capacity, sink_type sink = sink_type())
+    {
+        flush();
+        capacity_ = capacity;
+        sink_ = std::move(sink);
+        if (capacity_ != 0) {
+            matrix_type::reserve(capacity_, dim());
+        }
+    }
+
+    /// \brief Hand all estimates stored to the sink, if any, and discard them
+    void flush()
+    {
+        const std::size_t n = num_iter();
+        if (n == 0) {
+            return;
+        }
+        if (sink_) {
+            sink_(offset_, n, dim(), this->data());
+        }
+        offset_ += n;
+        this->resize(0, dim());
+    }
+
     /// \brief Clear the estimate matrix but preserve the dimension
-    void clear() { this->resize(0, dim()); }
+    ///
+    /// \details
+    /// The estimates stored are discarded without being passed to the sink,
+    /// and the iteration number starts from zero again.
+    void clear()
+    {
+        this->resize(0, dim());
+        offset_ = 0;
+    }
 
     /// \brief Reserve space for *additional* iterations
+    ///
+    /// \details
+    /// This has no effect in the streaming mode, where the space is reserved
+    /// by `stream()`.
     void reserve(std::size_t n)
     {
-        matrix_type::reserve(num_iter() + n, dim());
+        if (capacity_ == 0) {
+            matrix_type::reserve(num_iter() + n, dim());
+        }
     }
 
     /// \brief Range of an estimate
@@ -95,6 +171,7 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     /// \brief Add space for a new estimate, return a pointer to the new row
     T *insert_estimate()
     {
+        flush_full();
         const size_type i = num_iter();
         this->resize(i + 1, dim());
 
@@ -105,6 +182,7 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     template <typename InputIter>
     void insert_estimate(InputIter first)
     {
+        flush_full();
         this->push_back_row(first);
     }
 
@@ -118,9 +196,24 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     /// iterations, and the values of estimates of iterations \f$t\f$ to
     /// \f$i - 1\f$ will be initialized as `-const_nan<T>()` if `T` is a
     /// floating point type.
+    ///
+    /// In the streaming mode, \f$i\f$ is the iteration number counted from
+    /// the beginning, including estimates already flushed, which cannot be
+    /// overriden.
     template <typename InputIter>
     void insert_estimate(size_type i, InputIter first)
     {
+        runtime_assert(i >= offset_,
+            "**EstimateMatrix::insert_estimate** used with an iteration "
+            "already flushed");
+
+        if (capacity_ != 0) {
+            while (offset_ + num_iter() < i) {
+                fill_estimate(insert_estimate(), std::is_floating_point<T>());
+            }
+        }
+        i -= offset_;
+
         const size_type t = num_iter();
         if (i < t) {
             std::copy_n(first, dim(), this->row_begin(i));
@@ -134,9 +227,27 @@ class EstimateMatrix : public Matrix<T, RowMajor>
     }
 
   private:
+    std::size_t offset_;
+    std::size_t capacity_;
+    sink_type sink_;
+
     using matrix_type::push_back_col;
     using matrix_type::resize;
 
+    void flush_full()
+    {
+        if (capacity_ != 0 && num_iter() >= capacity_) {
+            flush();
+        }
+    }
+
+    void fill_estimate(T *r, std::true_type)
+    {
+        std::fill_n(r, dim(), -const_nan<T>());
+    }
+
+    void fill_estimate(T *, std::false_type) {}
+
     template <typename InputIter>
     void insert_estimate_dispatch(
         size_type t, size_type i, InputIter first, std::true_type)
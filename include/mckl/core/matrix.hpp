@@ -729,6 +729,11 @@ class Matrix
             return;
         }
 
+        if (ncol == ncol_) {
+            resize_nrow(nrow);
+            return;
+        }
+
         Matrix tmp(nrow, ncol);
         const size_type n = std::min(nrow, nrow_);
         const size_type m = std::min(ncol, ncol_);
@@ -737,6 +742,28 @@ class Matrix
         }
         swap(tmp);
     }
+
+    // Change the number of rows of a column major matrix in-place, such that
+    // the storage is reallocated only if the capacity is exceeded
+    void resize_nrow(size_type nrow)
+    {
+        if (nrow < nrow_) {
+            for (size_type j = 1; j < ncol_; ++j) {
+                const_pointer src = data() + j * nrow_;
+                std::copy(src, src + nrow, data() + j * nrow);
+            }
+            data_.resize(nrow * ncol_);
+        } else {
+            data_.resize(nrow * ncol_);
+            for (size_type j = ncol_; j > 0; --j) {
+                pointer src = data() + (j - 1) * nrow_;
+                pointer dst = data() + (j - 1) * nrow;
+                std::copy_backward(src, src + nrow_, dst + nrow_);
+                std::fill(dst + nrow_, dst + nrow, value_type());
+            }
+        }
+        nrow_ = nrow;
+    }
 }; // class Matrix
 
 /// \brief Output operator
@@ -37,6 +37,16 @@
 
 namespace mckl {
 
+/// \brief Type of the loop over blocks used by samplers and moves
+/// \ingroup Core
+///
+/// \details
+/// It is called as `run(n, work)`, and shall call `work(ibegin, iend)` on
+/// disjoint subranges that cover `[0, n)`, possibly in parallel. For example,
+/// `RunSMP<Backend>()`.
+using BlockRun = std::function<void(
+    std::size_t, const std::function<void(std::size_t, std::size_t)> &)>;
+
 template <typename>
 class SamplerTrait;
 
@@ -80,17 +90,31 @@ class Sampler
         }
     }
 
+    /// \brief Flush all estimators in the streaming mode
+    void flush()
+    {
+        for (auto &est : estimator_) {
+            for (auto &e : est) {
+                e.flush();
+            }
+        }
+    }
+
     /// \brief Return a combined matrix of all estimates
+    ///
+    /// \details
+    /// If some estimators are in the streaming mode, only the most recent
+    /// iterations still stored by all estimators are included.
     template <typename T, MatrixLayout Layout>
     Matrix<T, Layout> summary() const
     {
-        const std::size_t nrow =
-            static_cast<const Derived *>(this)->num_iter();
+        std::size_t nrow = static_cast<const Derived *>(this)->num_iter();
 
         std::size_t ncol = 0;
         for (auto &est : estimator_) {
             for (auto &e : est) {
                 ncol += e.dim();
+                nrow = std::min(nrow, e.num_iter());
             }
         }
 
@@ -104,7 +128,8 @@ class Sampler
                 T *first = mat.row_data(i);
                 for (auto &est : estimator_) {
                     for (auto &e : est) {
-                        first = std::copy(e.row_begin(i), e.row_end(i), first);
+                        const std::size_t k = e.num_iter() - nrow + i;
+                        first = std::copy(e.row_begin(k), e.row_end(k), first);
                     }
                 }
             }
@@ -113,7 +138,9 @@ class Sampler
             for (auto &est : estimator_) {
                 for (auto &e : est) {
                     for (std::size_t j = 0; j != e.dim(); ++j) {
-                        first = std::copy(e.col_begin(j), e.col_end(j), first);
+                        first = std::copy(
+                            e.col_end(j) - static_cast<std::ptrdiff_t>(nrow),
+                            e.col_end(j), first);
                     }
                 }
             }
@@ -190,6 +190,10 @@ class StateMatrix : public Matrix<T, Layout>
     /// \post For \f$i = 1,\dots,N\f$, \f$Y_i = X_{a_i}\f$, where \f$Y_i\f$ is
     /// the \f$i\f$-th row of the new matrix and \f$X_j\f$ is the \f$j\f$-th
     /// row of the original matrix
+    ///
+    /// \details
+    /// No temporary storage is used. The storage is reallocated only if `n`
+    /// exceeds the current capacity.
     template <typename InputIter>
     void select(size_type n, InputIter index)
     {
@@ -244,27 +248,21 @@ class StateMatrix : public Matrix<T, Layout>
             return;
         }
 
-        InputIter idx = index;
-        if (n == size()) {
-            for (size_type j = 0; j != dim(); ++j) {
-                idx = index;
-                const value_type *src = this->col_data(j);
-                value_type *dst = this->col_data(j);
-                for (size_type i = 0; i != n; ++i, ++idx) {
-                    dst[i] = src[*idx];
-                }
-            }
-        } else {
-            Matrix<T, ColMajor> tmp(n, dim());
-            for (size_type j = 0; j != dim(); ++j) {
-                idx = index;
-                const value_type *src = this->col_data(j);
-                value_type *dst = tmp.col_data(j);
-                for (size_type i = 0; i != n; ++i, ++idx) {
-                    dst[i] = src[*idx];
-                }
+        if (n > size()) {
+            resize(n);
+        }
+
+        for (size_type j = 0; j != dim(); ++j) {
+            InputIter idx = index;
+            const value_type *src = this->col_data(j);
+            value_type *dst = this->col_data(j);
+            for (size_type i = 0; i != n; ++i, ++idx) {
+                dst[i] = src[*idx];
             }
-            Matrix<T, ColMajor>::operator=(std::move(tmp));
+        }
+
+        if (n < size()) {
+            resize(n);
         }
     }
 
@@ -307,7 +305,7 @@ class StateMatrix : public Matrix<T, Layout>
     void duplicate_dispatch(
         size_type src, size_type dst, col_major, std::false_type)
     {
-        duplicate_j<0>(this->row_data(src), this->col_data(dst), col_major(),
+        duplicate_j<0>(this->data() + src, this->data() + dst, col_major(),
             std::integral_constant<bool, 0 < Dim>());
     }
 
@@ -322,8 +320,8 @@ class StateMatrix : public Matrix<T, Layout>
         const value_type *src, value_type *dst, col_major, std::true_type)
     {
         dst[D * size()] = src[D * size()];
-        duplicate_j<D + 1>(
-            src, dst, std::integral_constant<bool, D + 1 < Dim>());
+        duplicate_j<D + 1>(src, dst, col_major(),
+            std::integral_constant<bool, D + 1 < Dim>());
     }
 }; // class StateMatrix
 
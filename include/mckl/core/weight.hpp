@@ -39,20 +39,185 @@
 
 namespace mckl {
 
+namespace internal {
+
+#if MCKL_USE_AVX512
+
+inline double weight_max(std::size_t n, const double *w)
+{
+    __m512d m0 = _mm512_set1_pd(-const_inf<double>());
+    __m512d m1 = m0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm512_max_pd(m0, _mm512_loadu_pd(w + i));
+        m1 = _mm512_max_pd(m1, _mm512_loadu_pd(w + i + 8));
+    }
+    double v = _mm512_reduce_max_pd(_mm512_max_pd(m0, m1));
+    for (; i != n; ++i) {
+        v = std::max(v, w[i]);
+    }
+
+    return v;
+}
+
+inline void weight_sum_sqr(
+    std::size_t n, const double *w, double &s, double &q)
+{
+    __m512d s0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd();
+    __m512d q0 = _mm512_setzero_pd();
+    __m512d q1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512d w0 = _mm512_loadu_pd(w + i);
+        const __m512d w1 = _mm512_loadu_pd(w + i + 8);
+        s0 = _mm512_add_pd(s0, w0);
+        s1 = _mm512_add_pd(s1, w1);
+        q0 = _mm512_fmadd_pd(w0, w0, q0);
+        q1 = _mm512_fmadd_pd(w1, w1, q1);
+    }
+    s += _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+    q += _mm512_reduce_add_pd(_mm512_add_pd(q0, q1));
+    for (; i != n; ++i) {
+        s += w[i];
+        q += w[i] * w[i];
+    }
+}
+
+#elif MCKL_USE_AVX2
+
+inline double weight_max(std::size_t n, const double *w)
+{
+    __m256d m0 = _mm256_set1_pd(-const_inf<double>());
+    __m256d m1 = m0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m0 = _mm256_max_pd(m0, _mm256_loadu_pd(w + i));
+        m1 = _mm256_max_pd(m1, _mm256_loadu_pd(w + i + 4));
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, _mm256_max_pd(m0, m1));
+    double v = std::max(std::max(t[0], t[1]), std::max(t[2], t[3]));
+    for (; i != n; ++i) {
+        v = std::max(v, w[i]);
+    }
+
+    return v;
+}
+
+inline void weight_sum_sqr(
+    std::size_t n, const double *w, double &s, double &q)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    __m256d q0 = _mm256_setzero_pd();
+    __m256d q1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d w0 = _mm256_loadu_pd(w + i);
+        const __m256d w1 = _mm256_loadu_pd(w + i + 4);
+        s0 = _mm256_add_pd(s0, w0);
+        s1 = _mm256_add_pd(s1, w1);
+#if MCKL_USE_FMA
+        q0 = _mm256_fmadd_pd(w0, w0, q0);
+        q1 = _mm256_fmadd_pd(w1, w1, q1);
+#else
+        q0 = _mm256_add_pd(q0, _mm256_mul_pd(w0, w0));
+        q1 = _mm256_add_pd(q1, _mm256_mul_pd(w1, w1));
+#endif
+    }
+    alignas(32) double t[4];
+    _mm256_store_pd(t, _mm256_add_pd(s0, s1));
+    s += (t[0] + t[1]) + (t[2] + t[3]);
+    _mm256_store_pd(t, _mm256_add_pd(q0, q1));
+    q += (t[0] + t[1]) + (t[2] + t[3]);
+    for (; i != n; ++i) {
+        s += w[i];
+        q += w[i] * w[i];
+    }
+}
+
+#else // MCKL_USE_AVX512
+
+inline double weight_max(std::size_t n, const double *w)
+{
+    double m[4] = {-const_inf<double>(), -const_inf<double>(),
+        -const_inf<double>(), -const_inf<double>()};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m[0] = std::max(m[0], w[i + 0]);
+        m[1] = std::max(m[1], w[i + 1]);
+        m[2] = std::max(m[2], w[i + 2]);
+        m[3] = std::max(m[3], w[i + 3]);
+    }
+    double v = std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+    for (; i != n; ++i) {
+        v = std::max(v, w[i]);
+    }
+
+    return v;
+}
+
+inline void weight_sum_sqr(
+    std::size_t n, const double *w, double &s, double &q)
+{
+    double t[4] = {0, 0, 0, 0};
+    double u[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        t[0] += w[i + 0];
+        t[1] += w[i + 1];
+        t[2] += w[i + 2];
+        t[3] += w[i + 3];
+        u[0] += w[i + 0] * w[i + 0];
+        u[1] += w[i + 1] * w[i + 1];
+        u[2] += w[i + 2] * w[i + 2];
+        u[3] += w[i + 3] * w[i + 3];
+    }
+    s += (t[0] + t[1]) + (t[2] + t[3]);
+    q += (u[0] + u[1]) + (u[2] + u[3]);
+    for (; i != n; ++i) {
+        s += w[i];
+        q += w[i] * w[i];
+    }
+}
+
+#endif // MCKL_USE_AVX512
+
+} // namespace internal
+
 /// \brief Weights of samples
 /// \ingroup Core
+///
+/// \details
+/// Normalization takes two passes over the weights. The first pass visits
+/// cache sized blocks, each of which is shifted by its own maximum (if on the
+/// log scale), exponentiated, and summed together with its squares while
+/// still in cache. The second pass rescales each block by its offset to the
+/// global maximum and the total. The member functions that take an
+/// additional argument `run` perform both passes in parallel. `run(n, work)`
+/// shall call `work(ibegin, iend)` on sub-ranges of \f$[0, n)\f$, possibly
+/// concurrently, such as `RunSMP<Backend>`. The results do not depend on how
+/// the range is split.
 class Weight
 {
   public:
     using size_type = std::size_t;
 
-    explicit Weight(size_type N = 0) : ess_(0), data_(N) { set_equal(); }
+    explicit Weight(size_type N = 0) : ess_(0), data_(N), alias_valid_(false)
+    {
+        set_equal();
+    }
 
     /// \brief Size of this Weight object
     size_type size() const { return data_.size(); }
 
     /// \brief Resize the Weight object
-    void resize(size_type N) { data_.resize(N); }
+    void resize(size_type N)
+    {
+        data_.resize(N);
+        alias_valid_ = false;
+    }
 
     /// \brief Reserve space
     void reserve(size_type N) { data_.reserve(N); }
@@ -60,9 +225,85 @@ class Weight
     /// \brief Shrink to fit
     void shrink_to_fit() { data_.shrink_to_fit(); }
 
+    /// \brief Move the weights to newly allocated memory
+    ///
+    /// \details
+    /// `copy(n, src, dst)` shall copy `n` elements from `src` to `dst`, where
+    /// `dst` points to memory not yet written to. The SMP backends use this
+    /// to place memory pages on the NUMA node of the threads that use them.
+    template <typename Copy>
+    void reallocate(Copy &&copy)
+    {
+        Vector<double> data(size());
+        copy(size(), const_cast<const double *>(data_.data()), data.data());
+        data_ = std::move(data);
+    }
+
     /// \brief Return the ESS of the particle system
     double ess() const { return ess_; }
 
+    /// \brief The conditional ESS of incremental weights
+    /// \f$v_i = \exp(\alpha l_i)\f$
+    ///
+    /// \details
+    /// Compute \f$N(\sum_i W_i v_i)^2 / \sum_i W_i v_i^2\f$, where \f$W_i\f$
+    /// are the current normalized weights, for each of the `m` exponents
+    /// `alpha[k] > 0`, and write the results to `r[k]`. All exponents are
+    /// evaluated in a single pass over cache sized blocks of the weights and
+    /// `first`, which points to \f$l_i\f$. The weights are not modified. If
+    /// all \f$l_i = -\infty\f$, the results are zero.
+    void cess(std::size_t m, const double *alpha, const double *first,
+        double *r) const
+    {
+        const size_type k = internal::BufferSize<double>::value;
+        const size_type N = size();
+        if (N == 0 || m == 0) {
+            std::fill_n(r, m, 0.0);
+            return;
+        }
+
+        const double *const w = data_.data();
+        const double lmax = internal::weight_max(N, first);
+        if (lmax == -const_inf<double>()) {
+            std::fill_n(r, m, 0.0);
+            return;
+        }
+
+        cess_buf_.resize(k * 3);
+        cess_acc_.resize(m * 2);
+        std::fill(cess_acc_.begin(), cess_acc_.end(), 0.0);
+        double *const d = cess_buf_.data();
+        double *const e = cess_buf_.data() + k;
+        double *const t = cess_buf_.data() + k * 2;
+        for (size_type i = 0; i < N; i += k) {
+            const size_type n = std::min(k, N - i);
+            const MCKL_BLAS_INT nb = static_cast<MCKL_BLAS_INT>(n);
+            sub(n, first + i, lmax, d);
+            for (std::size_t j = 0; j != m; ++j) {
+                ::mckl::mul(n, alpha[j], d, e);
+                exp(n, e, e);
+                ::mckl::mul(n, w + i, e, t);
+                cess_acc_[j * 2] += internal::cblas_ddot(nb, w + i, 1, e, 1);
+                cess_acc_[j * 2 + 1] += internal::cblas_ddot(nb, t, 1, e, 1);
+            }
+        }
+        for (std::size_t j = 0; j != m; ++j) {
+            const double s = cess_acc_[j * 2];
+            const double q = cess_acc_[j * 2 + 1];
+            r[j] = q > 0 ? N * s * s / q : 0;
+        }
+    }
+
+    /// \brief The conditional ESS of incremental weights
+    /// \f$v_i = \exp(\alpha l_i)\f$
+    double cess(double alpha, const double *first) const
+    {
+        double r = 0;
+        cess(1, &alpha, first, &r);
+
+        return r;
+    }
+
     /// \brief Pointer to data of the normalized weight
     const double *data() const { return data_.data(); }
 
@@ -78,6 +319,7 @@ class Weight
     {
         std::fill(data_.begin(), data_.end(), 1.0 / size());
         ess_ = static_cast<double>(size());
+        alias_valid_ = false;
     }
 
     /// \brief Set \f$W_i \propto w_i\f$
@@ -88,6 +330,14 @@ class Weight
         normalize(false);
     }
 
+    /// \brief Set \f$W_i \propto w_i\f$, normalized in parallel
+    template <typename InputIter, typename Run>
+    void set(InputIter first, Run &&run)
+    {
+        std::copy_n(first, size(), data_.begin());
+        normalize(false, run);
+    }
+
     /// \brief Set exact values of ESS and normalized weights
     ///
     /// \details
@@ -98,6 +348,7 @@ class Weight
     {
         ess_ = ess;
         std::copy_n(first, size(), data_.begin());
+        alias_valid_ = false;
     }
 
     /// \brief Set \f$W_i \propto W_i w_i\f$
@@ -120,6 +371,17 @@ class Weight
     /// \brief Set \f$W_i \propto W_i w_i\f$
     void mul(double *first) { mul(const_cast<const double *>(first)); }
 
+    /// \brief Set \f$W_i \propto W_i w_i\f$, normalized in parallel
+    template <typename Run>
+    void mul(const double *first, Run &&run)
+    {
+        double *const w = data_.data();
+        run(size(), [=](std::size_t ibegin, std::size_t iend) {
+            ::mckl::mul(iend - ibegin, first + ibegin, w + ibegin, w + ibegin);
+        });
+        normalize(false, run);
+    }
+
     /// \brief Set \f$\log W_i = v_i + \mathrm{const.}\f$
     template <typename InputIter>
     void set_log(InputIter first)
@@ -128,6 +390,15 @@ class Weight
         normalize(true);
     }
 
+    /// \brief Set \f$\log W_i = v_i + \mathrm{const.}\f$, normalized in
+    /// parallel
+    template <typename InputIter, typename Run>
+    void set_log(InputIter first, Run &&run)
+    {
+        std::copy_n(first, size(), data_.begin());
+        normalize(true, run);
+    }
+
     /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$
     template <typename InputIter>
     void add_log(InputIter first)
@@ -150,6 +421,20 @@ class Weight
     /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$
     void add_log(double *first) { add_log(const_cast<const double *>(first)); }
 
+    /// \brief Set \f$\log W_i = \log W_i + v_i + \mathrm{const.}\f$,
+    /// normalized in parallel
+    template <typename Run>
+    void add_log(const double *first, Run &&run)
+    {
+        double *const w = data_.data();
+        run(size(), [=](std::size_t ibegin, std::size_t iend) {
+            const std::size_t n = iend - ibegin;
+            log(n, w + ibegin, w + ibegin);
+            add(n, first + ibegin, w + ibegin, w + ibegin);
+        });
+        normalize(true, run);
+    }
+
     /// \brief Draw integer index in the range \f$[0, N)\f$ according to the
     /// weights
     template <typename RNGType>
@@ -160,6 +445,27 @@ class Weight
         return dist(rng, data_.begin(), data_.end(), true);
     }
 
+    /// \brief Draw integer index in the range \f$[0, N)\f$ according to the
+    /// weights, using an alias table
+    ///
+    /// \details
+    /// The alias table is constructed in \f$O(N)\f$ time by the first call
+    /// after the weights are changed, and reused by subsequent calls, each
+    /// taking constant time. See DiscreteAlias.
+    template <typename RNGType>
+    size_type draw_alias(RNGType &rng)
+    {
+        return alias()(rng);
+    }
+
+    /// \brief Draw `n` integer indices in the range \f$[0, N)\f$ according
+    /// to the weights, using an alias table
+    template <typename RNGType>
+    void draw_alias(RNGType &rng, std::size_t n, size_type *r)
+    {
+        alias()(rng, n, r);
+    }
+
     friend bool operator==(const Weight &w1, const Weight &w2)
     {
         return w1.ess_ == w2.ess_ && w1.data_ == w2.data_;
@@ -178,52 +484,90 @@ class Weight
   private:
     double ess_;
     Vector<double> data_;
+    Vector<double> block_;
+    mutable Vector<double> cess_buf_;
+    mutable Vector<double> cess_acc_;
+    DiscreteAlias<size_type> alias_;
+    bool alias_valid_;
 
-    template <typename InputIter>
-    double max_element(size_type n, InputIter first)
+    DiscreteAlias<size_type> &alias()
     {
-        using value_type =
-            typename std::iterator_traits<InputIter>::value_type;
-
-        value_type v = -const_inf<value_type>();
-        for (size_type i = 0; i != n; ++i, ++first) {
-            if (v < *first) {
-                v = *first;
-            }
+        if (!alias_valid_) {
+            alias_.assign(data_.begin(), data_.end());
+            alias_valid_ = true;
         }
 
-        return static_cast<double>(v);
+        return alias_;
     }
 
     void normalize(bool use_log)
     {
-        double *w = data_.data();
-        double accw = 0;
-        double essw = 0;
-        const double lmax = use_log ? max_element(size(), w) : 0;
-        const size_type k = internal::BufferSize<double>::value;
-        const size_type m = size() / k;
-        const size_type l = size() % k;
-        for (size_type i = 0; i != m; ++i, w += k) {
-            normalize(k, w, accw, essw, use_log, lmax);
-        }
-        normalize(l, w, accw, essw, use_log, lmax);
-        ::mckl::mul(size(), 1 / accw, data_.data(), data_.data());
-        ess_ = accw * accw / essw;
+        normalize(use_log,
+            [](std::size_t n, auto &&work) { work(std::size_t(0), n); });
     }
 
-    void normalize(size_type n, double *w, double &accw, double &essw,
-        bool use_log, double lmax)
+    template <typename Run>
+    void normalize(bool use_log, Run &&run)
     {
-        internal::size_check<MCKL_BLAS_INT>(n, "Weight::normalize");
+        alias_valid_ = false;
+        if (size() == 0) {
+            ess_ = 0;
+            return;
+        }
+
+        const size_type k = internal::BufferSize<double>::value;
+        const size_type N = size();
+        const size_type nblocks = (N + k - 1) / k;
+        block_.resize(nblocks * 3);
+        double *const w = data_.data();
+        double *const bmax = block_.data();
+        double *const bsum = bmax + nblocks;
+        double *const bsqr = bsum + nblocks;
+
+        // Pass 1: per block shift, exponentiation, sum and sum of squares
+        run(nblocks, [=](std::size_t bbegin, std::size_t bend) {
+            for (std::size_t b = bbegin; b != bend; ++b) {
+                double *const wb = w + b * k;
+                const std::size_t n = std::min(k, N - b * k);
+                bsum[b] = 0;
+                bsqr[b] = 0;
+                bmax[b] = use_log ? internal::weight_max(n, wb) : 0;
+                if (bmax[b] == -const_inf<double>()) {
+                    std::fill_n(wb, n, 0.0);
+                    continue;
+                }
+                if (use_log) {
+                    sub(n, wb, bmax[b], wb);
+                    exp(n, wb, wb);
+                }
+                internal::weight_sum_sqr(n, wb, bsum[b], bsqr[b]);
+            }
+        });
 
-        if (use_log) {
-            sub(n, w, lmax, w);
-            exp(n, w, w);
+        const double lmax = *std::max_element(bmax, bmax + nblocks);
+        double accw = 0;
+        double essw = 0;
+        for (size_type b = 0; b != nblocks; ++b) {
+            if (bmax[b] != -const_inf<double>()) {
+                const double c = std::exp(bmax[b] - lmax);
+                accw += bsum[b] * c;
+                essw += bsqr[b] * c * c;
+                bmax[b] = c;
+            } else {
+                bmax[b] = 0;
+            }
         }
-        accw = std::accumulate(w, w + n, accw);
-        essw +=
-            internal::cblas_ddot(static_cast<MCKL_BLAS_INT>(n), w, 1, w, 1);
+        ess_ = accw * accw / essw;
+
+        // Pass 2: rescale each block relative to the total
+        const double scale = 1 / accw;
+        run(nblocks, [=](std::size_t bbegin, std::size_t bend) {
+            for (std::size_t b = bbegin; b != bend; ++b) {
+                double *const wb = w + b * k;
+                const std::size_t n = std::min(k, N - b * k);
+                ::mckl::mul(n, bmax[b] * scale, wb, wb);
+            }
+        });
     }
 }; // class Weight
 
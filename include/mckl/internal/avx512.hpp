@@ -43,6 +43,186 @@
 
 MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
 
+namespace mckl {
+
+namespace internal {
+
+template <std::size_t I0, std::size_t I1, std::size_t I2, std::size_t I3,
+    std::size_t I4, std::size_t I5, std::size_t I6, std::size_t I7,
+    std::size_t N>
+MCKL_INLINE inline void transpose8x64_si512(std::array<__m512i, N> &s)
+{
+    __m512i t0 = _mm512_unpacklo_epi64(std::get<I0>(s), std::get<I1>(s));
+    __m512i t1 = _mm512_unpackhi_epi64(std::get<I0>(s), std::get<I1>(s));
+    __m512i t2 = _mm512_unpacklo_epi64(std::get<I2>(s), std::get<I3>(s));
+    __m512i t3 = _mm512_unpackhi_epi64(std::get<I2>(s), std::get<I3>(s));
+    __m512i t4 = _mm512_unpacklo_epi64(std::get<I4>(s), std::get<I5>(s));
+    __m512i t5 = _mm512_unpackhi_epi64(std::get<I4>(s), std::get<I5>(s));
+    __m512i t6 = _mm512_unpacklo_epi64(std::get<I6>(s), std::get<I7>(s));
+    __m512i t7 = _mm512_unpackhi_epi64(std::get<I6>(s), std::get<I7>(s));
+
+    __m512i u0 = _mm512_shuffle_i64x2(t0, t2, 0x88);
+    __m512i u1 = _mm512_shuffle_i64x2(t1, t3, 0x88);
+    __m512i u2 = _mm512_shuffle_i64x2(t0, t2, 0xDD);
+    __m512i u3 = _mm512_shuffle_i64x2(t1, t3, 0xDD);
+    __m512i u4 = _mm512_shuffle_i64x2(t4, t6, 0x88);
+    __m512i u5 = _mm512_shuffle_i64x2(t5, t7, 0x88);
+    __m512i u6 = _mm512_shuffle_i64x2(t4, t6, 0xDD);
+    __m512i u7 = _mm512_shuffle_i64x2(t5, t7, 0xDD);
+
+    std::get<I0>(s) = _mm512_shuffle_i64x2(u0, u4, 0x88);
+    std::get<I1>(s) = _mm512_shuffle_i64x2(u1, u5, 0x88);
+    std::get<I2>(s) = _mm512_shuffle_i64x2(u2, u6, 0x88);
+    std::get<I3>(s) = _mm512_shuffle_i64x2(u3, u7, 0x88);
+    std::get<I4>(s) = _mm512_shuffle_i64x2(u0, u4, 0xDD);
+    std::get<I5>(s) = _mm512_shuffle_i64x2(u1, u5, 0xDD);
+    std::get<I6>(s) = _mm512_shuffle_i64x2(u2, u6, 0xDD);
+    std::get<I7>(s) = _mm512_shuffle_i64x2(u3, u7, 0xDD);
+}
+
+MCKL_INLINE inline void transpose8x64_load_si512(std::array<__m512i, 8> &s)
+{
+    transpose8x64_si512<0, 1, 2, 3, 4, 5, 6, 7>(s);
+}
+
+MCKL_INLINE inline void transpose8x64_store_si512(std::array<__m512i, 8> &s)
+{
+    transpose8x64_si512<0, 1, 2, 3, 4, 5, 6, 7>(s);
+}
+
+MCKL_INLINE inline void transpose8x64_load_si512(std::array<__m512i, 16> &s)
+{
+    std::array<__m512i, 16> t(s);
+    std::get<0x0>(s) = std::get<0x0>(t);
+    std::get<0x1>(s) = std::get<0x2>(t);
+    std::get<0x2>(s) = std::get<0x4>(t);
+    std::get<0x3>(s) = std::get<0x6>(t);
+    std::get<0x4>(s) = std::get<0x8>(t);
+    std::get<0x5>(s) = std::get<0xA>(t);
+    std::get<0x6>(s) = std::get<0xC>(t);
+    std::get<0x7>(s) = std::get<0xE>(t);
+    std::get<0x8>(s) = std::get<0x1>(t);
+    std::get<0x9>(s) = std::get<0x3>(t);
+    std::get<0xA>(s) = std::get<0x5>(t);
+    std::get<0xB>(s) = std::get<0x7>(t);
+    std::get<0xC>(s) = std::get<0x9>(t);
+    std::get<0xD>(s) = std::get<0xB>(t);
+    std::get<0xE>(s) = std::get<0xD>(t);
+    std::get<0xF>(s) = std::get<0xF>(t);
+
+    transpose8x64_si512<0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7>(s);
+    transpose8x64_si512<0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF>(s);
+}
+
+MCKL_INLINE inline void transpose8x64_store_si512(std::array<__m512i, 16> &s)
+{
+    transpose8x64_si512<0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7>(s);
+    transpose8x64_si512<0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF>(s);
+
+    std::array<__m512i, 16> t(s);
+    std::get<0x0>(s) = std::get<0x0>(t);
+    std::get<0x1>(s) = std::get<0x8>(t);
+    std::get<0x2>(s) = std::get<0x1>(t);
+    std::get<0x3>(s) = std::get<0x9>(t);
+    std::get<0x4>(s) = std::get<0x2>(t);
+    std::get<0x5>(s) = std::get<0xA>(t);
+    std::get<0x6>(s) = std::get<0x3>(t);
+    std::get<0x7>(s) = std::get<0xB>(t);
+    std::get<0x8>(s) = std::get<0x4>(t);
+    std::get<0x9>(s) = std::get<0xC>(t);
+    std::get<0xA>(s) = std::get<0x5>(t);
+    std::get<0xB>(s) = std::get<0xD>(t);
+    std::get<0xC>(s) = std::get<0x6>(t);
+    std::get<0xD>(s) = std::get<0xE>(t);
+    std::get<0xE>(s) = std::get<0x7>(t);
+    std::get<0xF>(s) = std::get<0xF>(t);
+}
+
+MCKL_INLINE inline void transpose16x32_si512(std::array<__m512i, 16> &s)
+{
+    __m512i t0 = _mm512_unpacklo_epi32(std::get<0x0>(s), std::get<0x1>(s));
+    __m512i t1 = _mm512_unpackhi_epi32(std::get<0x0>(s), std::get<0x1>(s));
+    __m512i t2 = _mm512_unpacklo_epi32(std::get<0x2>(s), std::get<0x3>(s));
+    __m512i t3 = _mm512_unpackhi_epi32(std::get<0x2>(s), std::get<0x3>(s));
+    __m512i t4 = _mm512_unpacklo_epi32(std::get<0x4>(s), std::get<0x5>(s));
+    __m512i t5 = _mm512_unpackhi_epi32(std::get<0x4>(s), std::get<0x5>(s));
+    __m512i t6 = _mm512_unpacklo_epi32(std::get<0x6>(s), std::get<0x7>(s));
+    __m512i t7 = _mm512_unpackhi_epi32(std::get<0x6>(s), std::get<0x7>(s));
+    __m512i t8 = _mm512_unpacklo_epi32(std::get<0x8>(s), std::get<0x9>(s));
+    __m512i t9 = _mm512_unpackhi_epi32(std::get<0x8>(s), std::get<0x9>(s));
+    __m512i tA = _mm512_unpacklo_epi32(std::get<0xA>(s), std::get<0xB>(s));
+    __m512i tB = _mm512_unpackhi_epi32(std::get<0xA>(s), std::get<0xB>(s));
+    __m512i tC = _mm512_unpacklo_epi32(std::get<0xC>(s), std::get<0xD>(s));
+    __m512i tD = _mm512_unpackhi_epi32(std::get<0xC>(s), std::get<0xD>(s));
+    __m512i tE = _mm512_unpacklo_epi32(std::get<0xE>(s), std::get<0xF>(s));
+    __m512i tF = _mm512_unpackhi_epi32(std::get<0xE>(s), std::get<0xF>(s));
+
+    __m512i u0 = _mm512_unpacklo_epi64(t0, t2);
+    __m512i u1 = _mm512_unpackhi_epi64(t0, t2);
+    __m512i u2 = _mm512_unpacklo_epi64(t1, t3);
+    __m512i u3 = _mm512_unpackhi_epi64(t1, t3);
+    __m512i u4 = _mm512_unpacklo_epi64(t4, t6);
+    __m512i u5 = _mm512_unpackhi_epi64(t4, t6);
+    __m512i u6 = _mm512_unpacklo_epi64(t5, t7);
+    __m512i u7 = _mm512_unpackhi_epi64(t5, t7);
+    __m512i u8 = _mm512_unpacklo_epi64(t8, tA);
+    __m512i u9 = _mm512_unpackhi_epi64(t8, tA);
+    __m512i uA = _mm512_unpacklo_epi64(t9, tB);
+    __m512i uB = _mm512_unpackhi_epi64(t9, tB);
+    __m512i uC = _mm512_unpacklo_epi64(tC, tE);
+    __m512i uD = _mm512_unpackhi_epi64(tC, tE);
+    __m512i uE = _mm512_unpacklo_epi64(tD, tF);
+    __m512i uF = _mm512_unpackhi_epi64(tD, tF);
+
+    __m512i v0 = _mm512_shuffle_i32x4(u0, u4, 0x88);
+    __m512i v1 = _mm512_shuffle_i32x4(u0, u4, 0xDD);
+    __m512i v2 = _mm512_shuffle_i32x4(u8, uC, 0x88);
+    __m512i v3 = _mm512_shuffle_i32x4(u8, uC, 0xDD);
+    __m512i v4 = _mm512_shuffle_i32x4(u1, u5, 0x88);
+    __m512i v5 = _mm512_shuffle_i32x4(u1, u5, 0xDD);
+    __m512i v6 = _mm512_shuffle_i32x4(u9, uD, 0x88);
+    __m512i v7 = _mm512_shuffle_i32x4(u9, uD, 0xDD);
+    __m512i v8 = _mm512_shuffle_i32x4(u2, u6, 0x88);
+    __m512i v9 = _mm512_shuffle_i32x4(u2, u6, 0xDD);
+    __m512i vA = _mm512_shuffle_i32x4(uA, uE, 0x88);
+    __m512i vB = _mm512_shuffle_i32x4(uA, uE, 0xDD);
+    __m512i vC = _mm512_shuffle_i32x4(u3, u7, 0x88);
+    __m512i vD = _mm512_shuffle_i32x4(u3, u7, 0xDD);
+    __m512i vE = _mm512_shuffle_i32x4(uB, uF, 0x88);
+    __m512i vF = _mm512_shuffle_i32x4(uB, uF, 0xDD);
+
+    std::get<0x0>(s) = _mm512_shuffle_i32x4(v0, v2, 0x88);
+    std::get<0x4>(s) = _mm512_shuffle_i32x4(v1, v3, 0x88);
+    std::get<0x8>(s) = _mm512_shuffle_i32x4(v0, v2, 0xDD);
+    std::get<0xC>(s) = _mm512_shuffle_i32x4(v1, v3, 0xDD);
+    std::get<0x1>(s) = _mm512_shuffle_i32x4(v4, v6, 0x88);
+    std::get<0x5>(s) = _mm512_shuffle_i32x4(v5, v7, 0x88);
+    std::get<0x9>(s) = _mm512_shuffle_i32x4(v4, v6, 0xDD);
+    std::get<0xD>(s) = _mm512_shuffle_i32x4(v5, v7, 0xDD);
+    std::get<0x2>(s) = _mm512_shuffle_i32x4(v8, vA, 0x88);
+    std::get<0x6>(s) = _mm512_shuffle_i32x4(v9, vB, 0x88);
+    std::get<0xA>(s) = _mm512_shuffle_i32x4(v8, vA, 0xDD);
+    std::get<0xE>(s) = _mm512_shuffle_i32x4(v9, vB, 0xDD);
+    std::get<0x3>(s) = _mm512_shuffle_i32x4(vC, vE, 0x88);
+    std::get<0x7>(s) = _mm512_shuffle_i32x4(vD, vF, 0x88);
+    std::get<0xB>(s) = _mm512_shuffle_i32x4(vC, vE, 0xDD);
+    std::get<0xF>(s) = _mm512_shuffle_i32x4(vD, vF, 0xDD);
+}
+
+MCKL_INLINE inline void transpose16x32_load_si512(std::array<__m512i, 16> &s)
+{
+    transpose16x32_si512(s);
+}
+
+MCKL_INLINE inline void transpose16x32_store_si512(std::array<__m512i, 16> &s)
+{
+    transpose16x32_si512(s);
+}
+
+} // namespace internal
+
+} // namespace mckl
+
 MCKL_POP_GCC_WARNING
 
 #endif // MCKL_INTERNAL_AVX512_HPP
@@ -79,6 +79,26 @@
 #define MCKL_POP_GCC_WARNING
 #endif
 
+// Compile the functions defined between MCKL_PUSH_TARGET and MCKL_POP_TARGET
+// for an instruction set wider than the one the translation unit targets
+#if defined(MCKL_CLANG)
+#define MCKL_HAS_TARGET_PRAGMA 1
+#define MCKL_PUSH_TARGET(isa)                                                 \
+    MCKL_PRAGMA(clang attribute push(                                         \
+        __attribute__((target(isa))), apply_to = function))
+#define MCKL_POP_TARGET MCKL_PRAGMA(clang attribute pop)
+#elif defined(MCKL_GCC)
+#define MCKL_HAS_TARGET_PRAGMA 1
+#define MCKL_PUSH_TARGET(isa)                                                 \
+    MCKL_PRAGMA(GCC push_options)                                             \
+    MCKL_PRAGMA(GCC target(isa))
+#define MCKL_POP_TARGET MCKL_PRAGMA(GCC pop_options)
+#else
+#define MCKL_HAS_TARGET_PRAGMA 0
+#define MCKL_PUSH_TARGET(isa)
+#define MCKL_POP_TARGET
+#endif
+
 #ifdef MCKL_INTEL
 #define MCKL_PUSH_INTEL_WARNING(wid)                                          \
     MCKL_PRAGMA(warning(push))                                                \
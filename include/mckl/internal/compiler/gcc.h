@@ -99,7 +99,6 @@
 #define MCKL_HAS_AVX512 1
 #endif
 #endif
-#endif
 
 #ifdef __AES__
 #ifndef MCKL_HAS_AESNI
@@ -100,6 +100,16 @@
 #define MCKL_HAS_POSIX 0
 #endif
 
+/// \brief Pinning threads to processors is supported
+/// \ingroup Config
+#ifndef MCKL_HAS_THREAD_AFFINITY
+#if defined(__linux__) && !defined(MCKL_OPENCL)
+#define MCKL_HAS_THREAD_AFFINITY 1
+#else
+#define MCKL_HAS_THREAD_AFFINITY 0
+#endif
+#endif
+
 // Optional libraries
 
 #ifndef MCKL_USE_ASM_LIBRARY
@@ -114,6 +124,25 @@
 #define MCKL_USE_ASM_VMF 0
 #endif
 
+/// \brief Select SIMD kernels at runtime by the features of the CPU
+/// \ingroup Config
+///
+/// \details
+/// If enabled, the kernels used by RNGs, U01 conversions and vectorized math
+/// functions are chosen once, on first use, by querying CPUID instead of by
+/// the instruction set the program is compiled for. A binary compiled for a
+/// baseline target can then use AVX2, AVX-512 and BMI2 kernels when the host
+/// supports them, and falls back to the portable implementations otherwise.
+///
+/// The ASM library kernels are dispatched if `MCKL_USE_ASM_LIBRARY` is
+/// enabled. The header-only Threefry and U01 kernels are dispatched by
+/// compiling them for each instruction set with target pragmas, which
+/// requires GCC or Clang.
+#ifndef MCKL_USE_RUNTIME_DISPATCH
+#define MCKL_USE_RUNTIME_DISPATCH                                             \
+    (MCKL_HAS_X86_64 && (MCKL_USE_ASM_LIBRARY || MCKL_HAS_TARGET_PRAGMA))
+#endif
+
 #ifndef MCKL_HAS_OMP
 #ifdef _OPENMP
 #define MCKL_HAS_OMP 1
@@ -0,0 +1,143 @@
+//============================================================================
+// MCKL/include/mckl/internal/cpuid.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_INTERNAL_CPUID_HPP
+#define MCKL_INTERNAL_CPUID_HPP
+
+#include <mckl/internal/config.h>
+
+#include <array>
+
+namespace mckl {
+
+namespace internal {
+
+/// \brief Instruction set extensions supported by the host processor
+/// \ingroup Config
+///
+/// \details
+/// The features are queried with the `cpuid` instruction once, on first use,
+/// and cached for the lifetime of the program. Extensions whose register
+/// state is not enabled by the operating system (as reported by `xgetbv`) are
+/// reported as unsupported.
+class CPUID
+{
+  public:
+    static bool sse2() { return instance().sse2_; }
+    static bool aesni() { return instance().aesni_; }
+    static bool avx2() { return instance().avx2_; }
+    static bool fma() { return instance().fma_; }
+    static bool bmi2() { return instance().bmi2_; }
+
+    /// \brief AVX-512 F, CD, BW, DQ and VL, same as `MCKL_HAS_AVX512`
+    static bool avx512() { return instance().avx512_; }
+
+  private:
+    bool sse2_;
+    bool aesni_;
+    bool avx2_;
+    bool fma_;
+    bool bmi2_;
+    bool avx512_;
+
+    CPUID()
+        : sse2_(false)
+        , aesni_(false)
+        , avx2_(false)
+        , fma_(false)
+        , bmi2_(false)
+        , avx512_(false)
+    {
+#if MCKL_HAS_X86
+        const std::array<unsigned, 4> leaf0 = cpuid(0, 0);
+        const unsigned max = leaf0[0];
+        if (max < 1)
+            return;
+
+        const std::array<unsigned, 4> leaf1 = cpuid(1, 0);
+        const std::array<unsigned, 4> leaf7 =
+            max < 7 ? std::array<unsigned, 4>{{0, 0, 0, 0}} : cpuid(7, 0);
+
+        const bool osxsave = test(leaf1[2], 27);
+        const unsigned long long xcr0 = osxsave ? xgetbv() : 0;
+        const bool ymm = (xcr0 & 0x06) == 0x06;
+        const bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+        sse2_ = test(leaf1[3], 26);
+        aesni_ = sse2_ && test(leaf1[2], 25);
+        avx2_ = ymm && test(leaf1[2], 28) && test(leaf7[1], 5);
+        fma_ = avx2_ && test(leaf1[2], 12);
+        bmi2_ = test(leaf7[1], 3) && test(leaf7[1], 8);
+        avx512_ = zmm && avx2_ && test(leaf7[1], 16) && test(leaf7[1], 28) &&
+            test(leaf7[1], 30) && test(leaf7[1], 17) && test(leaf7[1], 31);
+#endif // MCKL_HAS_X86
+    }
+
+    CPUID(const CPUID &) = delete;
+    CPUID &operator=(const CPUID &) = delete;
+
+    static const CPUID &instance()
+    {
+        static const CPUID cpu;
+
+        return cpu;
+    }
+
+    static bool test(unsigned reg, int bit) { return (reg >> bit) & 1; }
+
+#if MCKL_HAS_X86
+    static std::array<unsigned, 4> cpuid(unsigned eax, unsigned ecx)
+    {
+        std::array<unsigned, 4> reg;
+        __asm__ volatile("cpuid"
+                         : "=a"(reg[0]), "=b"(reg[1]), "=c"(reg[2]),
+                         "=d"(reg[3])
+                         : "a"(eax), "c"(ecx));
+
+        return reg;
+    }
+
+    static unsigned long long xgetbv()
+    {
+        unsigned a = 0;
+        unsigned d = 0;
+        __asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+
+        return (static_cast<unsigned long long>(d) << 32) + a;
+    }
+#endif // MCKL_HAS_X86
+}; // class CPUID
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_INTERNAL_CPUID_HPP
@@ -35,6 +35,7 @@
 #include <mckl/internal/config.h>
 
 #include <mckl/internal/assert.hpp>
+#include <mckl/internal/cpuid.hpp>
 #include <mckl/math/constants.hpp>
 #include <mckl/math/erf.hpp>
 
@@ -327,33 +328,61 @@ inline void modf(std::size_t n, const double *a, double *y, double *z)
 
 #endif // MCKL_USE_MKL_VML
 
-#if MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_VMF && MCKL_USE_FMA
+#if MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_VMF &&                               \
+    (MCKL_USE_FMA || MCKL_USE_RUNTIME_DISPATCH)
 
-#define MCKL_DEFINE_MATH_VMF_ASM_1S(func)                                     \
-    inline void func(std::size_t n, const float *a, float *y)                 \
+#if MCKL_USE_RUNTIME_DISPATCH
+
+#define MCKL_DEFINE_MATH_VMF_ASM_1(func, T, prefix)                           \
+    inline void func(std::size_t n, const T *a, T *y)                         \
     {                                                                         \
-        ::mckl_vs_##func(n, a, y);                                            \
+        if (internal::CPUID::fma()) {                                         \
+            ::mckl_##prefix##_##func(n, a, y);                                \
+        } else {                                                              \
+            for (std::size_t i = 0; i != n; ++i)                              \
+                y[i] = std::func(a[i]);                                       \
+        }                                                                     \
     }
 
-#define MCKL_DEFINE_MATH_VMF_ASM_1D(func)                                     \
-    inline void func(std::size_t n, const double *a, double *y)               \
+#define MCKL_DEFINE_MATH_VMF_ASM_2(func, T, prefix)                           \
+    inline void func(std::size_t n, const T *a, const T *b, T *y)             \
     {                                                                         \
-        ::mckl_vd_##func(n, a, y);                                            \
+        if (internal::CPUID::fma()) {                                         \
+            ::mckl_##prefix##_##func(n, a, b, y);                             \
+        } else {                                                              \
+            for (std::size_t i = 0; i != n; ++i)                              \
+                y[i] = std::func(a[i], b[i]);                                 \
+        }                                                                     \
     }
 
-#define MCKL_DEFINE_MATH_VMF_ASM_2S(func)                                     \
-    inline void func(std::size_t n, const float *a, const float *b, float *y) \
+#else // MCKL_USE_RUNTIME_DISPATCH
+
+#define MCKL_DEFINE_MATH_VMF_ASM_1(func, T, prefix)                           \
+    inline void func(std::size_t n, const T *a, T *y)                         \
     {                                                                         \
-        ::mckl_vs_##func(n, a, b, y);                                         \
+        ::mckl_##prefix##_##func(n, a, y);                                    \
     }
 
-#define MCKL_DEFINE_MATH_VMF_ASM_2D(func)                                     \
-    inline void func(                                                         \
-        std::size_t n, const double *a, const double *b, double *y)           \
+#define MCKL_DEFINE_MATH_VMF_ASM_2(func, T, prefix)                           \
+    inline void func(std::size_t n, const T *a, const T *b, T *y)             \
     {                                                                         \
-        ::mckl_vd_##func(n, a, b, y);                                         \
+        ::mckl_##prefix##_##func(n, a, b, y);                                 \
     }
 
+#endif // MCKL_USE_RUNTIME_DISPATCH
+
+#define MCKL_DEFINE_MATH_VMF_ASM_1S(func)                                     \
+    MCKL_DEFINE_MATH_VMF_ASM_1(func, float, vs)
+
+#define MCKL_DEFINE_MATH_VMF_ASM_1D(func)                                     \
+    MCKL_DEFINE_MATH_VMF_ASM_1(func, double, vd)
+
+#define MCKL_DEFINE_MATH_VMF_ASM_2S(func)                                     \
+    MCKL_DEFINE_MATH_VMF_ASM_2(func, float, vs)
+
+#define MCKL_DEFINE_MATH_VMF_ASM_2D(func)                                     \
+    MCKL_DEFINE_MATH_VMF_ASM_2(func, double, vd)
+
 namespace mckl {
 
 #if !MCKL_USE_MKL_VML
@@ -380,6 +409,15 @@ MCKL_DEFINE_MATH_VMF_ASM_1D(sin)
 
 inline void sincos(std::size_t n, const double *a, double *y, double *z)
 {
+#if MCKL_USE_RUNTIME_DISPATCH
+    if (!internal::CPUID::fma()) {
+        for (std::size_t i = 0; i != n; ++i) {
+            y[i] = std::sin(a[i]);
+            z[i] = std::cos(a[i]);
+        }
+        return;
+    }
+#endif
     ::mckl_vd_sincos(n, a, y, z);
 }
 
@@ -395,111 +433,108 @@ MCKL_DEFINE_MATH_VMF_ASM_1D(log2)
 
 } // namespace mckl
 
-#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_VMF && MCKL_USE_FMA
+#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_VMF &&
+       // (MCKL_USE_FMA || MCKL_USE_RUNTIME_DISPATCH)
 
 #if MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_FMA
 
+#if MCKL_USE_RUNTIME_DISPATCH
+#define MCKL_MATH_FMA_ASM(op, suffix)                                         \
+    (internal::CPUID::avx512() ? ::mckl_##op##512_##suffix :                  \
+                                 ::mckl_##op##_##suffix)
+#elif MCKL_USE_AVX512
+#define MCKL_MATH_FMA_ASM(op, suffix) ::mckl_##op##512_##suffix
+#else
+#define MCKL_MATH_FMA_ASM(op, suffix) ::mckl_##op##_##suffix
+#endif
+
 #define MCKL_DEFINE_MATH_FMA_FMA(op, name)                                    \
     inline void name(std::size_t n, const float *a, const float *b,           \
         const float *c, float *y)                                             \
     {                                                                         \
-        ::mckl_##op##_vvv_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vvv_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const float *a, const float *b, float c, float *y)     \
     {                                                                         \
-        ::mckl_##op##_vvs_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vvs_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const float *a, float b, const float *c, float *y)     \
     {                                                                         \
-        ::mckl_##op##_vsv_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vsv_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, float a, const float *b, const float *c, float *y)     \
     {                                                                         \
-        ::mckl_##op##_svv_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, svv_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, float a, float b, const float *c, float *y)            \
     {                                                                         \
-        ::mckl_##op##_ssv_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, ssv_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, float a, const float *b, float c, float *y)            \
     {                                                                         \
-        ::mckl_##op##_svs_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, svs_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const float *a, float b, float c, float *y)            \
     {                                                                         \
-        ::mckl_##op##_vss_ps(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vss_ps)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(std::size_t n, const double *a, const double *b,         \
         const double *c, double *y)                                           \
     {                                                                         \
-        ::mckl_##op##_vvv_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vvv_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const double *a, const double *b, double c, double *y) \
     {                                                                         \
-        ::mckl_##op##_vvs_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vvs_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const double *a, double b, const double *c, double *y) \
     {                                                                         \
-        ::mckl_##op##_vsv_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vsv_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, double a, const double *b, const double *c, double *y) \
     {                                                                         \
-        ::mckl_##op##_svv_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, svv_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, double a, double b, const double *c, double *y)        \
     {                                                                         \
-        ::mckl_##op##_ssv_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, ssv_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, double a, const double *b, double c, double *y)        \
     {                                                                         \
-        ::mckl_##op##_svs_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, svs_pd)(n, a, b, c, y);                         \
     }                                                                         \
                                                                               \
     inline void name(                                                         \
         std::size_t n, const double *a, double b, double c, double *y)        \
     {                                                                         \
-        ::mckl_##op##_vss_pd(n, a, b, c, y);                                  \
+        MCKL_MATH_FMA_ASM(op, vss_pd)(n, a, b, c, y);                         \
     }
 
 namespace mckl {
 
-#if MCKL_USE_AVX512
-
-MCKL_DEFINE_MATH_FMA_FMA(fmadd512, muladd)
-MCKL_DEFINE_MATH_FMA_FMA(fmsub512, mulsub)
-MCKL_DEFINE_MATH_FMA_FMA(fnmadd512, nmuladd)
-MCKL_DEFINE_MATH_FMA_FMA(fnmsub512, nmulsub)
-
-MCKL_DEFINE_MATH_FMA_FMA(fmadd512, fmadd)
-MCKL_DEFINE_MATH_FMA_FMA(fmsub512, fmsub)
-MCKL_DEFINE_MATH_FMA_FMA(fnmadd512, fnmadd)
-MCKL_DEFINE_MATH_FMA_FMA(fnmsub512, fnmsub)
-
-#else // MCKL_USE_AVX512
-
 MCKL_DEFINE_MATH_FMA_FMA(fmadd, muladd)
 MCKL_DEFINE_MATH_FMA_FMA(fmsub, mulsub)
 MCKL_DEFINE_MATH_FMA_FMA(fnmadd, nmuladd)
@@ -510,8 +545,6 @@ MCKL_DEFINE_MATH_FMA_FMA(fmsub, fmsub)
 MCKL_DEFINE_MATH_FMA_FMA(fnmadd, fnmadd)
 MCKL_DEFINE_MATH_FMA_FMA(fnmsub, fnmsub)
 
-#endif // MCKL_USE_AVX512
-
 } // namespace mckl
 
 #endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_FMA
@@ -0,0 +1,309 @@
+//============================================================================
+// MCKL/include/mckl/random/binomial_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_BINOMIAL_DISTRIBUTION_HPP
+#define MCKL_RANDOM_BINOMIAL_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/u01_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename IntType>
+inline bool binomial_distribution_check_param(IntType t, double p)
+{
+    return t >= 0 && p >= 0 && p <= 1;
+}
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Constants of the inversion and the BTRD algorithms
+///
+/// \details
+/// The BTRD (transformed rejection with decomposition) algorithm is that of
+/// Hormann (1993), The generation of binomial random variates, Journal of
+/// Statistical Computation and Simulation, 46, 101-110. It is used if
+/// \f$t\min(p, 1 - p)\f$ is not less than ten. The success probability is
+/// replaced by \f$1 - p\f$ if \f$p > 1/2\f$, and the result by \f$t - k\f$.
+class BinomialDistributionConstant
+{
+  public:
+    BinomialDistributionConstant(double t = 1, double p = 0.5)
+        : t_(t), flip_(p > 0.5)
+    {
+        p = std::min(p, 1 - p);
+        const double q = 1 - p;
+        trivial_ = !(t > 0 && p > 0);
+        inversion_ = t * p < 10;
+        m_ = a_ = b_ = c_ = alpha_ = vr_ = urvr_ = lfm_ = lr_ = 0;
+        r_ = p / q;
+        if (trivial_) {
+            return;
+        }
+
+        if (inversion_) {
+            // Inversion constants
+            c_ = (t + 1) * r_;
+            b_ = std::pow(q, t);
+            return;
+        }
+
+        const double spq = std::sqrt(t * p * q);
+        m_ = std::floor((t + 1) * p);
+        b_ = 1.15 + 2.53 * spq;
+        a_ = -0.0873 + 0.0248 * b_ + 0.01 * p;
+        c_ = t * p + 0.5;
+        alpha_ = (2.83 + 5.1 / b_) * spq;
+        vr_ = 0.92 - 4.2 / b_;
+        urvr_ = 0.86 * vr_;
+        lfm_ = std::lgamma(m_ + 1) + std::lgamma(t - m_ + 1);
+        lr_ = std::log(r_);
+    }
+
+    bool trivial() const { return trivial_; }
+    bool inversion() const { return inversion_; }
+    double a() const { return a_; }
+    double b() const { return b_; }
+    double c() const { return c_; }
+    double vr() const { return vr_; }
+    double urvr() const { return urvr_; }
+
+    /// \brief Transform a result for the success probability \f$p \le 1/2\f$
+    double result(double k) const { return flip_ ? t_ - k : k; }
+
+    /// \brief The inversion from a standard uniform random number
+    double invert(double u) const
+    {
+        double k = 0;
+        double f = b_;
+        while (u > f && k < t_) {
+            u -= f;
+            k += 1;
+            f *= c_ / k - r_;
+        }
+
+        return k;
+    }
+
+    /// \brief The complete BTRD algorithm
+    template <typename RNGType>
+    double btrd(RNGType &rng) const
+    {
+        U01OODistribution<double> u01;
+        double k = 0;
+        while (!btrd(rng, u01(rng), k)) {
+        }
+
+        return k;
+    }
+
+    /// \brief One trial of the BTRD algorithm given the first uniform random
+    /// number `v`, return if `k` is accepted
+    template <typename RNGType>
+    bool btrd(RNGType &rng, double v, double &k) const
+    {
+        U01OODistribution<double> u01;
+        double u = 0;
+        if (v <= urvr_) {
+            u = v / vr_ - 0.43;
+            k = std::floor((2 * a_ / (0.5 - std::abs(u)) + b_) * u + c_);
+            return true;
+        }
+        if (v >= vr_) {
+            u = u01(rng) - 0.5;
+        } else {
+            u = v / vr_ - 0.93;
+            u = (u < 0 ? -0.5 : 0.5) - u;
+            v = u01(rng) * vr_;
+        }
+        const double us = 0.5 - std::abs(u);
+        k = std::floor((2 * a_ / us + b_) * u + c_);
+        if (k < 0 || k > t_) {
+            return false;
+        }
+        v *= alpha_ / (a_ / (us * us) + b_);
+
+        return std::log(v) <= lfm_ - std::lgamma(k + 1) -
+            std::lgamma(t_ - k + 1) + (k - m_) * lr_;
+    }
+
+    friend bool operator==(const BinomialDistributionConstant &c1,
+        const BinomialDistributionConstant &c2)
+    {
+        MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+        MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+        return c1.t_ == c2.t_ && c1.flip_ == c2.flip_ && c1.r_ == c2.r_;
+        MCKL_POP_CLANG_WARNING
+        MCKL_POP_INTEL_WARNING
+    }
+
+  private:
+    double t_;
+    bool flip_;
+    bool trivial_;
+    bool inversion_;
+    double m_;
+    double r_;
+    double a_;
+    double b_;
+    double c_;
+    double alpha_;
+    double vr_;
+    double urvr_;
+    double lfm_;
+    double lr_;
+}; // class BinomialDistributionConstant
+MCKL_POP_CLANG_WARNING
+
+template <std::size_t K, typename IntType, typename RNGType>
+inline void binomial_distribution_impl(
+    RNGType &rng, std::size_t n, IntType *r, IntType t, double p)
+{
+    const BinomialDistributionConstant constant(static_cast<double>(t), p);
+    if (constant.trivial()) {
+        std::fill_n(r, n, ftoi<IntType>(constant.result(0)));
+        return;
+    }
+
+    alignas(MCKL_ALIGNMENT) std::array<double, K * 3> s;
+    double *const v = s.data();
+    if (constant.inversion()) {
+        u01_co_distribution(rng, n, v);
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = ftoi<IntType>(constant.result(constant.invert(v[i])));
+        }
+        return;
+    }
+
+    // The first step of BTRD, which accepts 86% of the proposals
+    double *const u = s.data() + n;
+    double *const k = s.data() + n * 2;
+    u01_oo_distribution(rng, n, v);
+    mul(n, 1 / constant.vr(), v, u);
+    sub(n, u, 0.43, u);
+    abs(n, u, k);
+    sub(n, 0.5, k, k);
+    div(n, 2 * constant.a(), k, k);
+    add(n, k, constant.b(), k);
+    mul(n, k, u, k);
+    add(n, k, constant.c(), k);
+    floor(n, k, k);
+    const double urvr = constant.urvr();
+    for (std::size_t i = 0; i != n; ++i) {
+        if (v[i] > urvr && !constant.btrd(rng, v[i], k[i])) {
+            k[i] = constant.btrd(rng);
+        }
+        r[i] = ftoi<IntType>(constant.result(k[i]));
+    }
+}
+
+} // namespace internal
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
+    Binomial, binomial, IntType, IntType, t, double, p)
+
+/// \brief Binomial distribution
+/// \ingroup Distribution
+///
+/// \details
+/// It is generated by inversion if \f$t\min(p, 1 - p) < 10\f$ and otherwise by
+/// the BTRD algorithm, whose first step is vectorized in the batch generation
+template <typename IntType>
+class BinomialDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_INT_TYPE(Binomial, 16)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_2(
+        Binomial, binomial, IntType, result_type, t, 1, double, p, 0.5)
+
+  public:
+    result_type min() const { return 0; }
+
+    result_type max() const { return t(); }
+
+    void reset()
+    {
+        constant_ = internal::BinomialDistributionConstant(
+            static_cast<double>(t()), p());
+    }
+
+  private:
+    internal::BinomialDistributionConstant constant_;
+
+    bool is_equal(const distribution_type &) const { return true; }
+
+    template <typename CharT, typename Traits>
+    void ostream(std::basic_ostream<CharT, Traits> &) const
+    {
+    }
+
+    template <typename CharT, typename Traits>
+    void istream(std::basic_istream<CharT, Traits> &)
+    {
+        reset();
+    }
+
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        if (param == param_) {
+            return generate(rng, constant_);
+        }
+
+        internal::BinomialDistributionConstant constant(
+            static_cast<double>(param.t()), param.p());
+
+        return generate(rng, constant);
+    }
+
+    template <typename RNGType>
+    result_type generate(
+        RNGType &rng, const internal::BinomialDistributionConstant &constant)
+    {
+        if (constant.trivial()) {
+            return internal::ftoi<IntType>(constant.result(0));
+        }
+
+        if (constant.inversion()) {
+            U01CODistribution<double> u01;
+            return internal::ftoi<IntType>(
+                constant.result(constant.invert(u01(rng))));
+        }
+
+        return internal::ftoi<IntType>(constant.result(constant.btrd(rng)));
+    }
+}; // class BinomialDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(Binomial, IntType)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_BINOMIAL_DISTRIBUTION_HPP
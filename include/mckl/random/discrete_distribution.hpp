@@ -37,8 +37,12 @@
 
 namespace mckl {
 
-/// \brief Draw a single sample given weights
+/// \brief Draw samples given weights
 /// \ingroup Distribution
+///
+/// \details
+/// Each draw takes \f$O(N)\f$ time by a linear scan of the weights. See
+/// `DiscreteAlias` for constant time draws.
 template <typename IntType>
 class DiscreteDistribution
 {
@@ -83,6 +87,9 @@ class DiscreteDistribution
 
         Vector<double> probability() const { return probability_; }
 
+        /// \brief The number of weights
+        std::size_t size() const { return probability_.size(); }
+
         friend bool operator==(
             const param_type &param1, const param_type &param2)
         {
@@ -183,7 +190,7 @@ class DiscreteDistribution
     template <typename UnaryOperation>
     DiscreteDistribution(
         std::size_t count, double xmin, double xmax, UnaryOperation &&unary_op)
-        : param_type(count, xmin, xmax, std::forward<UnaryOperation>(unary_op))
+        : param_(count, xmin, xmax, std::forward<UnaryOperation>(unary_op))
     {
     }
 
@@ -205,11 +212,38 @@ class DiscreteDistribution
 
     Vector<double> probability() const { return param_.probability_; }
 
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param) { param_ = param; }
+
+    void param(param_type &&param) { param_ = std::move(param); }
+
     template <typename RNGType>
     result_type operator()(RNGType &rng) const
     {
-        return operator()(
-            rng, param_.probability_.begin(), param_.probability_.end(), true);
+        return operator()(rng, param_);
+    }
+
+    template <typename RNGType>
+    result_type operator()(RNGType &rng, const param_type &param) const
+    {
+        return operator()(rng, param.probability_.begin(),
+            param.probability_.end(), true);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        operator()(rng, n, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r,
+        const param_type &param) const
+    {
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = operator()(rng, param);
+        }
     }
 
     /// \brief Draw sample with external probabilities
@@ -308,6 +342,202 @@ class DiscreteDistribution
     param_type param_;
 }; // class DiscreteDistribution
 
+/// \brief Draw samples given weights using an alias table
+/// \ingroup Distribution
+///
+/// \details
+/// The Walker/Vose alias table is constructed in \f$O(N)\f$ time by the
+/// first draw after the weights are assigned, and reused by subsequent draws,
+/// each taking constant time. Given the same weights and generator, the
+/// samples differ from those of `DiscreteDistribution`.
+template <typename IntType>
+class DiscreteAlias
+{
+    static_assert(std::is_integral<IntType>::value,
+        "**DiscreteAlias** used with IntType other than integer types");
+    static_assert(CHAR_BIT * sizeof(IntType) >= 16,
+        "**DiscreteAlias** used with IntType smaller than 16 bits");
+
+  public:
+    using result_type = IntType;
+
+    DiscreteAlias() : built_(true) {}
+
+    template <typename InputIter>
+    DiscreteAlias(InputIter first, InputIter last)
+        : prob_(first, last), built_(false)
+    {
+    }
+
+    /// \brief Assign new weights, which need not be normalized
+    template <typename InputIter>
+    void assign(InputIter first, InputIter last)
+    {
+        prob_.assign(first, last);
+        built_ = false;
+    }
+
+    /// \brief The number of weights
+    std::size_t size() const { return prob_.size(); }
+
+    template <typename RNGType>
+    result_type operator()(RNGType &rng)
+    {
+        build();
+        if (size() == 0) {
+            return 0;
+        }
+
+        U01CODistribution<double> u01;
+        const double x = u01(rng) * static_cast<double>(size());
+        const std::size_t j = index(x);
+
+        return x - static_cast<double>(j) < prob_[j] ?
+            static_cast<result_type>(j) :
+            alias_[j];
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r)
+    {
+        build();
+        if (size() == 0) {
+            std::fill_n(r, n, 0);
+            return;
+        }
+
+        const std::size_t K = internal::BufferSize<double>::value;
+        const std::size_t M = n / K;
+        const std::size_t L = n % K;
+        for (std::size_t i = 0; i != M; ++i, r += K) {
+            generate<K>(rng, K, r);
+        }
+        generate<K>(rng, L, r);
+    }
+
+  private:
+    Vector<double> prob_;
+    Vector<result_type> alias_;
+    bool built_;
+
+    template <std::size_t K, typename RNGType>
+    void generate(RNGType &rng, std::size_t n, result_type *r) const
+    {
+        alignas(MCKL_ALIGNMENT) std::array<double, K> s;
+        u01_co_distribution(rng, n, s.data());
+        mul(n, static_cast<double>(size()), s.data(), s.data());
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::size_t j = index(s[i]);
+            r[i] = s[i] - static_cast<double>(j) < prob_[j] ?
+                static_cast<result_type>(j) :
+                alias_[j];
+        }
+    }
+
+    std::size_t index(double x) const
+    {
+        const std::size_t j = static_cast<std::size_t>(x);
+
+        return j < size() ? j : size() - 1;
+    }
+
+    // Vose's method, with prob_ holding the weights on entry
+    void build()
+    {
+        if (built_) {
+            return;
+        }
+        built_ = true;
+
+        const std::size_t n = size();
+        alias_.resize(n);
+        if (n == 0) {
+            return;
+        }
+        runtime_assert(static_cast<std::uintmax_t>(n - 1) <=
+                static_cast<std::uintmax_t>(
+                    std::numeric_limits<result_type>::max()),
+            "**DiscreteAlias** used with more weights than IntType can index");
+
+        double sum = 0;
+        for (std::size_t i = 0; i != n; ++i) {
+            runtime_assert(
+                prob_[i] >= 0, "**DiscreteAlias** used with negative weights");
+            sum += prob_[i];
+        }
+        runtime_assert(sum > 0, "**DiscreteAlias** used with zero weights");
+        mul(n, static_cast<double>(n) / sum, prob_.data(), prob_.data());
+
+        Vector<std::size_t> small;
+        Vector<std::size_t> large;
+        small.reserve(n);
+        large.reserve(n);
+        for (std::size_t i = 0; i != n; ++i) {
+            alias_[i] = static_cast<result_type>(i);
+            if (prob_[i] < 1) {
+                small.push_back(i);
+            } else {
+                large.push_back(i);
+            }
+        }
+
+        while (!small.empty() && !large.empty()) {
+            const std::size_t s = small.back();
+            const std::size_t l = large.back();
+            small.pop_back();
+            alias_[s] = static_cast<result_type>(l);
+            prob_[l] = (prob_[l] + prob_[s]) - 1;
+            if (prob_[l] < 1) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // Left-overs are one up to rounding errors
+        for (std::size_t i : small) {
+            prob_[i] = 1;
+        }
+        for (std::size_t i : large) {
+            prob_[i] = 1;
+        }
+    }
+}; // class DiscreteAlias
+
+/// \brief Draw samples given the parameters of a discrete distribution
+/// \ingroup Distribution
+template <typename IntType, typename RNGType>
+inline void discrete_distribution(RNGType &rng, std::size_t n, IntType *r,
+    const typename DiscreteDistribution<IntType>::param_type &param)
+{
+    DiscreteDistribution<IntType> dist;
+    dist(rng, n, r, param);
+}
+
+/// \brief Draw samples given weights
+/// \ingroup Distribution
+template <typename IntType, typename RNGType, typename InputIter>
+inline void discrete_distribution(RNGType &rng, std::size_t n, IntType *r,
+    InputIter first, InputIter last)
+{
+    typename DiscreteDistribution<IntType>::param_type param(first, last);
+    discrete_distribution(rng, n, r, param);
+}
+
+/// \brief Draw samples given weights using an alias table
+/// \ingroup Distribution
+///
+/// \details
+/// The table is built once for all `n` samples. See DiscreteAlias.
+template <typename IntType, typename RNGType, typename InputIter>
+inline void discrete_alias_distribution(RNGType &rng, std::size_t n,
+    IntType *r, InputIter first, InputIter last)
+{
+    DiscreteAlias<IntType> alias(first, last);
+    alias(rng, n, r);
+}
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(Discrete, IntType)
+
 } // namespace mckl
 
 #endif // MCKL_RANDOM_DISCRETE_DISTRIBUTION_HPP
@@ -36,6 +36,7 @@
 #include <mckl/random/arcsine_distribution.hpp>
 #include <mckl/random/bernoulli_distribution.hpp>
 #include <mckl/random/beta_distribution.hpp>
+#include <mckl/random/binomial_distribution.hpp>
 #include <mckl/random/cauchy_distribution.hpp>
 #include <mckl/random/chi_squared_distribution.hpp>
 #include <mckl/random/dirichlet_distribution.hpp>
@@ -45,20 +46,28 @@
 #include <mckl/random/fisher_f_distribution.hpp>
 #include <mckl/random/gamma_distribution.hpp>
 #include <mckl/random/geometric_distribution.hpp>
+#include <mckl/random/inverse_wishart_distribution.hpp>
 #include <mckl/random/laplace_distribution.hpp>
 #include <mckl/random/levy_distribution.hpp>
 #include <mckl/random/logistic_distribution.hpp>
 #include <mckl/random/lognormal_distribution.hpp>
+#include <mckl/random/lognormal_ziggurat_distribution.hpp>
+#include <mckl/random/multinomial_distribution.hpp>
+#include <mckl/random/negative_binomial_distribution.hpp>
 #include <mckl/random/normal_distribution.hpp>
 #include <mckl/random/normal_mv_distribution.hpp>
+#include <mckl/random/normal_ziggurat_distribution.hpp>
 #include <mckl/random/pareto_distribution.hpp>
+#include <mckl/random/poisson_distribution.hpp>
 #include <mckl/random/rayleigh_distribution.hpp>
 #include <mckl/random/stable_distribution.hpp>
 #include <mckl/random/student_t_distribution.hpp>
+#include <mckl/random/truncated_normal_distribution.hpp>
 #include <mckl/random/u01_distribution.hpp>
 #include <mckl/random/uniform_bits_distribution.hpp>
 #include <mckl/random/uniform_int_distribution.hpp>
 #include <mckl/random/uniform_real_distribution.hpp>
 #include <mckl/random/weibull_distribution.hpp>
+#include <mckl/random/wishart_distribution.hpp>
 
 #endif // MCKL_RANDOM_DISTRIBUTION_HPP
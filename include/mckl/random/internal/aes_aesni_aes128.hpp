@@ -35,6 +35,7 @@
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/internal/aes_aesni_common.hpp>
 #include <mckl/random/internal/aes_key_seq.hpp>
+#include <mckl/random/internal/asm_kernel.hpp>
 #include <mckl/random/increment.hpp>
 
 MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
@@ -159,7 +160,9 @@ class AES128GeneratorAESNIImpl
         ResultType *r, const KeySeqType &ks)
     {
 #if MCKL_USE_ASM_LIBRARY
-#if MCKL_USE_AVX2
+#if MCKL_USE_RUNTIME_DISPATCH
+        aes128_asm_kernel()(ctr.data(), n, r, ks.get().data());
+#elif MCKL_USE_AVX2
         mckl_aes128_aesni_avx2_kernel(ctr.data(), n, r, ks.get().data());
 #else
         mckl_aes128_aesni_sse2_kernel(ctr.data(), n, r, ks.get().data());
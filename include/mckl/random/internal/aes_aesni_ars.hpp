@@ -35,6 +35,7 @@
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/internal/aes_aesni_common.hpp>
 #include <mckl/random/internal/aes_key_seq.hpp>
+#include <mckl/random/internal/asm_kernel.hpp>
 #include <mckl/random/increment.hpp>
 
 MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
@@ -183,7 +184,9 @@ class ARSGeneratorAESNIImpl
                 (static_cast<std::uint64_t>(std::get<1>(key)) << 32),
             static_cast<std::uint64_t>(std::get<2>(key)) +
                 (static_cast<std::uint64_t>(std::get<3>(key)) << 32)};
-#if MCKL_USE_AVX2
+#if MCKL_USE_RUNTIME_DISPATCH
+        ars_asm_kernel()(ctr.data(), n, r, wk);
+#elif MCKL_USE_AVX2
         mckl_ars_aesni_avx2_kernel(ctr.data(), n, r, wk);
 #else
         mckl_ars_aesni_sse2_kernel(ctr.data(), n, r, wk);
@@ -0,0 +1,131 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/asm_kernel.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_ASM_KERNEL_HPP
+#define MCKL_RANDOM_INTERNAL_ASM_KERNEL_HPP
+
+#include <mckl/internal/config.h>
+
+#if MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+
+#include <mckl/internal/cpuid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mckl {
+
+namespace internal {
+
+using AsmKernelType = void (*)(std::uint64_t *, std::size_t, void *,
+    const void *);
+
+inline AsmKernelType philox2x32_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx512() ?
+        ::mckl_philox2x32_avx512_kernel :
+        (CPUID::avx2() ? ::mckl_philox2x32_avx2_kernel :
+                         ::mckl_philox2x32_sse2_kernel);
+
+    return kernel;
+}
+
+inline AsmKernelType philox4x32_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx512() ?
+        ::mckl_philox4x32_avx512_kernel :
+        (CPUID::avx2() ? ::mckl_philox4x32_avx2_kernel :
+                         ::mckl_philox4x32_sse2_kernel);
+
+    return kernel;
+}
+
+/// \brief Return `nullptr` if BMI2 is not supported
+inline AsmKernelType philox2x64_asm_kernel()
+{
+    static const AsmKernelType kernel =
+        CPUID::bmi2() ? ::mckl_philox2x64_bmi2_kernel : nullptr;
+
+    return kernel;
+}
+
+/// \brief Return `nullptr` if BMI2 is not supported
+inline AsmKernelType philox4x64_asm_kernel()
+{
+    static const AsmKernelType kernel =
+        CPUID::bmi2() ? ::mckl_philox4x64_bmi2_kernel : nullptr;
+
+    return kernel;
+}
+
+inline AsmKernelType aes128_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx2() ?
+        ::mckl_aes128_aesni_avx2_kernel :
+        ::mckl_aes128_aesni_sse2_kernel;
+
+    return kernel;
+}
+
+inline AsmKernelType aes192_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx2() ?
+        ::mckl_aes192_aesni_avx2_kernel :
+        ::mckl_aes192_aesni_sse2_kernel;
+
+    return kernel;
+}
+
+inline AsmKernelType aes256_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx2() ?
+        ::mckl_aes256_aesni_avx2_kernel :
+        ::mckl_aes256_aesni_sse2_kernel;
+
+    return kernel;
+}
+
+inline AsmKernelType ars_asm_kernel()
+{
+    static const AsmKernelType kernel = CPUID::avx2() ?
+        ::mckl_ars_aesni_avx2_kernel :
+        ::mckl_ars_aesni_sse2_kernel;
+
+    return kernel;
+}
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+
+#endif // MCKL_RANDOM_INTERNAL_ASM_KERNEL_HPP
@@ -1038,6 +1038,9 @@ class FisherFDistribution;
 template <typename = double>
 class GammaDistribution;
 
+template <typename = double>
+class InverseWishartDistribution;
+
 template <typename = double>
 class LaplaceDistribution;
 
@@ -1051,11 +1054,18 @@ template <typename = double>
 class LognormalDistribution;
 
 template <typename = double>
-class NormalDistribution;
+class LognormalZigguratDistribution;
 
 template <typename = double>
+class NormalDistribution;
+
+template <typename RealType = double,
+    typename = NormalDistribution<RealType>>
 class NormalMVDistribution;
 
+template <typename = double>
+class NormalZigguratDistribution;
+
 template <typename = double>
 class ParetoDistribution;
 
@@ -1068,6 +1078,9 @@ class StableDistribution;
 template <typename = double>
 class StudentTDistribution;
 
+template <typename = double>
+class TruncatedNormalDistribution;
+
 template <typename = double>
 class U01CanonicalDistribution;
 
@@ -1092,12 +1105,27 @@ class UniformRealDistribution;
 template <typename = double>
 class WeibullDistribution;
 
+template <typename = double>
+class WishartDistribution;
+
 template <typename = bool>
 class BernoulliDistribution;
 
+template <typename = int>
+class BinomialDistribution;
+
 template <typename = int>
 class GeometricDistribution;
 
+template <typename = int>
+class MultinomialDistribution;
+
+template <typename = int>
+class NegativeBinomialDistribution;
+
+template <typename = int>
+class PoissonDistribution;
+
 template <typename = int>
 class DiscreteDistribution;
 
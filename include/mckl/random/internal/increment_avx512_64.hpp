@@ -60,7 +60,7 @@ inline void increment_si512(
 {
     constexpr T blocks = (sizeof(__m512i) * S) / (sizeof(T) * K);
 
-    if (std::get<0>(ctr) < std::numeric_limits<T>::max() - blocks) {
+    if (std::get<0>(ctr) <= std::numeric_limits<T>::max() - blocks) {
         IncrementBlockSI512<T, K, blocks>::eval(ctr, s);
         std::get<0>(ctr) += blocks;
     } else {
@@ -79,6 +79,18 @@ MCKL_INLINE inline void increment_si512(
         ctr, s, std::integral_constant<bool, (direct && bits)>());
 }
 
+template <typename T, std::size_t K>
+MCKL_INLINE inline void increment_si512(
+    std::array<T, K> &ctr, std::array<__m512i, 16> &s)
+{
+    std::array<__m512i, 8> t;
+
+    increment_si512(ctr, t);
+    std::memcpy(s.data(), t.data(), sizeof(__m512i) * 8);
+    increment_si512(ctr, t);
+    std::memcpy(s.data() + 8, t.data(), sizeof(__m512i) * 8);
+}
+
 } // namespace internal
 
 } // namespace mckl
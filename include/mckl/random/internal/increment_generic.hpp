@@ -195,7 +195,7 @@ class Increment<T, 16>
 template <typename T, std::size_t K, T NSkip>
 inline void increment(std::array<T, K> &ctr, std::integral_constant<T, NSkip>)
 {
-    if (std::get<0>(ctr) < std::numeric_limits<T>::max() - NSkip) {
+    if (std::get<0>(ctr) <= std::numeric_limits<T>::max() - NSkip) {
         std::get<0>(ctr) += NSkip;
     } else {
         std::get<0>(ctr) += NSkip;
@@ -208,7 +208,7 @@ inline void increment(std::array<T, K> &ctr, std::integral_constant<T, NSkip>)
 template <typename T, std::size_t K>
 inline void increment(std::array<T, K> &ctr, T nskip)
 {
-    if (std::get<0>(ctr) < std::numeric_limits<T>::max() - nskip) {
+    if (std::get<0>(ctr) <= std::numeric_limits<T>::max() - nskip) {
         std::get<0>(ctr) += nskip;
     } else {
         std::get<0>(ctr) += nskip;
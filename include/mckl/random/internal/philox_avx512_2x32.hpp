@@ -33,6 +33,7 @@
 #define MCKL_RANDOM_INTERNAL_PHILOX_AVX512_2X32_HPP
 
 #include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/asm_kernel.hpp>
 #include <mckl/random/internal/philox_avx512_32_common.hpp>
 #include <mckl/random/internal/philox_common.hpp>
 #include <mckl/random/internal/philox_constants.hpp>
@@ -101,7 +102,11 @@ class Philox2x32GeneratorAVX512Impl
         constexpr T w0 = Constants::weyl::value[0];
 
         const T mwk[6] = {m0, 0, 0, w0, 0, std::get<0>(key)};
+#if MCKL_USE_RUNTIME_DISPATCH
+        philox2x32_asm_kernel()(ctr.data(), n, r, mwk);
+#else
         mckl_philox2x32_avx512_kernel(ctr.data(), n, r, mwk);
+#endif
 #else  // MCKL_USE_ASM_LIBRARY
         constexpr std::size_t S = 8;
         constexpr std::size_t N = sizeof(__m512i) * S / (sizeof(T) * K);
@@ -33,6 +33,7 @@
 #define MCKL_RANDOM_INTERNAL_PHILOX_GENERIC_2X_HPP
 
 #include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/asm_kernel.hpp>
 #include <mckl/random/internal/philox_common.hpp>
 #include <mckl/random/internal/philox_constants.hpp>
 #include <mckl/random/increment.hpp>
@@ -174,7 +175,24 @@ class Philox2x64GeneratorGenericImpl
         std::memcpy(r, buf.r.data(), sizeof(T) * K);
     }
 
-#if MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
+#if MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+    template <typename ResultType>
+    static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K / 2> &key)
+    {
+        const AsmKernelType kernel = philox2x64_asm_kernel();
+        if (kernel == nullptr) {
+            eval_generic(ctr, n, r, key);
+            return;
+        }
+
+        constexpr T w0 = Constants::weyl::value[0];
+        constexpr T m0 = Constants::multiplier::value[0];
+
+        const T mwk[3] = {m0, w0, std::get<0>(key)};
+        kernel(ctr.data(), n, r, mwk);
+    }
+#elif MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
     template <typename ResultType>
     static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
         const std::array<T, K / 2> &key)
@@ -185,18 +203,26 @@ class Philox2x64GeneratorGenericImpl
         const T mwk[3] = {m0, w0, std::get<0>(key)};
         mckl_philox2x64_bmi2_kernel(ctr.data(), n, r, mwk);
     }
-#else  // MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
+#else  // MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
     template <typename ResultType>
     static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
         const std::array<T, K / 2> &key)
+    {
+        eval_generic(ctr, n, r, key);
+    }
+#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+
+  private:
+    template <typename ResultType>
+    static void eval_generic(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K / 2> &key)
     {
         constexpr std::size_t R = sizeof(T) * K / sizeof(ResultType);
 
         for (std::size_t i = 0; i != n; ++i, r += R)
             eval(ctr, r, key);
     }
-#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
-};     // class Philox2x64GeneratorGenericImpl
+}; // class Philox2x64GeneratorGenericImpl
 
 } // namespace internal
 
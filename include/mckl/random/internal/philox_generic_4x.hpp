@@ -33,6 +33,7 @@
 #define MCKL_RANDOM_INTERNAL_PHILOX_GENERIC_4X_HPP
 
 #include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/asm_kernel.hpp>
 #include <mckl/random/internal/philox_common.hpp>
 #include <mckl/random/internal/philox_constants.hpp>
 #include <mckl/random/increment.hpp>
@@ -186,7 +187,26 @@ class Philox4x64GeneratorGenericImpl
         std::memcpy(r, buf.r.data(), sizeof(T) * K);
     }
 
-#if MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
+#if MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+    template <typename ResultType>
+    static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K / 2> &key)
+    {
+        const AsmKernelType kernel = philox4x64_asm_kernel();
+        if (kernel == nullptr) {
+            eval_generic(ctr, n, r, key);
+            return;
+        }
+
+        constexpr T w0 = Constants::weyl::value[0];
+        constexpr T w1 = Constants::weyl::value[1];
+        constexpr T m0 = Constants::multiplier::value[0];
+        constexpr T m1 = Constants::multiplier::value[1];
+
+        const T mwk[6] = {m0, m1, w0, w1, std::get<0>(key), std::get<1>(key)};
+        kernel(ctr.data(), n, r, mwk);
+    }
+#elif MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
     template <typename ResultType>
     static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
         const std::array<T, K / 2> &key)
@@ -199,18 +219,26 @@ class Philox4x64GeneratorGenericImpl
         const T mwk[6] = {m0, m1, w0, w1, std::get<0>(key), std::get<1>(key)};
         mckl_philox4x64_bmi2_kernel(ctr.data(), n, r, mwk);
     }
-#else  // MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
+#else  // MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
     template <typename ResultType>
     static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
         const std::array<T, K / 2> &key)
+    {
+        eval_generic(ctr, n, r, key);
+    }
+#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_RUNTIME_DISPATCH
+
+  private:
+    template <typename ResultType>
+    static void eval_generic(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K / 2> &key)
     {
         constexpr std::size_t R = sizeof(T) * K / sizeof(ResultType);
 
         for (std::size_t i = 0; i != n; ++i, r += R)
             eval(ctr, r, key);
     }
-#endif // MCKL_USE_ASM_LIBRARY && MCKL_USE_BMI2
-};     // class Philox4x64GeneratorGenericImpl
+}; // class Philox4x64GeneratorGenericImpl
 
 } // namespace internal
 
@@ -0,0 +1,142 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/threefry_dispatch.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+
+#ifndef MCKL_RANDOM_INTERNAL_THREEFRY_DISPATCH_HPP
+#define MCKL_RANDOM_INTERNAL_THREEFRY_DISPATCH_HPP
+
+#include <mckl/internal/config.h>
+
+#if MCKL_USE_RUNTIME_DISPATCH
+
+#include <mckl/internal/cpuid.hpp>
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/threefry_common.hpp>
+#include <mckl/random/internal/threefry_constants.hpp>
+#include <mckl/random/internal/threefry_generic.hpp>
+#include <mckl/random/counter.hpp>
+#include <mckl/random/increment.hpp>
+
+// Everything the SIMD implementations share with the portable ones is
+// included above, such that only the SIMD kernels are compiled for the wider
+// instruction sets below
+
+MCKL_PUSH_TARGET("avx2")
+#include <mckl/internal/avx2.hpp>
+#include <mckl/random/internal/increment_avx2_64.hpp>
+#include <mckl/random/internal/threefry_avx2.hpp>
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+#include <mckl/internal/avx512.hpp>
+#include <mckl/random/internal/increment_avx512_64.hpp>
+#include <mckl/random/internal/threefry_avx512.hpp>
+MCKL_POP_TARGET
+
+namespace mckl {
+
+namespace internal {
+
+MCKL_PUSH_TARGET("avx2")
+
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants,
+    typename ResultType>
+inline void threefry_avx2_kernel(Counter<T, K> &ctr, std::size_t n,
+    ResultType *r, const std::array<T, K + 4> &par)
+{
+    ThreefryGeneratorAVX2Impl<T, K, Rounds, Constants>::eval(ctr, n, r, par);
+}
+
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants,
+    typename ResultType>
+inline void threefry_avx512_kernel(Counter<T, K> &ctr, std::size_t n,
+    ResultType *r, const std::array<T, K + 4> &par)
+{
+    ThreefryGeneratorAVX512Impl<T, K, Rounds, Constants>::eval(
+        ctr, n, r, par);
+}
+
+MCKL_POP_TARGET
+
+/// \brief Generate batches of Threefry blocks with a kernel selected at
+/// runtime
+///
+/// \details
+/// The AVX-512 or AVX2 kernel is used if the host supports it, and `Impl`,
+/// the implementation selected at compile time, otherwise.
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants,
+    typename Impl>
+class ThreefryGeneratorDispatchImpl
+{
+  public:
+    template <typename ResultType>
+    static void eval(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K + 4> &par)
+    {
+        kernel<ResultType>()(ctr, n, r, par);
+    }
+
+  private:
+    template <typename ResultType>
+    using kernel_type = void (*)(Counter<T, K> &, std::size_t, ResultType *,
+        const std::array<T, K + 4> &);
+
+    template <typename ResultType>
+    static kernel_type<ResultType> kernel()
+    {
+        static const kernel_type<ResultType> kernel = CPUID::avx512() ?
+            threefry_avx512_kernel<T, K, Rounds, Constants, ResultType> :
+            (CPUID::avx2() ?
+                    threefry_avx2_kernel<T, K, Rounds, Constants, ResultType> :
+                    eval_impl<ResultType>);
+
+        return kernel;
+    }
+
+    template <typename ResultType>
+    static void eval_impl(Counter<T, K> &ctr, std::size_t n, ResultType *r,
+        const std::array<T, K + 4> &par)
+    {
+        Impl::eval(ctr, n, r, par);
+    }
+}; // class ThreefryGeneratorDispatchImpl
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_USE_RUNTIME_DISPATCH
+
+#endif // MCKL_RANDOM_INTERNAL_THREEFRY_DISPATCH_HPP
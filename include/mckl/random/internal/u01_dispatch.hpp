@@ -0,0 +1,154 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/u01_dispatch.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+
+#ifndef MCKL_RANDOM_INTERNAL_U01_DISPATCH_HPP
+#define MCKL_RANDOM_INTERNAL_U01_DISPATCH_HPP
+
+#include <mckl/internal/config.h>
+
+#if MCKL_USE_RUNTIME_DISPATCH
+
+#include <mckl/internal/cpuid.hpp>
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/u01_generic.hpp>
+
+MCKL_PUSH_TARGET("avx2")
+#include <mckl/internal/avx2.hpp>
+#include <mckl/random/internal/u01_avx2.hpp>
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+#include <mckl/internal/avx512.hpp>
+#include <mckl/random/internal/u01_avx512.hpp>
+MCKL_POP_TARGET
+
+namespace mckl {
+
+namespace internal {
+
+MCKL_PUSH_TARGET("avx2")
+
+template <typename UIntType, typename RealType, typename Lower, typename Upper>
+inline void u01_avx2_kernel(std::size_t n, const UIntType *u, RealType *r)
+{
+    U01AVX2Impl<UIntType, RealType, Lower, Upper>::eval(n, u, r);
+}
+
+template <typename UIntType, typename RealType, int M>
+inline void u01_canonical_avx2_kernel(
+    std::size_t n, const UIntType *u, RealType *r)
+{
+    U01CanonicalAVX2Impl<UIntType, RealType, M>::eval(n, u, r);
+}
+
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+
+template <typename UIntType, typename RealType, typename Lower, typename Upper>
+inline void u01_avx512_kernel(std::size_t n, const UIntType *u, RealType *r)
+{
+    U01AVX512Impl<UIntType, RealType, Lower, Upper>::eval(n, u, r);
+}
+
+template <typename UIntType, typename RealType, int M>
+inline void u01_canonical_avx512_kernel(
+    std::size_t n, const UIntType *u, RealType *r)
+{
+    U01CanonicalAVX512Impl<UIntType, RealType, M>::eval(n, u, r);
+}
+
+MCKL_POP_TARGET
+
+template <typename UIntType, typename RealType>
+using U01KernelType = void (*)(std::size_t, const UIntType *, RealType *);
+
+/// \brief Convert batches of integers with a kernel selected at runtime
+///
+/// \details
+/// The AVX-512 or AVX2 kernel is used if the host supports it, and `Impl`,
+/// the implementation selected at compile time, otherwise.
+template <typename UIntType, typename RealType, typename Lower, typename Upper,
+    typename Impl>
+class U01DispatchImpl
+{
+  public:
+    static void eval(std::size_t n, const UIntType *u, RealType *r)
+    {
+        static const U01KernelType<UIntType, RealType> kernel =
+            CPUID::avx512() ?
+            u01_avx512_kernel<UIntType, RealType, Lower, Upper> :
+            (CPUID::avx2() ?
+                    u01_avx2_kernel<UIntType, RealType, Lower, Upper> :
+                    eval_impl);
+
+        kernel(n, u, r);
+    }
+
+  private:
+    static void eval_impl(std::size_t n, const UIntType *u, RealType *r)
+    {
+        Impl::eval(n, u, r);
+    }
+}; // class U01DispatchImpl
+
+/// \brief Convert batches of integers with a kernel selected at runtime
+template <typename UIntType, typename RealType, int M, typename Impl>
+class U01CanonicalDispatchImpl
+{
+  public:
+    static void eval(std::size_t n, const UIntType *u, RealType *r)
+    {
+        static const U01KernelType<UIntType, RealType> kernel =
+            CPUID::avx512() ?
+            u01_canonical_avx512_kernel<UIntType, RealType, M> :
+            (CPUID::avx2() ?
+                    u01_canonical_avx2_kernel<UIntType, RealType, M> :
+                    eval_impl);
+
+        kernel(n, u, r);
+    }
+
+  private:
+    static void eval_impl(std::size_t n, const UIntType *u, RealType *r)
+    {
+        Impl::eval(n, u, r);
+    }
+}; // class U01CanonicalDispatchImpl
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_USE_RUNTIME_DISPATCH
+
+#endif // MCKL_RANDOM_INTERNAL_U01_DISPATCH_HPP
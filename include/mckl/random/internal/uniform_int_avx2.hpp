@@ -0,0 +1,87 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/uniform_int_avx2.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX2_HPP
+#define MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX2_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/uniform_int_generic.hpp>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+namespace mckl {
+
+namespace internal {
+
+class UniformIntAVX2Impl
+{
+  public:
+    static bool eval(std::size_t n, const std::uint32_t *u, std::uint32_t s,
+        std::uint32_t t, std::uint32_t *r)
+    {
+        constexpr std::size_t N = sizeof(__m256i) / sizeof(std::uint32_t);
+
+        const __m256i vs = _mm256_set1_epi64x(static_cast<long long>(s));
+        const __m256i sign = _mm256_set1_epi32(
+            static_cast<int>(std::numeric_limits<std::int32_t>::min()));
+        const __m256i vt = _mm256_xor_si256(
+            _mm256_set1_epi32(static_cast<int>(t)), sign);
+        __m256i reject = _mm256_setzero_si256();
+        while (n >= N) {
+            const __m256i x =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(u));
+            const __m256i e = _mm256_mul_epu32(x, vs);
+            const __m256i o = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), vs);
+            const __m256i hi =
+                _mm256_blend_epi32(_mm256_srli_epi64(e, 32), o, 0xAA);
+            const __m256i lo =
+                _mm256_blend_epi32(e, _mm256_slli_epi64(o, 32), 0xAA);
+            reject = _mm256_or_si256(reject,
+                _mm256_cmpgt_epi32(vt, _mm256_xor_si256(lo, sign)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(r), hi);
+            n -= N;
+            u += N;
+            r += N;
+        }
+
+        const bool rv = _mm256_testz_si256(reject, reject) == 0;
+
+        return UniformIntGenericImpl::eval(n, u, s, t, r) || rv;
+    }
+}; // class UniformIntAVX2Impl
+
+} // namespace internal
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX2_HPP
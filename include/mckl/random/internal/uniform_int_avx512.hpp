@@ -0,0 +1,81 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/uniform_int_avx512.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX512_HPP
+#define MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX512_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/uniform_int_generic.hpp>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+namespace mckl {
+
+namespace internal {
+
+class UniformIntAVX512Impl
+{
+  public:
+    static bool eval(std::size_t n, const std::uint32_t *u, std::uint32_t s,
+        std::uint32_t t, std::uint32_t *r)
+    {
+        constexpr std::size_t N = sizeof(__m512i) / sizeof(std::uint32_t);
+
+        const __m512i vs = _mm512_set1_epi64(static_cast<long long>(s));
+        const __m512i vt = _mm512_set1_epi32(static_cast<int>(t));
+        __mmask16 reject = 0;
+        while (n >= N) {
+            const __m512i x =
+                _mm512_loadu_si512(reinterpret_cast<const __m512i *>(u));
+            const __m512i e = _mm512_mul_epu32(x, vs);
+            const __m512i o = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), vs);
+            const __m512i hi =
+                _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(e, 32), o);
+            const __m512i lo =
+                _mm512_mask_blend_epi32(0xAAAA, e, _mm512_slli_epi64(o, 32));
+            reject |= _mm512_cmplt_epu32_mask(lo, vt);
+            _mm512_storeu_si512(reinterpret_cast<__m512i *>(r), hi);
+            n -= N;
+            u += N;
+            r += N;
+        }
+
+        return UniformIntGenericImpl::eval(n, u, s, t, r) || reject != 0;
+    }
+}; // class UniformIntAVX512Impl
+
+} // namespace internal
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_RANDOM_INTERNAL_UNIFORM_INT_AVX512_HPP
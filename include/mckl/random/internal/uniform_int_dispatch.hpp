@@ -0,0 +1,115 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/uniform_int_dispatch.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+
+#ifndef MCKL_RANDOM_INTERNAL_UNIFORM_INT_DISPATCH_HPP
+#define MCKL_RANDOM_INTERNAL_UNIFORM_INT_DISPATCH_HPP
+
+#include <mckl/internal/config.h>
+
+#if MCKL_USE_RUNTIME_DISPATCH
+
+#include <mckl/internal/cpuid.hpp>
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/uniform_int_generic.hpp>
+
+MCKL_PUSH_TARGET("avx2")
+#include <mckl/internal/avx2.hpp>
+#include <mckl/random/internal/uniform_int_avx2.hpp>
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+#include <mckl/internal/avx512.hpp>
+#include <mckl/random/internal/uniform_int_avx512.hpp>
+MCKL_POP_TARGET
+
+namespace mckl {
+
+namespace internal {
+
+MCKL_PUSH_TARGET("avx2")
+
+inline bool uniform_int_avx2_kernel(std::size_t n, const std::uint32_t *u,
+    std::uint32_t s, std::uint32_t t, std::uint32_t *r)
+{
+    return UniformIntAVX2Impl::eval(n, u, s, t, r);
+}
+
+MCKL_POP_TARGET
+
+MCKL_PUSH_TARGET("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+
+inline bool uniform_int_avx512_kernel(std::size_t n, const std::uint32_t *u,
+    std::uint32_t s, std::uint32_t t, std::uint32_t *r)
+{
+    return UniformIntAVX512Impl::eval(n, u, s, t, r);
+}
+
+MCKL_POP_TARGET
+
+using UniformIntKernelType = bool (*)(std::size_t, const std::uint32_t *,
+    std::uint32_t, std::uint32_t, std::uint32_t *);
+
+/// \brief Multiply-shift batches of integers with a kernel selected at
+/// runtime
+///
+/// \details
+/// The AVX-512 or AVX2 kernel is used if the host supports it, and `Impl`,
+/// the implementation selected at compile time, otherwise.
+template <typename Impl>
+class UniformIntDispatchImpl
+{
+  public:
+    static bool eval(std::size_t n, const std::uint32_t *u, std::uint32_t s,
+        std::uint32_t t, std::uint32_t *r)
+    {
+        static const UniformIntKernelType kernel = CPUID::avx512() ?
+            uniform_int_avx512_kernel :
+            (CPUID::avx2() ? uniform_int_avx2_kernel : eval_impl);
+
+        return kernel(n, u, s, t, r);
+    }
+
+  private:
+    static bool eval_impl(std::size_t n, const std::uint32_t *u,
+        std::uint32_t s, std::uint32_t t, std::uint32_t *r)
+    {
+        return Impl::eval(n, u, s, t, r);
+    }
+}; // class UniformIntDispatchImpl
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_USE_RUNTIME_DISPATCH
+
+#endif // MCKL_RANDOM_INTERNAL_UNIFORM_INT_DISPATCH_HPP
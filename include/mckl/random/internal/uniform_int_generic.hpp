@@ -0,0 +1,67 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/uniform_int_generic.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_UNIFORM_INT_GENERIC_HPP
+#define MCKL_RANDOM_INTERNAL_UNIFORM_INT_GENERIC_HPP
+
+#include <mckl/random/internal/common.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+/// \brief Multiply-shift of 32-bit random integers
+///
+/// \details
+/// `r[i]` is the high 32 bits of `u[i] * s`, and the return value is true if
+/// the low 32 bits of any product are less than the rejection threshold `t`
+class UniformIntGenericImpl
+{
+  public:
+    static bool eval(std::size_t n, const std::uint32_t *u, std::uint32_t s,
+        std::uint32_t t, std::uint32_t *r)
+    {
+        bool reject = false;
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::uint64_t m = static_cast<std::uint64_t>(u[i]) * s;
+            r[i] = static_cast<std::uint32_t>(m >> 32);
+            reject |= static_cast<std::uint32_t>(m) < t;
+        }
+
+        return reject;
+    }
+}; // class UniformIntGenericImpl
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_INTERNAL_UNIFORM_INT_GENERIC_HPP
@@ -0,0 +1,405 @@
+//============================================================================
+// MCKL/include/mckl/random/inverse_wishart_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INVERSE_WISHART_DISTRIBUTION_HPP
+#define MCKL_RANDOM_INVERSE_WISHART_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/wishart_distribution.hpp>
+
+namespace mckl {
+
+/// \brief Generating inverse Wishart random matrices with scalar scale
+///
+/// \details
+/// The scale matrix is \f$c^2 I\f$ where \f$c\f$ is `chol`. Each of the `n`
+/// results is the lower triangular part of a `dim` by `dim` matrix packed row
+/// by row.
+template <typename RealType, typename RNGType>
+inline void inverse_wishart_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, RealType chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(dim, "inverse_wishart_distribution");
+
+    if (n * dim == 0) {
+        return;
+    }
+
+    internal::wishart_distribution_impl<RealType>(
+        rng, n, r, dim, df, chol, nullptr, true);
+}
+
+/// \brief Generating inverse Wishart random matrices
+///
+/// \details
+/// The scale matrix is given by the lower triangular elements of its
+/// Cholesky decomposition, packed row by row. Each of the `n` results is the
+/// lower triangular part of a `dim` by `dim` matrix packed row by row.
+template <typename RealType, typename RNGType>
+inline void inverse_wishart_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, const RealType *chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(
+        n * dim, "inverse_wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "inverse_wishart_distribution");
+
+    if (n * dim == 0) {
+        return;
+    }
+
+    Vector<RealType> cholf = internal::wishart_distribution_cholf(dim, chol);
+    internal::wishart_distribution_impl(rng, n, r, dim, df,
+        const_one<RealType>(), cholf.data(), true);
+}
+
+/// \brief Inverse Wishart distribution
+/// \ingroup Distribution
+///
+/// \details
+/// The distribution is parameterized by the degrees of freedom and the lower
+/// triangular elements of the Cholesky decomposition of the scale matrix,
+/// packed row by row. A random matrix \f$X\f$ is generated such that
+/// \f$X^{-1}\f$ follows the Wishart distribution with the inverse of the
+/// scale matrix, by inverting the triangular Bartlett factor instead of the
+/// full matrix. Only the lower triangular elements are returned, packed row
+/// by row.
+template <typename RealType>
+class InverseWishartDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_BLAS_TYPE(InverseWishart)
+
+  public:
+    using result_type = RealType;
+    using distribution_type = InverseWishartDistribution<RealType>;
+
+    MCKL_PUSH_CLANG_WARNING("-Wpadded")
+    class param_type
+    {
+      public:
+        using result_type = RealType;
+        using distribution_type = InverseWishartDistribution<RealType>;
+
+        explicit param_type(std::size_t dim = 1)
+            : dim_(dim)
+            , df_(static_cast<result_type>(dim))
+            , chol_(dim * (dim + 1) / 2, 0)
+            , is_scalar_(true)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**InverseWishartDistribution** constructed with invalid "
+                "arguments");
+            scalar_chol(1);
+        }
+
+        param_type(std::size_t dim, result_type df, result_type chol)
+            : dim_(dim)
+            , df_(df)
+            , chol_(dim * (dim + 1) / 2, 0)
+            , is_scalar_(true)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**InverseWishartDistribution** constructed with invalid "
+                "arguments");
+            scalar_chol(chol);
+        }
+
+        param_type(std::size_t dim, result_type df, const result_type *chol)
+            : dim_(dim)
+            , df_(df)
+            , chol_(chol, chol + dim * (dim + 1) / 2)
+            , is_scalar_(false)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**InverseWishartDistribution** constructed with invalid "
+                "arguments");
+        }
+
+        std::size_t dim() const { return dim_; }
+
+        result_type df() const { return df_; }
+
+        const result_type *chol() const { return chol_.data(); }
+
+        friend bool operator==(
+            const param_type &param1, const param_type &param2)
+        {
+            MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+            MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+            if (param1.dim_ != param2.dim_) {
+                return false;
+            }
+            if (param1.df_ != param2.df_) {
+                return false;
+            }
+            if (param1.chol_ != param2.chol_) {
+                return false;
+            }
+            if (param1.is_scalar_ != param2.is_scalar_) {
+                return false;
+            }
+            return true;
+            MCKL_POP_CLANG_WARNING
+            MCKL_POP_INTEL_WARNING
+        }
+
+        friend bool operator!=(
+            const param_type &param1, const param_type &param2)
+        {
+            return !(param1 == param2);
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_ostream<CharT, Traits> &operator<<(
+            std::basic_ostream<CharT, Traits> &os, const param_type &param)
+        {
+            if (!os) {
+                return os;
+            }
+
+            os << param.dim_ << ' ';
+            os << param.df_ << ' ';
+            os << param.chol_ << ' ';
+            os << param.is_scalar_;
+
+            return os;
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_istream<CharT, Traits> &operator>>(
+            std::basic_istream<CharT, Traits> &is, param_type &param)
+        {
+            if (!is) {
+                return is;
+            }
+
+            param_type tmp;
+            is >> std::ws >> tmp.dim_;
+            is >> std::ws >> tmp.df_;
+            is >> std::ws >> tmp.chol_;
+            is >> std::ws >> tmp.is_scalar_;
+
+            if (is) {
+                param = std::move(tmp);
+            } else {
+                is.setstate(std::ios_base::failbit);
+            }
+
+            return is;
+        }
+
+      private:
+        std::size_t dim_;
+        result_type df_;
+        Vector<result_type> chol_;
+        bool is_scalar_;
+
+        friend distribution_type;
+
+        void scalar_chol(result_type chol)
+        {
+            for (std::size_t i = 0; i != dim_; ++i) {
+                chol_[(i + 1) * (i + 2) / 2 - 1] = chol;
+            }
+        }
+    }; // class param_type
+    MCKL_POP_CLANG_WARNING
+
+    /// \brief Construct a distribution with identity scale matrix
+    explicit InverseWishartDistribution(std::size_t dim = 1) : param_(dim)
+    {
+        reset();
+    }
+
+    /// \brief Construct a distribution with scalar scale matrix
+    InverseWishartDistribution(
+        std::size_t dim, result_type df, result_type chol = 1)
+        : param_(dim, df, chol)
+    {
+        reset();
+    }
+
+    /// \brief Construct a distribution with general scale matrix
+    InverseWishartDistribution(
+        std::size_t dim, result_type df, const result_type *chol)
+        : param_(dim, df, chol)
+    {
+        reset();
+    }
+
+    explicit InverseWishartDistribution(const param_type &param)
+        : param_(param)
+    {
+        reset();
+    }
+
+    explicit InverseWishartDistribution(param_type &&param)
+        : param_(std::move(param))
+    {
+        reset();
+    }
+
+    template <typename OutputIter>
+    OutputIter min(OutputIter first) const
+    {
+        return std::fill_n(first, dim() * (dim() + 1) / 2,
+            std::numeric_limits<result_type>::lowest());
+    }
+
+    template <typename OutputIter>
+    OutputIter max(OutputIter first) const
+    {
+        return std::fill_n(first, dim() * (dim() + 1) / 2,
+            std::numeric_limits<result_type>::max());
+    }
+
+    void reset() {}
+
+    std::size_t dim() const { return param_.dim(); }
+
+    result_type df() const { return param_.df(); }
+
+    const result_type *chol() const { return param_.chol(); }
+
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param)
+    {
+        param_ = param;
+        reset();
+    }
+
+    void param(param_type &&param)
+    {
+        param_ = std::move(param);
+        reset();
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r)
+    {
+        operator()(rng, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r, const param_type &param)
+    {
+        operator()(rng, 1, r, param);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r)
+    {
+        operator()(rng, n, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(
+        RNGType &rng, std::size_t n, result_type *r, const param_type &param)
+    {
+        if (param.is_scalar_) {
+            inverse_wishart_distribution(
+                rng, n, r, param.dim(), param.df(), param.chol()[0]);
+        } else {
+            inverse_wishart_distribution(
+                rng, n, r, param.dim(), param.df(), param.chol());
+        }
+    }
+
+    friend bool operator==(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        if (dist1.param_ != dist2.param_) {
+            return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return !(dist1 == dist2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const distribution_type &dist)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << dist.param_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, distribution_type &dist)
+    {
+        if (!is) {
+            return is;
+        }
+
+        param_type param;
+        is >> std::ws >> param;
+        if (is) {
+            dist.param_ = std::move(param);
+        }
+
+        return is;
+    }
+
+  private:
+    param_type param_;
+}; // class InverseWishartDistribution
+
+template <typename RealType, typename RNGType>
+inline void rand(RNGType &rng,
+    InverseWishartDistribution<RealType> &distribution, RealType *r)
+{
+    distribution(rng, r);
+}
+
+template <typename RealType, typename RNGType>
+inline void rand(RNGType &rng,
+    InverseWishartDistribution<RealType> &distribution, std::size_t n,
+    RealType *r)
+{
+    distribution(rng, n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_INVERSE_WISHART_DISTRIBUTION_HPP
@@ -0,0 +1,427 @@
+//============================================================================
+// MCKL/include/mckl/random/multinomial_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_MULTINOMIAL_DISTRIBUTION_HPP
+#define MCKL_RANDOM_MULTINOMIAL_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/binomial_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename IntType>
+inline bool multinomial_distribution_check_param(
+    IntType t, std::size_t dim, const double *prob)
+{
+    if (t < 0 || dim == 0) {
+        return false;
+    }
+
+    double s = 0;
+    for (std::size_t i = 0; i != dim; ++i) {
+        if (!(prob[i] >= 0)) {
+            return false;
+        }
+        s += prob[i];
+    }
+
+    return s > 0;
+}
+
+// Normalized probabilities followed by their cumulative sums
+inline void multinomial_distribution_table(
+    std::size_t dim, const double *prob, double *table)
+{
+    const double s = std::accumulate(prob, prob + dim, 0.0);
+    mul(dim, 1 / s, prob, table);
+    std::partial_sum(table, table + dim, table + dim);
+    table[dim * 2 - 1] = 1;
+}
+
+// Count t categorical draws by searching the cumulative sums, for few trials
+template <typename IntType, typename RNGType>
+inline void multinomial_distribution_count(RNGType &rng, std::size_t n,
+    IntType *r, IntType t, std::size_t dim, const double *cdf)
+{
+    const std::size_t K = BufferSize<double>::value;
+    alignas(MCKL_ALIGNMENT) std::array<double, K> s;
+    const std::size_t T = static_cast<std::size_t>(t);
+
+    std::fill_n(r, n * dim, 0);
+    std::size_t m = n * T;
+    std::size_t j = 0;
+    while (m != 0) {
+        const std::size_t k = std::min(K, m);
+        u01_co_distribution(rng, k, s.data());
+        for (std::size_t i = 0; i != k; ++i) {
+            const double *c = std::upper_bound(cdf, cdf + dim - 1, s[i]);
+            ++r[c - cdf];
+            if (++j == T) {
+                j = 0;
+                r += dim;
+            }
+        }
+        m -= k;
+    }
+}
+
+// Draw the counts one category at a time from their conditional binomial
+// distributions, for many trials
+template <typename IntType, typename RNGType>
+inline void multinomial_distribution_binomial(RNGType &rng, std::size_t n,
+    IntType *r, IntType t, std::size_t dim, const double *prob)
+{
+    using param_type = typename BinomialDistribution<IntType>::param_type;
+
+    BinomialDistribution<IntType> binomial;
+    for (std::size_t i = 0; i != n; ++i, r += dim) {
+        IntType m = t;
+        double q = 1;
+        std::size_t j = 0;
+        for (; j != dim - 1 && m != 0; ++j) {
+            const double p = q > prob[j] ? prob[j] / q : 1.0;
+            r[j] = binomial(rng, param_type(m, p));
+            m -= r[j];
+            q -= prob[j];
+        }
+        std::fill(r + j, r + dim, 0);
+        r[dim - 1] += m;
+    }
+}
+
+template <typename IntType, typename RNGType>
+inline void multinomial_distribution_impl(RNGType &rng, std::size_t n,
+    IntType *r, IntType t, std::size_t dim, const double *table)
+{
+    if (n * dim == 0) {
+        return;
+    }
+
+    if (static_cast<std::size_t>(t) <= dim * 4) {
+        multinomial_distribution_count(rng, n, r, t, dim, table + dim);
+    } else {
+        multinomial_distribution_binomial(rng, n, r, t, dim, table);
+    }
+}
+
+} // namespace internal
+
+/// \brief Generate multinomial random vectors
+/// \ingroup Distribution
+///
+/// \param rng The RNG engine
+/// \param n The number of vectors
+/// \param r The `n` by `dim` row major matrix of counts
+/// \param t The number of trials
+/// \param dim The number of categories
+/// \param prob The probabilities of the categories, normalized if necessary
+template <typename IntType, typename RNGType>
+inline void multinomial_distribution(RNGType &rng, std::size_t n, IntType *r,
+    IntType t, std::size_t dim, const double *prob)
+{
+    Vector<double> table(dim * 2);
+    internal::multinomial_distribution_table(dim, prob, table.data());
+    internal::multinomial_distribution_impl(rng, n, r, t, dim, table.data());
+}
+
+/// \brief Multinomial distribution
+/// \ingroup Distribution
+///
+/// \details
+/// If the number of trials is at most four times the number of categories,
+/// the uniform random numbers of all trials are generated in batches and
+/// counted by searching the cumulative probabilities. Otherwise the counts
+/// are generated one category at a time from their conditional binomial
+/// distributions.
+template <typename IntType>
+class MultinomialDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_INT_TYPE(Multinomial, 16)
+
+  public:
+    using result_type = IntType;
+    using distribution_type = MultinomialDistribution<IntType>;
+
+    MCKL_PUSH_CLANG_WARNING("-Wpadded")
+    class param_type
+    {
+      public:
+        using result_type = IntType;
+        using distribution_type = MultinomialDistribution<IntType>;
+
+        explicit param_type(result_type t = 1, std::size_t dim = 1)
+            : t_(t), prob_(dim, 1.0 / dim)
+        {
+            runtime_assert(internal::multinomial_distribution_check_param(
+                               t_, this->dim(), this->prob()),
+                "**MultinomialDistribution** constructed with invalid "
+                "arguments");
+        }
+
+        param_type(result_type t, std::size_t dim, const double *prob)
+            : t_(t), prob_(prob, prob + dim)
+        {
+            runtime_assert(internal::multinomial_distribution_check_param(
+                               t_, this->dim(), this->prob()),
+                "**MultinomialDistribution** constructed with invalid "
+                "arguments");
+            const double s = std::accumulate(prob_.begin(), prob_.end(), 0.0);
+            mul(dim, 1 / s, prob_.data(), prob_.data());
+        }
+
+        result_type t() const { return t_; }
+
+        std::size_t dim() const { return prob_.size(); }
+
+        const double *prob() const { return prob_.data(); }
+
+        friend bool operator==(
+            const param_type &param1, const param_type &param2)
+        {
+            if (param1.t_ != param2.t_) {
+                return false;
+            }
+            if (param1.prob_ != param2.prob_) {
+                return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(
+            const param_type &param1, const param_type &param2)
+        {
+            return !(param1 == param2);
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_ostream<CharT, Traits> &operator<<(
+            std::basic_ostream<CharT, Traits> &os, const param_type &param)
+        {
+            if (!os) {
+                return os;
+            }
+
+            os << param.t_ << ' ';
+            os << param.prob_;
+
+            return os;
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_istream<CharT, Traits> &operator>>(
+            std::basic_istream<CharT, Traits> &is, param_type &param)
+        {
+            if (!is) {
+                return is;
+            }
+
+            param_type tmp;
+            is >> std::ws >> tmp.t_;
+            is >> std::ws >> tmp.prob_;
+
+            if (is) {
+                param = std::move(tmp);
+            } else {
+                is.setstate(std::ios_base::failbit);
+            }
+
+            return is;
+        }
+
+      private:
+        result_type t_;
+        Vector<double> prob_;
+    }; // class param_type
+    MCKL_POP_CLANG_WARNING
+
+    /// \brief Construct a distribution with equal probabilities
+    explicit MultinomialDistribution(result_type t = 1, std::size_t dim = 1)
+        : param_(t, dim)
+    {
+        reset();
+    }
+
+    /// \brief Construct a distribution with given probabilities
+    MultinomialDistribution(
+        result_type t, std::size_t dim, const double *prob)
+        : param_(t, dim, prob)
+    {
+        reset();
+    }
+
+    explicit MultinomialDistribution(const param_type &param) : param_(param)
+    {
+        reset();
+    }
+
+    explicit MultinomialDistribution(param_type &&param)
+        : param_(std::move(param))
+    {
+        reset();
+    }
+
+    template <typename OutputIter>
+    OutputIter min(OutputIter first) const
+    {
+        return std::fill_n(first, dim(), 0);
+    }
+
+    template <typename OutputIter>
+    OutputIter max(OutputIter first) const
+    {
+        return std::fill_n(first, dim(), t());
+    }
+
+    void reset()
+    {
+        table_.resize(dim() * 2);
+        internal::multinomial_distribution_table(
+            dim(), prob(), table_.data());
+    }
+
+    result_type t() const { return param_.t(); }
+
+    std::size_t dim() const { return param_.dim(); }
+
+    const double *prob() const { return param_.prob(); }
+
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param)
+    {
+        param_ = param;
+        reset();
+    }
+
+    void param(param_type &&param)
+    {
+        param_ = std::move(param);
+        reset();
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r)
+    {
+        operator()(rng, 1, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r, const param_type &param)
+    {
+        operator()(rng, 1, r, param);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r)
+    {
+        operator()(rng, n, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(
+        RNGType &rng, std::size_t n, result_type *r, const param_type &param)
+    {
+        if (param == param_) {
+            internal::multinomial_distribution_impl(
+                rng, n, r, t(), dim(), table_.data());
+        } else {
+            multinomial_distribution(
+                rng, n, r, param.t(), param.dim(), param.prob());
+        }
+    }
+
+    friend bool operator==(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return dist1.param_ == dist2.param_;
+    }
+
+    friend bool operator!=(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return !(dist1 == dist2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const distribution_type &dist)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << dist.param_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, distribution_type &dist)
+    {
+        if (!is) {
+            return is;
+        }
+
+        param_type param;
+        is >> std::ws >> param;
+        if (is) {
+            dist.param(std::move(param));
+        }
+
+        return is;
+    }
+
+  private:
+    param_type param_;
+    Vector<double> table_;
+}; // class MultinomialDistribution
+
+template <typename IntType, typename RNGType>
+inline void rand(RNGType &rng, MultinomialDistribution<IntType> &distribution,
+    IntType *r)
+{
+    distribution(rng, r);
+}
+
+template <typename IntType, typename RNGType>
+inline void rand(RNGType &rng, MultinomialDistribution<IntType> &distribution,
+    std::size_t n, IntType *r)
+{
+    distribution(rng, n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_MULTINOMIAL_DISTRIBUTION_HPP
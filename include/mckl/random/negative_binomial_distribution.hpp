@@ -0,0 +1,127 @@
+//============================================================================
+// MCKL/include/mckl/random/negative_binomial_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION_HPP
+#define MCKL_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/gamma_distribution.hpp>
+#include <mckl/random/poisson_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+inline bool negative_binomial_distribution_check_param(double k, double p)
+{
+    return k > 0 && p > 0 && p <= 1;
+}
+
+template <typename IntType, typename RNGType>
+inline IntType negative_binomial_distribution_poisson(
+    RNGType &rng, double mean)
+{
+    if (!(mean > 0)) {
+        return 0;
+    }
+
+    PoissonDistribution<IntType> poisson(mean);
+
+    return poisson(rng);
+}
+
+template <std::size_t K, typename IntType, typename RNGType>
+inline void negative_binomial_distribution_impl(
+    RNGType &rng, std::size_t n, IntType *r, double k, double p)
+{
+    if (p >= 1) {
+        std::fill_n(r, n, 0);
+        return;
+    }
+
+    alignas(MCKL_ALIGNMENT) std::array<double, K> s;
+    double *const g = s.data();
+    gamma_distribution(rng, n, g, k, (1 - p) / p);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = negative_binomial_distribution_poisson<IntType>(rng, g[i]);
+    }
+}
+
+} // namespace internal
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
+    NegativeBinomial, negative_binomial, IntType, double, k, double, p)
+
+/// \brief Negative binomial distribution
+/// \ingroup Distribution
+///
+/// \details
+/// The number of failures before the `k`-th success of Bernoulli trials with
+/// success probability `p`, where `k` may be any positive real number. It is
+/// generated as a Poisson random variable whose mean is a gamma random
+/// variable with shape `k` and scale \f$(1 - p) / p\f$, and the gamma random
+/// variables are generated by the batch algorithms of GammaDistribution.
+template <typename IntType>
+class NegativeBinomialDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_INT_TYPE(NegativeBinomial, 16)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_2(NegativeBinomial, negative_binomial,
+        IntType, double, k, 1, double, p, 0.5)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_MEMBER_0
+
+  public:
+    result_type min() const { return 0; }
+
+    result_type max() const { return std::numeric_limits<IntType>::max(); }
+
+    void reset() {}
+
+  private:
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        if (param.p() >= 1) {
+            return 0;
+        }
+
+        GammaDistribution<double> gamma(
+            param.k(), (1 - param.p()) / param.p());
+
+        return internal::negative_binomial_distribution_poisson<IntType>(
+            rng, gamma(rng));
+    }
+}; // class NegativeBinomialDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(NegativeBinomial, IntType)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_NEGATIVE_BINOMIAL_DISTRIBUTION_HPP
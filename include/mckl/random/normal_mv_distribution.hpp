@@ -34,6 +34,7 @@
 
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/normal_ziggurat_distribution.hpp>
 
 namespace mckl {
 
@@ -57,34 +58,33 @@ inline void normal_mv_distribution_mulchol(
         static_cast<MCKL_BLAS_INT>(dim), r, static_cast<MCKL_BLAS_INT>(dim));
 }
 
-} // namespace internal
-
-template <typename RealType, typename RNGType>
-inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
-    std::size_t dim, RealType mean, RealType chol)
+template <typename NormalType, typename RealType, typename RNGType>
+inline void normal_mv_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType mean, RealType chol)
 {
-    internal::size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
-    internal::size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
 
-    normal_distribution(rng, n * dim, r, mean, chol);
+    NormalType normal(mean, chol);
+    normal(rng, n * dim, r);
 }
 
-template <typename RealType, typename RNGType>
-inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
-    std::size_t dim, RealType mean, const RealType *chol)
+template <typename NormalType, typename RealType, typename RNGType>
+inline void normal_mv_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType mean, const RealType *chol)
 {
-    internal::size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
-    internal::size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
 
-    normal_distribution(
-        rng, n * dim, r, const_zero<RealType>(), const_one<RealType>());
+    NormalType normal(0, 1);
+    normal(rng, n * dim, r);
     Vector<RealType> cholf(dim * dim);
     for (std::size_t i = 0; i != dim; ++i) {
         for (std::size_t j = 0; j <= i; ++j) {
             cholf[i * dim + j] = *chol++;
         }
     }
-    internal::normal_mv_distribution_mulchol(n, r, dim, cholf.data());
+    normal_mv_distribution_mulchol(n, r, dim, cholf.data());
     MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
     MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
     if (mean != 0) {
@@ -94,62 +94,135 @@ inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
     MCKL_POP_INTEL_WARNING
 }
 
-template <typename RealType, typename RNGType>
-inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
-    std::size_t dim, const RealType *mean, RealType chol)
+template <typename NormalType, typename RealType, typename RNGType>
+inline void normal_mv_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, const RealType *mean, RealType chol)
 {
-    internal::size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
-    internal::size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
 
-    normal_distribution(rng, n * dim, r, const_zero<RealType>(), chol);
+    NormalType normal(0, chol);
+    normal(rng, n * dim, r);
     for (std::size_t i = 0; i != n; ++i, r += dim) {
         add<RealType>(dim, mean, r, r);
     }
 }
 
-template <typename RealType, typename RNGType>
-inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
-    std::size_t dim, const RealType *mean, const RealType *chol)
+template <typename NormalType, typename RealType, typename RNGType>
+inline void normal_mv_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, const RealType *mean, const RealType *chol)
 {
-    internal::size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
-    internal::size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(n, "normal_mv_distribution");
+    size_check<MCKL_BLAS_INT>(dim, "normal_mv_distribution");
 
-    normal_distribution(
-        rng, n * dim, r, const_zero<RealType>(), const_one<RealType>());
+    NormalType normal(0, 1);
+    normal(rng, n * dim, r);
     Vector<RealType> cholf(dim * dim);
     for (std::size_t i = 0; i != dim; ++i) {
         for (std::size_t j = 0; j <= i; ++j) {
             cholf[i * dim + j] = *chol++;
         }
     }
-    internal::normal_mv_distribution_mulchol(n, r, dim, cholf.data());
+    normal_mv_distribution_mulchol(n, r, dim, cholf.data());
     for (std::size_t i = 0; i != n; ++i, r += dim) {
         add<RealType>(dim, mean, r, r);
     }
 }
 
+} // namespace internal
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType mean, RealType chol)
+{
+    internal::normal_mv_distribution_impl<NormalDistribution<RealType>>(
+        rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType mean, const RealType *chol)
+{
+    internal::normal_mv_distribution_impl<NormalDistribution<RealType>>(
+        rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, const RealType *mean, RealType chol)
+{
+    internal::normal_mv_distribution_impl<NormalDistribution<RealType>>(
+        rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, const RealType *mean, const RealType *chol)
+{
+    internal::normal_mv_distribution_impl<NormalDistribution<RealType>>(
+        rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_ziggurat_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType mean, RealType chol)
+{
+    internal::normal_mv_distribution_impl<
+        NormalZigguratDistribution<RealType>>(rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_ziggurat_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType mean, const RealType *chol)
+{
+    internal::normal_mv_distribution_impl<
+        NormalZigguratDistribution<RealType>>(rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_ziggurat_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, const RealType *mean, RealType chol)
+{
+    internal::normal_mv_distribution_impl<
+        NormalZigguratDistribution<RealType>>(rng, n, r, dim, mean, chol);
+}
+
+template <typename RealType, typename RNGType>
+inline void normal_mv_ziggurat_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, const RealType *mean, const RealType *chol)
+{
+    internal::normal_mv_distribution_impl<
+        NormalZigguratDistribution<RealType>>(rng, n, r, dim, mean, chol);
+}
+
 /// \brief Multivariate Normal distribution
 /// \ingroup Distribution
 ///
 /// \details
 /// The distribution is parameterized by its mean vector and the lower
 /// triangular elements of the Cholesky decomposition of the covaraince matrix,
-/// packed row by row.
-template <typename RealType>
+/// packed row by row. The standard Normal variates are generated by the
+/// univariate distribution `NormalType`, either `NormalDistribution` or
+/// `NormalZigguratDistribution`, see `NormalMVZigguratDistribution`.
+template <typename RealType, typename NormalType>
 class NormalMVDistribution
 {
     MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_BLAS_TYPE(NormalMV)
+    static_assert(
+        std::is_same<typename NormalType::result_type, RealType>::value,
+        "**NormalMVDistribution** used with NormalType of a different "
+        "result_type");
 
   public:
     using result_type = RealType;
-    using distribution_type = NormalMVDistribution<RealType>;
+    using distribution_type = NormalMVDistribution<RealType, NormalType>;
 
     MCKL_PUSH_CLANG_WARNING("-Wpadded")
     class param_type
     {
       public:
         using result_type = RealType;
-        using distribution_type = NormalMVDistribution<RealType>;
+        using distribution_type = NormalMVDistribution<RealType, NormalType>;
 
         explicit param_type(std::size_t dim = 1)
             : mean_(dim, 0)
@@ -389,16 +462,16 @@ class NormalMVDistribution
         RNGType &rng, std::size_t n, result_type *r, const param_type &param)
     {
         if (param.is_scalar_mean_ && param.is_scalar_chol_) {
-            normal_mv_distribution(
+            internal::normal_mv_distribution_impl<NormalType>(
                 rng, n, r, param.dim(), param.mean()[0], param.chol()[0]);
         } else if (param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            normal_mv_distribution(
+            internal::normal_mv_distribution_impl<NormalType>(
                 rng, n, r, param.dim(), param.mean()[0], param.chol());
         } else if (!param.is_scalar_mean_ && param.is_scalar_chol_) {
-            normal_mv_distribution(
+            internal::normal_mv_distribution_impl<NormalType>(
                 rng, n, r, param.dim(), param.mean(), param.chol()[0]);
         } else if (!param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            normal_mv_distribution(
+            internal::normal_mv_distribution_impl<NormalType>(
                 rng, n, r, param.dim(), param.mean(), param.chol());
         }
     }
@@ -457,13 +530,13 @@ class NormalMVDistribution
         MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
         MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
         if (param.is_scalar_mean_ && param.is_scalar_chol_) {
-            NormalDistribution<RealType> normal(
+            NormalType normal(
                 param.mean()[0], param.chol()[0]);
             for (std::size_t i = 0; i != param.dim(); ++i) {
                 r[i] = normal(rng);
             }
         } else if (param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            NormalDistribution<RealType> normal(0, 1);
+            NormalType normal(0, 1);
             for (std::size_t i = 0; i != param.dim(); ++i) {
                 r[i] = normal(rng);
             }
@@ -472,13 +545,13 @@ class NormalMVDistribution
                 add<result_type>(param.dim(), param.mean(), r, r);
             }
         } else if (!param.is_scalar_mean_ && param.is_scalar_chol_) {
-            NormalDistribution<RealType> normal(0, param.chol()[0]);
+            NormalType normal(0, param.chol()[0]);
             for (std::size_t i = 0; i != param.dim(); ++i) {
                 r[i] = normal(rng);
             }
             add<result_type>(param.dim(), param.mean(), r, r);
         } else if (!param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            NormalDistribution<RealType> normal(0, 1);
+            NormalType normal(0, 1);
             normal(rng, param.dim(), r);
             mulchol(r, param);
             add<result_type>(param.dim(), param.mean(), r, r);
@@ -502,16 +575,23 @@ class NormalMVDistribution
     }
 }; // class NormalMVDistribution
 
-template <typename RealType, typename RNGType>
-inline void rand(
-    RNGType &rng, NormalMVDistribution<RealType> &distribution, RealType *r)
+/// \brief Multivariate Normal distribution using the Ziggurat algorithm
+/// \ingroup Distribution
+template <typename RealType = double>
+using NormalMVZigguratDistribution =
+    NormalMVDistribution<RealType, NormalZigguratDistribution<RealType>>;
+
+template <typename RealType, typename NormalType, typename RNGType>
+inline void rand(RNGType &rng,
+    NormalMVDistribution<RealType, NormalType> &distribution, RealType *r)
 {
     distribution(rng, r);
 }
 
-template <typename RealType, typename RNGType>
-inline void rand(RNGType &rng, NormalMVDistribution<RealType> &distribution,
-    std::size_t n, RealType *r)
+template <typename RealType, typename NormalType, typename RNGType>
+inline void rand(RNGType &rng,
+    NormalMVDistribution<RealType, NormalType> &distribution, std::size_t n,
+    RealType *r)
 {
     distribution(rng, n, r);
 }
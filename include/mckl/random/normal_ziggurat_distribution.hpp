@@ -0,0 +1,250 @@
+//============================================================================
+// MCKL/include/mckl/random/normal_ziggurat_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION_HPP
+#define MCKL_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/uniform_bits_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename RealType>
+inline bool normal_ziggurat_distribution_check_param(
+    RealType, RealType stddev)
+{
+    return stddev > 0;
+}
+
+/// \brief Tables of the Ziggurat algorithm with 256 layers
+///
+/// \details
+/// See J. A. Doornik, "An improved Ziggurat method to generate Normal random
+/// samples", 2005.
+class NormalZigguratTable
+{
+  public:
+    static constexpr std::size_t layers() { return 256; }
+
+    static const NormalZigguratTable &instance()
+    {
+        static NormalZigguratTable table;
+
+        return table;
+    }
+
+    /// \brief The right end of the tail region
+    static constexpr double tail() { return 3.6541528853610088; }
+
+    /// \brief \f$x_i\f$, \f$i = 0,\dots,256\f$
+    const double *x() const { return x_.data(); }
+
+    /// \brief \f$x_{i + 1} / x_i\f$, \f$i = 0,\dots,255\f$
+    const double *r() const { return r_.data(); }
+
+  private:
+    alignas(MCKL_ALIGNMENT) std::array<double, 257> x_;
+    alignas(MCKL_ALIGNMENT) std::array<double, 256> r_;
+
+    NormalZigguratTable()
+    {
+        const double v = 0.00492867323399;
+        double f = std::exp(-0.5 * tail() * tail());
+        x_[0] = v / f;
+        x_[1] = tail();
+        x_[256] = 0;
+        for (std::size_t i = 2; i != 256; ++i) {
+            x_[i] = std::sqrt(-2 * std::log(v / x_[i - 1] + f));
+            f = std::exp(-0.5 * x_[i] * x_[i]);
+        }
+        for (std::size_t i = 0; i != 256; ++i) {
+            r_[i] = x_[i + 1] / x_[i];
+        }
+    }
+}; // class NormalZigguratTable
+
+// Uniform on [-1, 1) from the high 53 bits, the low 8 bits select the layer
+inline double normal_ziggurat_distribution_u(std::uint64_t u)
+{
+    return static_cast<double>(static_cast<std::int64_t>(u >> 11)) *
+        2.220446049250313080847263336181640625e-16 -
+        1;
+}
+
+// The slow path, when the fast acceptance test failed for layer i
+template <typename RNGType>
+inline double normal_ziggurat_distribution_slow(
+    RNGType &rng, const NormalZigguratTable &table, double u, std::size_t i)
+{
+    const double *const x = table.x();
+    const double *const r = table.r();
+    UniformBitsDistribution<std::uint64_t> ubits;
+    U01OCDistribution<double> u01;
+    while (true) {
+        if (i == 0) {
+            double v = 0;
+            double w = 0;
+            do {
+                v = std::log(u01(rng)) / table.tail();
+                w = std::log(u01(rng));
+            } while (-2 * w < v * v);
+
+            return u < 0 ? v - table.tail() : table.tail() - v;
+        }
+
+        const double z = u * x[i];
+        const double z2 = z * z;
+        const double f0 = std::exp(-0.5 * (x[i] * x[i] - z2));
+        const double f1 = std::exp(-0.5 * (x[i + 1] * x[i + 1] - z2));
+        if (f1 + u01(rng) * (f0 - f1) < 1) {
+            return z;
+        }
+
+        const std::uint64_t b = ubits(rng);
+        u = normal_ziggurat_distribution_u(b);
+        i = static_cast<std::size_t>(b & 0xFF);
+        if (std::abs(u) < r[i]) {
+            return u * x[i];
+        }
+    }
+}
+
+template <typename RNGType>
+inline double normal_ziggurat_distribution(RNGType &rng)
+{
+    const NormalZigguratTable &table = NormalZigguratTable::instance();
+    UniformBitsDistribution<std::uint64_t> ubits;
+    const std::uint64_t b = ubits(rng);
+    const double u = normal_ziggurat_distribution_u(b);
+    const std::size_t i = static_cast<std::size_t>(b & 0xFF);
+    if (std::abs(u) < table.r()[i]) {
+        return u * table.x()[i];
+    }
+
+    return normal_ziggurat_distribution_slow(rng, table, u, i);
+}
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline void normal_ziggurat_distribution_impl(
+    RNGType &rng, std::size_t n, RealType *r, RealType mean, RealType stddev)
+{
+    alignas(MCKL_ALIGNMENT) std::array<std::uint64_t, K> b;
+    alignas(MCKL_ALIGNMENT) std::array<double, K> u;
+    alignas(MCKL_ALIGNMENT) std::array<double, K> z;
+    alignas(MCKL_ALIGNMENT) std::array<int, K> a;
+
+    const NormalZigguratTable &table = NormalZigguratTable::instance();
+    const double *const x = table.x();
+    const double *const t = table.r();
+    uniform_bits_distribution(rng, n, b.data());
+
+    // Fast path, branch free and vectorizable
+    for (std::size_t i = 0; i != n; ++i) {
+        u[i] = normal_ziggurat_distribution_u(b[i]);
+    }
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t j = static_cast<std::size_t>(b[i] & 0xFF);
+        z[i] = u[i] * x[j];
+        a[i] = std::abs(u[i]) < t[j];
+    }
+
+    // Slow path, in order such that the results depend only on the RNG
+    // stream
+    for (std::size_t i = 0; i != n; ++i) {
+        if (a[i] == 0) {
+            z[i] = normal_ziggurat_distribution_slow(
+                rng, table, u[i], static_cast<std::size_t>(b[i] & 0xFF));
+        }
+    }
+
+    MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+    MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+    if (mean != 0 || stddev != 1) {
+        const double m = static_cast<double>(mean);
+        const double s = static_cast<double>(stddev);
+        muladd(n, z.data(), s, m, z.data());
+    }
+    MCKL_POP_CLANG_WARNING
+    MCKL_POP_INTEL_WARNING
+    std::copy_n(z.data(), n, r);
+}
+
+} // namespace internal
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(NormalZiggurat, normal_ziggurat,
+    RealType, RealType, mean, RealType, stddev)
+
+/// \brief Normal distribution using the Ziggurat algorithm
+/// \ingroup Distribution
+///
+/// \details
+/// The `NormalDistribution` uses the Box-Muller method, which requires `log`,
+/// `sqrt` and `sincos` for every pair of variates. The Ziggurat algorithm
+/// requires only table lookups and a multiplication for most of the variates.
+/// Both have the same distribution, but produce different sequences from the
+/// same RNG stream.
+template <typename RealType>
+class NormalZigguratDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_REAL_TYPE(NormalZiggurat)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_2(NormalZiggurat, normal_ziggurat,
+        RealType, result_type, mean, 0, result_type, stddev, 1)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_MEMBER_0
+
+  public:
+    result_type min() const
+    {
+        return std::numeric_limits<result_type>::lowest();
+    }
+
+    result_type max() const { return std::numeric_limits<result_type>::max(); }
+
+    void reset() {}
+
+  private:
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        return param.mean() +
+            param.stddev() *
+            static_cast<result_type>(
+                internal::normal_ziggurat_distribution(rng));
+    }
+}; // class NormalZigguratDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(NormalZiggurat, RealType)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_NORMAL_ZIGGURAT_DISTRIBUTION_HPP
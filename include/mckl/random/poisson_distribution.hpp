@@ -0,0 +1,292 @@
+//============================================================================
+// MCKL/include/mckl/random/poisson_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_POISSON_DISTRIBUTION_HPP
+#define MCKL_RANDOM_POISSON_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/u01_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+inline bool poisson_distribution_check_param(double mean)
+{
+    return mean > 0;
+}
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Constants of the inversion and the PTRS algorithms
+///
+/// \details
+/// The PTRS (transformed rejection with squeeze) algorithm is that of
+/// Hormann (1993), The transformed rejection method for generating Poisson
+/// random variables, Insurance: Mathematics and Economics, 12, 39-45. It is
+/// used for means not less than ten.
+class PoissonDistributionConstant
+{
+  public:
+    PoissonDistributionConstant(double mean = 1)
+        : inversion_(mean < 10)
+        , a_(0)
+        , b_(0)
+        , vr_(0)
+        , lnia_(0)
+        , lnmean_(std::log(mean))
+        , emean_(std::exp(-mean))
+    {
+        if (!inversion_) {
+            b_ = 0.931 + 2.53 * std::sqrt(mean);
+            a_ = -0.059 + 0.02483 * b_;
+            vr_ = 0.9277 - 3.6224 / (b_ - 2);
+            lnia_ = std::log(1.1239 + 1.1328 / (b_ - 3.4));
+        }
+    }
+
+    bool inversion() const { return inversion_; }
+    double a() const { return a_; }
+    double b() const { return b_; }
+    double vr() const { return vr_; }
+    double lnia() const { return lnia_; }
+    double lnmean() const { return lnmean_; }
+    double emean() const { return emean_; }
+
+    /// \brief The acceptance test of PTRS after the squeeze fails
+    bool accept(double mean, double us, double v, double k) const
+    {
+        if (k < 0 || (us < 0.013 && v > us)) {
+            return false;
+        }
+
+        return std::log(v) + lnia_ - std::log(a_ / (us * us) + b_) <=
+            -mean + k * lnmean_ - std::lgamma(k + 1);
+    }
+
+    /// \brief The inversion from a standard uniform random number
+    double invert(double mean, double u) const
+    {
+        double k = 0;
+        double p = emean_;
+        double f = p;
+        while (u > f && p > 0) {
+            k += 1;
+            p *= mean / k;
+            f += p;
+        }
+
+        return k;
+    }
+
+  private:
+    bool inversion_;
+    double a_;
+    double b_;
+    double vr_;
+    double lnia_;
+    double lnmean_;
+    double emean_;
+}; // class PoissonDistributionConstant
+MCKL_POP_CLANG_WARNING
+
+template <std::size_t K, typename IntType, typename RNGType>
+inline std::size_t poisson_distribution_impl_i(RNGType &rng, std::size_t n,
+    IntType *r, double mean, const PoissonDistributionConstant &constant)
+{
+    alignas(MCKL_ALIGNMENT) std::array<double, K> s;
+    double *const u = s.data();
+    u01_co_distribution(rng, n, u);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = ftoi<IntType>(constant.invert(mean, u[i]));
+    }
+
+    return n;
+}
+
+template <std::size_t K, typename IntType, typename RNGType>
+inline std::size_t poisson_distribution_impl_r(RNGType &rng, std::size_t n,
+    IntType *r, double mean, const PoissonDistributionConstant &constant)
+{
+    alignas(MCKL_ALIGNMENT) std::array<double, K * 4> s;
+    double *const u = s.data();
+    double *const v = s.data() + n;
+    double *const us = s.data() + n * 2;
+    double *const k = s.data() + n * 3;
+
+    u01_oo_distribution(rng, n * 2, s.data());
+    sub(n, u, 0.5, u);
+    abs(n, u, us);
+    sub(n, 0.5, us, us);
+    div(n, 2 * constant.a(), us, k);
+    add(n, k, constant.b(), k);
+    mul(n, k, u, k);
+    add(n, k, mean + 0.43, k);
+    floor(n, k, k);
+
+    const double vr = constant.vr();
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        if ((us[i] >= 0.07 && v[i] <= vr) ||
+            constant.accept(mean, us[i], v[i], k[i])) {
+            r[m++] = ftoi<IntType>(k[i]);
+        }
+    }
+
+    return m;
+}
+
+template <std::size_t K, typename IntType, typename RNGType>
+inline std::size_t poisson_distribution_impl(RNGType &rng, std::size_t n,
+    IntType *r, double mean, const PoissonDistributionConstant &constant)
+{
+    return constant.inversion() ?
+        poisson_distribution_impl_i<K>(rng, n, r, mean, constant) :
+        poisson_distribution_impl_r<K>(rng, n, r, mean, constant);
+}
+
+} // namespace internal
+
+template <typename IntType, typename RNGType>
+inline void poisson_distribution(
+    RNGType &rng, std::size_t n, IntType *r, double mean)
+{
+    const std::size_t k = BufferSize<double>::value / 4;
+    const internal::PoissonDistributionConstant constant(mean);
+    while (n > k) {
+        std::size_t m =
+            internal::poisson_distribution_impl<k>(rng, k, r, mean, constant);
+        if (m == 0) {
+            break;
+        }
+        n -= m;
+        r += m;
+    }
+    std::size_t m =
+        internal::poisson_distribution_impl<k>(rng, n, r, mean, constant);
+    n -= m;
+    r += m;
+    if (n > 0) {
+        PoissonDistribution<IntType> dist(mean);
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = dist(rng);
+        }
+    }
+}
+
+template <typename IntType, typename RNGType>
+inline void poisson_distribution(RNGType &rng, std::size_t n, IntType *r,
+    const typename PoissonDistribution<IntType>::param_type &param)
+{
+    poisson_distribution(rng, n, r, param.mean());
+}
+
+/// \brief Poisson distribution
+/// \ingroup Distribution
+///
+/// \details
+/// Means less than ten are generated by inversion, and larger ones by the
+/// PTRS transformed rejection algorithm, whose squeeze accepts most proposals
+/// in the vectorized batch generation
+template <typename IntType>
+class PoissonDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_INT_TYPE(Poisson, 16)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_1(
+        Poisson, poisson, IntType, double, mean, 1)
+
+  public:
+    result_type min() const { return 0; }
+
+    result_type max() const { return std::numeric_limits<IntType>::max(); }
+
+    void reset()
+    {
+        constant_ = internal::PoissonDistributionConstant(mean());
+    }
+
+  private:
+    internal::PoissonDistributionConstant constant_;
+
+    bool is_equal(const distribution_type &) const { return true; }
+
+    template <typename CharT, typename Traits>
+    void ostream(std::basic_ostream<CharT, Traits> &) const
+    {
+    }
+
+    template <typename CharT, typename Traits>
+    void istream(std::basic_istream<CharT, Traits> &)
+    {
+        reset();
+    }
+
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        if (param == param_) {
+            return generate(rng, param_, constant_);
+        }
+
+        internal::PoissonDistributionConstant constant(param.mean());
+
+        return generate(rng, param, constant);
+    }
+
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param,
+        const internal::PoissonDistributionConstant &constant)
+    {
+        const double mean = param.mean();
+        if (constant.inversion()) {
+            U01CODistribution<double> u01;
+            return internal::ftoi<IntType>(constant.invert(mean, u01(rng)));
+        }
+
+        U01OODistribution<double> u01;
+        while (true) {
+            const double u = u01(rng) - 0.5;
+            const double v = u01(rng);
+            const double us = 0.5 - std::abs(u);
+            const double k = std::floor(
+                (2 * constant.a() / us + constant.b()) * u + mean + 0.43);
+            if ((us >= 0.07 && v <= constant.vr()) ||
+                constant.accept(mean, us, v, k)) {
+                return internal::ftoi<IntType>(k);
+            }
+        }
+    }
+}; // class PoissonDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(Poisson, IntType)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_POISSON_DISTRIBUTION_HPP
@@ -35,6 +35,7 @@
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/rng.hpp>
 #include <mckl/random/seed.hpp>
+#include <atomic>
 
 #if MCKL_HAS_TBB
 #include <tbb/enumerable_thread_specific.h>
@@ -119,6 +120,126 @@ class RNGSetVector
     Vector<rng_type> rng_;
 }; // class RNGSetVector
 
+/// \brief Counter-based RNG set with a compact per-particle state
+/// \ingroup Random
+///
+/// \details
+/// `RNGType` shall be a CounterEngine with a counter of at least 128 bits.
+/// All particles share a single key, and each particle only stores the
+/// number of sub-streams it has used so far, instead of a full engine. The
+/// low 32 bits of the counter are left for the engine to generate up to
+/// \f$2^{32}\f$ blocks within a sub-stream, the next 32 bits hold the index
+/// of the sub-stream and the high 64 bits hold the particle index.
+///
+/// Each call of `operator[]` sets an engine local to the calling thread to
+/// the next unused sub-stream of the requested particle, and returns a
+/// reference to it. Thus the random numbers of a particle never repeat,
+/// however the calls for different particles are interleaved, and they only
+/// depend on the number of calls made for this particle before, not on which
+/// thread makes them. The reference remains valid until the next call in the
+/// same thread. Therefore, obtain the engine once, for example,
+/// `auto &rng = rng_set[i]`, and generate all random numbers needed from it,
+/// instead of calling `rng_set[i]()` repeatedly, which uses a new block for
+/// each number.
+template <typename RNGType = RNG>
+class RNGSetCounter
+{
+  public:
+    using rng_type = RNGType;
+    using size_type = std::size_t;
+    using ctr_type = typename rng_type::ctr_type;
+    using key_type = typename rng_type::key_type;
+
+    static_assert(sizeof(ctr_type) >= 16,
+        "**RNGSetCounter** used with RNGType with a counter narrower than 128 "
+        "bits");
+
+    explicit RNGSetCounter(size_type N = 0) : size_(N), stream_(N, 0)
+    {
+        reset();
+    }
+
+    size_type size() const { return size_; }
+
+    /// \brief Change the number of particles
+    ///
+    /// \details
+    /// The numbers of sub-streams used are kept for particles removed, such
+    /// that their streams are not repeated if they are added back later.
+    void resize(std::size_t n)
+    {
+        size_ = n;
+        if (n > stream_.size()) {
+            stream_.resize(n, 0);
+        }
+    }
+
+    /// \brief Set a new key from the seed generator and restart all particles
+    /// from their first sub-streams
+    void reset()
+    {
+        rng_type rng(Seed<rng_type>::instance().get());
+        key_ = rng.key();
+        std::fill(stream_.begin(), stream_.end(), 0);
+        version_ = next_version();
+    }
+
+    rng_type &operator[](size_type id)
+    {
+        static thread_local cache_type cache;
+
+        if (cache.version != version_) {
+            cache.rng.key(key_);
+            cache.version = version_;
+        }
+
+        const size_type i = id % size_;
+        runtime_assert(
+            stream_[i] != std::numeric_limits<std::uint32_t>::max(),
+            "**RNGSetCounter::operator[]** used with a particle whose "
+            "sub-streams are exhausted");
+        cache.rng.ctr(counter(i, stream_[i]++));
+
+        return cache.rng;
+    }
+
+  private:
+    struct cache_type {
+        std::uint64_t version = 0;
+        rng_type rng;
+    }; // struct cache_type
+
+    size_type size_;
+    Vector<std::uint32_t> stream_;
+    key_type key_;
+    std::uint64_t version_;
+
+    static std::uint64_t next_version()
+    {
+        static std::atomic<std::uint64_t> version(0);
+
+        return ++version;
+    }
+
+    static ctr_type counter(size_type id, std::uint32_t stream)
+    {
+        using word_type = typename ctr_type::value_type;
+
+        constexpr std::size_t W = sizeof(word_type) * CHAR_BIT;
+        const std::uint64_t v[2] = {static_cast<std::uint64_t>(stream) << 32,
+            static_cast<std::uint64_t>(id)};
+
+        ctr_type ctr;
+        for (std::size_t k = 0; k != ctr.size(); ++k) {
+            const std::size_t b = k * W;
+            ctr[k] = b < 128 ? static_cast<word_type>(v[b / 64] >> (b % 64)) :
+                               0;
+        }
+
+        return ctr;
+    }
+}; // class RNGSetCounter
+
 #if MCKL_HAS_TBB
 
 /// \brief Thread-local storage RNG set using tbb::enumerable_thread_specific
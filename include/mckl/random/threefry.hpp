@@ -46,6 +46,14 @@
 #include <mckl/random/internal/threefry_avx2.hpp>
 #endif
 
+#if MCKL_HAS_AVX512
+#include <mckl/random/internal/threefry_avx512.hpp>
+#endif
+
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+#include <mckl/random/internal/threefry_dispatch.hpp>
+#endif
+
 /// \brief ThreefryGenerator default rounds
 /// \ingroup Config
 #ifndef MCKL_THREEFRY_ROUNDS
@@ -56,7 +64,11 @@ namespace mckl {
 
 namespace internal {
 
-#if MCKL_USE_AVX2
+#if MCKL_USE_AVX512
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
+using ThreefryGeneratorImpl =
+    ThreefryGeneratorAVX512Impl<T, K, Rounds, Constants>;
+#elif MCKL_USE_AVX2
 template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
 using ThreefryGeneratorImpl =
     ThreefryGeneratorAVX2Impl<T, K, Rounds, Constants>;
@@ -70,6 +82,16 @@ using ThreefryGeneratorImpl =
     ThreefryGeneratorGenericImpl<T, K, Rounds, Constants>;
 #endif // MCKL_USE_AVX2
 
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
+using ThreefryGeneratorBatchImpl = ThreefryGeneratorDispatchImpl<T, K,
+    Rounds, Constants, ThreefryGeneratorImpl<T, K, Rounds, Constants>>;
+#else
+template <typename T, std::size_t K, std::size_t Rounds, typename Constants>
+using ThreefryGeneratorBatchImpl =
+    ThreefryGeneratorImpl<T, K, Rounds, Constants>;
+#endif
+
 } // namespace internal
 
 /// \brief Threefry RNG generator
@@ -148,7 +170,7 @@ class ThreefryGenerator
     template <typename ResultType>
     void operator()(ctr_type &ctr, std::size_t n, ResultType *r) const
     {
-        internal::ThreefryGeneratorImpl<T, K, Rounds, Constants>::eval(
+        internal::ThreefryGeneratorBatchImpl<T, K, Rounds, Constants>::eval(
             ctr, n, r, par_);
     }
 
@@ -0,0 +1,437 @@
+//============================================================================
+// MCKL/include/mckl/random/truncated_normal_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION_HPP
+#define MCKL_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename RealType>
+inline bool truncated_normal_distribution_check_param(
+    RealType, RealType stddev, RealType lower, RealType upper)
+{
+    return stddev > 0 && lower < upper;
+}
+
+enum TruncatedNormalDistributionAlgorithm {
+    TruncatedNormalDistributionAlgorithmNaive,
+    TruncatedNormalDistributionAlgorithmUniform,
+    TruncatedNormalDistributionAlgorithmExponential
+}; // enum TruncatedNormalDistributionAlgorithm
+
+/// \brief Constants of the truncated Normal distribution
+///
+/// \details
+/// The bounds are standardized to \f$(\alpha, \beta)\f$. An interval in the
+/// left tail is reflected, such that either \f$\alpha < 0 < \beta\f$ or
+/// \f$\alpha \ge 0\f$. The algorithm is chosen as in C. P. Robert, Simulation
+/// of truncated normal variables, Statistics and Computing, 5 (1995). An
+/// interval wide enough and containing zero uses the Normal distribution as
+/// the proposal, a narrow interval uses the uniform distribution, and a tail
+/// uses the translated exponential distribution with the optimal rate.
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+template <typename RealType>
+class TruncatedNormalDistributionConstant
+{
+  public:
+    TruncatedNormalDistributionConstant(RealType mean = 0, RealType stddev = 1,
+        RealType lower = -const_inf<RealType>(),
+        RealType upper = const_inf<RealType>())
+    {
+        alpha_ = (lower - mean) / stddev;
+        beta_ = (upper - mean) / stddev;
+        flip_ = beta_ <= 0;
+        if (flip_) {
+            RealType tmp = alpha_;
+            alpha_ = -beta_;
+            beta_ = -tmp;
+        }
+
+        lambda_ = q_ = 0;
+        if (alpha_ < 0) {
+            if (beta_ - alpha_ < const_sqrt_pi_2<RealType>()) {
+                algorithm_ = TruncatedNormalDistributionAlgorithmUniform;
+            } else {
+                algorithm_ = TruncatedNormalDistributionAlgorithmNaive;
+            }
+        } else {
+            const RealType s = std::sqrt(alpha_ * alpha_ + 4);
+            const RealType w = 2 / (alpha_ + s) *
+                std::exp((alpha_ * alpha_ - alpha_ * s) / 4 +
+                    static_cast<RealType>(0.5));
+            if (beta_ - alpha_ < w) {
+                algorithm_ = TruncatedNormalDistributionAlgorithmUniform;
+                q_ = alpha_ * alpha_ / 2;
+            } else {
+                algorithm_ = TruncatedNormalDistributionAlgorithmExponential;
+                lambda_ = (alpha_ + s) / 2;
+            }
+        }
+    }
+
+    RealType alpha() const { return alpha_; }
+    RealType beta() const { return beta_; }
+    RealType lambda() const { return lambda_; }
+    RealType q() const { return q_; }
+    bool flip() const { return flip_; }
+
+    TruncatedNormalDistributionAlgorithm algorithm() const
+    {
+        return algorithm_;
+    }
+
+    friend bool operator==(
+        const TruncatedNormalDistributionConstant<RealType> &c1,
+        const TruncatedNormalDistributionConstant<RealType> &c2)
+    {
+        MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+        MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+        if (c1.alpha_ != c2.alpha_) {
+            return false;
+        }
+        if (c1.beta_ != c2.beta_) {
+            return false;
+        }
+        if (c1.lambda_ != c2.lambda_) {
+            return false;
+        }
+        if (c1.q_ != c2.q_) {
+            return false;
+        }
+        if (c1.flip_ != c2.flip_) {
+            return false;
+        }
+        if (c1.algorithm_ != c2.algorithm_) {
+            return false;
+        }
+        return true;
+        MCKL_POP_CLANG_WARNING
+        MCKL_POP_INTEL_WARNING
+    }
+
+  private:
+    RealType alpha_;
+    RealType beta_;
+    RealType lambda_;
+    RealType q_;
+    bool flip_;
+    TruncatedNormalDistributionAlgorithm algorithm_;
+}; // class TruncatedNormalDistributionConstant
+MCKL_POP_CLANG_WARNING
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline std::size_t truncated_normal_distribution_impl_naive(RNGType &rng,
+    std::size_t n, RealType *r,
+    const TruncatedNormalDistributionConstant<RealType> &constant)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    const RealType alpha = constant.alpha();
+    const RealType beta = constant.beta();
+    RealType *const z = s.data();
+
+    normal_distribution(
+        rng, n, z, const_zero<RealType>(), const_one<RealType>());
+
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (z[i] >= alpha && z[i] <= beta) {
+            r[m++] = z[i];
+        }
+    }
+
+    return m;
+}
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline std::size_t truncated_normal_distribution_impl_uniform(RNGType &rng,
+    std::size_t n, RealType *r,
+    const TruncatedNormalDistributionConstant<RealType> &constant)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K * 3> s;
+    const RealType alpha = constant.alpha();
+    const RealType beta = constant.beta();
+    RealType *const z = s.data();
+    RealType *const u = s.data() + n;
+    RealType *const e = s.data() + n * 2;
+
+    u01_oo_distribution(rng, n * 2, s.data());
+    muladd(n, z, beta - alpha, alpha, z);
+    log(n, u, u);
+    sqr(n, z, e);
+    muladd(n, e, static_cast<RealType>(-0.5), constant.q(), e);
+
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (u[i] <= e[i]) {
+            r[m++] = z[i];
+        }
+    }
+
+    return m;
+}
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline std::size_t truncated_normal_distribution_impl_exponential(
+    RNGType &rng, std::size_t n, RealType *r,
+    const TruncatedNormalDistributionConstant<RealType> &constant)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K * 3> s;
+    const RealType alpha = constant.alpha();
+    const RealType beta = constant.beta();
+    const RealType lambda = constant.lambda();
+    RealType *const z = s.data();
+    RealType *const u = s.data() + n;
+    RealType *const e = s.data() + n * 2;
+
+    u01_oo_distribution(rng, n * 2, s.data());
+    log(n * 2, s.data(), s.data());
+    muladd(n, z, -1 / lambda, alpha, z);
+    sub(n, z, lambda, e);
+    sqr(n, e, e);
+    mul(n, static_cast<RealType>(-0.5), e, e);
+
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        if (u[i] <= e[i] && z[i] <= beta) {
+            r[m++] = z[i];
+        }
+    }
+
+    return m;
+}
+
+template <std::size_t K, typename RealType, typename RNGType>
+inline std::size_t truncated_normal_distribution_impl(RNGType &rng,
+    std::size_t n, RealType *r, RealType mean, RealType stddev, RealType,
+    RealType, const TruncatedNormalDistributionConstant<RealType> &constant)
+{
+    std::size_t m = 0;
+    switch (constant.algorithm()) {
+        case TruncatedNormalDistributionAlgorithmNaive:
+            m = truncated_normal_distribution_impl_naive<K>(
+                rng, n, r, constant);
+            break;
+        case TruncatedNormalDistributionAlgorithmUniform:
+            m = truncated_normal_distribution_impl_uniform<K>(
+                rng, n, r, constant);
+            break;
+        case TruncatedNormalDistributionAlgorithmExponential:
+            m = truncated_normal_distribution_impl_exponential<K>(
+                rng, n, r, constant);
+            break;
+    }
+    muladd(m, r, constant.flip() ? -stddev : stddev, mean, r);
+
+    return m;
+}
+
+} // namespace internal
+
+template <typename RealType, typename RNGType>
+inline void truncated_normal_distribution(RNGType &rng, std::size_t n,
+    RealType *r, RealType mean, RealType stddev, RealType lower,
+    RealType upper)
+{
+    const std::size_t k = BufferSize<RealType>::value;
+    const internal::TruncatedNormalDistributionConstant<RealType> constant(
+        mean, stddev, lower, upper);
+    while (n > k) {
+        std::size_t m = internal::truncated_normal_distribution_impl<k>(
+            rng, k, r, mean, stddev, lower, upper, constant);
+        if (m == 0) {
+            break;
+        }
+        n -= m;
+        r += m;
+    }
+    std::size_t m = internal::truncated_normal_distribution_impl<k>(
+        rng, n, r, mean, stddev, lower, upper, constant);
+    n -= m;
+    r += m;
+    if (n > 0) {
+        TruncatedNormalDistribution<RealType> dist(mean, stddev, lower, upper);
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = dist(rng);
+        }
+    }
+}
+
+template <typename RealType, typename RNGType>
+inline void truncated_normal_distribution(RNGType &rng, std::size_t n,
+    RealType *r,
+    const typename TruncatedNormalDistribution<RealType>::param_type &param)
+{
+    truncated_normal_distribution(rng, n, r, param.mean(), param.stddev(),
+        param.lower(), param.upper());
+}
+
+/// \brief Normal distribution truncated to an interval
+/// \ingroup Distribution
+///
+/// \details
+/// Either bound may be infinite, and the default is the standard Normal
+/// distribution with no truncation. The batch interface vectorizes the
+/// proposal and the acceptance test, and is best suited for drawing many
+/// variates with the same parameters, such as in Gibbs samplers of probit
+/// models.
+template <typename RealType>
+class TruncatedNormalDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_REAL_TYPE(TruncatedNormal)
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_4(TruncatedNormal, truncated_normal,
+        RealType, result_type, mean, 0, result_type, stddev, 1, result_type,
+        lower, -const_inf<result_type>(), result_type, upper,
+        const_inf<result_type>())
+
+  public:
+    result_type min() const { return lower(); }
+
+    result_type max() const { return upper(); }
+
+    void reset()
+    {
+        constant_ = internal::TruncatedNormalDistributionConstant<RealType>(
+            mean(), stddev(), lower(), upper());
+    }
+
+  private:
+    internal::TruncatedNormalDistributionConstant<RealType> constant_;
+
+    bool is_equal(const distribution_type &other) const
+    {
+        return constant_ == other.constant_;
+    }
+
+    template <typename CharT, typename Traits>
+    void ostream(std::basic_ostream<CharT, Traits> &) const
+    {
+    }
+
+    template <typename CharT, typename Traits>
+    void istream(std::basic_istream<CharT, Traits> &)
+    {
+        reset();
+    }
+
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param)
+    {
+        if (param == param_) {
+            return generate(rng, param_, constant_);
+        }
+
+        internal::TruncatedNormalDistributionConstant<RealType> constant(
+            param.mean(), param.stddev(), param.lower(), param.upper());
+
+        return generate(rng, param, constant);
+    }
+
+    template <typename RNGType>
+    result_type generate(RNGType &rng, const param_type &param,
+        const internal::TruncatedNormalDistributionConstant<RealType>
+            &constant)
+    {
+        result_type r = 0;
+        switch (constant.algorithm()) {
+            case internal::TruncatedNormalDistributionAlgorithmNaive:
+                r = generate_naive(rng, constant);
+                break;
+            case internal::TruncatedNormalDistributionAlgorithmUniform:
+                r = generate_uniform(rng, constant);
+                break;
+            case internal::TruncatedNormalDistributionAlgorithmExponential:
+                r = generate_exponential(rng, constant);
+                break;
+        }
+
+        return param.mean() + (constant.flip() ? -r : r) * param.stddev();
+    }
+
+    template <typename RNGType>
+    result_type generate_naive(RNGType &rng,
+        const internal::TruncatedNormalDistributionConstant<RealType>
+            &constant)
+    {
+        NormalDistribution<RealType> rnorm(0, 1);
+        result_type z = 0;
+        do {
+            z = rnorm(rng);
+        } while (z < constant.alpha() || z > constant.beta());
+
+        return z;
+    }
+
+    template <typename RNGType>
+    result_type generate_uniform(RNGType &rng,
+        const internal::TruncatedNormalDistributionConstant<RealType>
+            &constant)
+    {
+        U01OODistribution<RealType> u01;
+        const result_type a = constant.alpha();
+        const result_type b = constant.beta();
+        while (true) {
+            result_type z = a + (b - a) * u01(rng);
+            result_type u = std::log(u01(rng));
+            if (u <= constant.q() - z * z / 2) {
+                return z;
+            }
+        }
+    }
+
+    template <typename RNGType>
+    result_type generate_exponential(RNGType &rng,
+        const internal::TruncatedNormalDistributionConstant<RealType>
+            &constant)
+    {
+        U01OODistribution<RealType> u01;
+        const result_type lambda = constant.lambda();
+        while (true) {
+            result_type z = constant.alpha() - std::log(u01(rng)) / lambda;
+            result_type u = std::log(u01(rng));
+            if (u <= -(z - lambda) * (z - lambda) / 2 &&
+                z <= constant.beta()) {
+                return z;
+            }
+        }
+    }
+}; // class TruncatedNormalDistribution
+
+MCKL_DEFINE_RANDOM_DISTRIBUTION_RAND(TruncatedNormal, RealType)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_TRUNCATED_NORMAL_DISTRIBUTION_HPP
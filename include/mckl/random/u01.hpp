@@ -43,6 +43,10 @@
 #include <mckl/random/internal/u01_avx512.hpp>
 #endif
 
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+#include <mckl/random/internal/u01_dispatch.hpp>
+#endif
+
 namespace mckl {
 
 namespace internal {
@@ -73,6 +77,26 @@ using U01CanonicalImpl = U01CanonicalGenericImpl<UIntType, RealType, M>;
 
 #endif // MCKL_USE_AVX2
 
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+
+template <typename UIntType, typename RealType, typename Lower, typename Upper>
+using U01BatchImpl = U01DispatchImpl<UIntType, RealType, Lower, Upper,
+    U01Impl<UIntType, RealType, Lower, Upper>>;
+
+template <typename UIntType, typename RealType, int M>
+using U01CanonicalBatchImpl = U01CanonicalDispatchImpl<UIntType, RealType, M,
+    U01CanonicalImpl<UIntType, RealType, M>>;
+
+#else // MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+
+template <typename UIntType, typename RealType, typename Lower, typename Upper>
+using U01BatchImpl = U01Impl<UIntType, RealType, Lower, Upper>;
+
+template <typename UIntType, typename RealType, int M>
+using U01CanonicalBatchImpl = U01CanonicalImpl<UIntType, RealType, M>;
+
+#endif // MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+
 } // namespace internal
 
 /// \brief Convert uniform unsigned integers to floating points within [0, 1]
@@ -111,7 +135,7 @@ inline void u01(std::size_t n, const UIntType *u, RealType *r)
         "**u01** used with RealType other than floating point "
         "types");
 
-    internal::U01Impl<UIntType, RealType, Lower, Upper>::eval(n, u, r);
+    internal::U01BatchImpl<UIntType, RealType, Lower, Upper>::eval(n, u, r);
 }
 
 /// \brief Convert uniform unsigned integers to floating points on [0, 1]
@@ -209,7 +233,7 @@ inline void u01_canonical(std::size_t n, const UIntType *u, RealType *r)
         "**u01_canonical** used with RealType other than floating point "
         "types");
 
-    internal::U01CanonicalImpl<UIntType, RealType, M>::eval(n, u, r);
+    internal::U01CanonicalBatchImpl<UIntType, RealType, M>::eval(n, u, r);
 }
 
 } // namespace mckl
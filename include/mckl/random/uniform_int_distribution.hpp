@@ -33,81 +33,148 @@
 #define MCKL_RANDOM_UNIFORM_INT_DISTRIBUTION_HPP
 
 #include <mckl/random/internal/common.hpp>
-#include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/internal/philox_common.hpp>
+#include <mckl/random/internal/uniform_int_generic.hpp>
+#include <mckl/random/uniform_bits_distribution.hpp>
+
+#if MCKL_HAS_AVX2
+#include <mckl/random/internal/uniform_int_avx2.hpp>
+#endif
+
+#if MCKL_HAS_AVX512
+#include <mckl/random/internal/uniform_int_avx512.hpp>
+#endif
+
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+#include <mckl/random/internal/uniform_int_dispatch.hpp>
+#endif
 
 namespace mckl {
 
 namespace internal {
 
-template <typename IntType>
-inline bool uniform_int_distribution_use_double_big(
-    IntType a, IntType b, std::true_type)
-{
-    constexpr IntType imax = const_one<IntType>() << 32;
+#if MCKL_USE_AVX512
+using UniformIntImpl = UniformIntAVX512Impl;
+#elif MCKL_USE_AVX2
+using UniformIntImpl = UniformIntAVX2Impl;
+#else
+using UniformIntImpl = UniformIntGenericImpl;
+#endif
 
-    return a > -imax && b < imax;
-}
+#if MCKL_USE_RUNTIME_DISPATCH && !MCKL_USE_AVX512
+using UniformIntBatchImpl = UniformIntDispatchImpl<UniformIntImpl>;
+#else
+using UniformIntBatchImpl = UniformIntImpl;
+#endif
 
 template <typename IntType>
-inline bool uniform_int_distribution_use_double_big(
-    IntType, IntType b, std::false_type)
+inline bool uniform_int_distribution_check_param(IntType a, IntType b)
 {
-    constexpr IntType imax = const_one<IntType>() << 32;
-
-    return b < imax;
+    return a <= b;
 }
 
+// The number of integers in the range minus one, as an unsigned integer
 template <typename IntType>
-inline bool uniform_int_distribution_use_double(
-    IntType, IntType, std::true_type)
+inline std::uint64_t uniform_int_distribution_range(IntType a, IntType b)
 {
-    return true;
+    using UIntType = std::make_unsigned_t<IntType>;
+
+    return static_cast<std::uint64_t>(static_cast<UIntType>(
+        static_cast<UIntType>(b) - static_cast<UIntType>(a)));
 }
 
-template <typename IntType>
-inline bool uniform_int_distribution_use_double(
-    IntType a, IntType b, std::false_type)
+template <typename IntType, typename UIntType>
+inline IntType uniform_int_distribution_shift(IntType a, UIntType u)
 {
-    return uniform_int_distribution_use_double_big(
-        a, b, std::is_signed<IntType>());
+    using ResultUIntType = std::make_unsigned_t<IntType>;
+
+    return static_cast<IntType>(static_cast<ResultUIntType>(
+        static_cast<ResultUIntType>(a) + static_cast<ResultUIntType>(u)));
 }
 
-template <typename IntType>
-inline bool uniform_int_distribution_use_double(IntType a, IntType b)
+// Lemire's nearly divisionless multiply-shift rejection, a random integer in
+// [0, s) is the high half of the product of s and a random integer, unless
+// the low half is less than 2^W mod s. The threshold needs a division, but it
+// is only computed when the low half is less than s.
+template <typename RNGType>
+inline std::uint32_t uniform_int_distribution_lemire(
+    RNGType &rng, std::uint32_t s)
 {
-    return uniform_int_distribution_use_double(a, b,
-        std::integral_constant<bool,
-            std::numeric_limits<IntType>::digits <= 32>());
+    UniformBitsDistribution<std::uint32_t> ubits;
+    std::uint64_t m = static_cast<std::uint64_t>(ubits(rng)) * s;
+    if (static_cast<std::uint32_t>(m) < s) {
+        const std::uint32_t t = static_cast<std::uint32_t>(0 - s) % s;
+        while (static_cast<std::uint32_t>(m) < t) {
+            m = static_cast<std::uint64_t>(ubits(rng)) * s;
+        }
+    }
+
+    return static_cast<std::uint32_t>(m >> 32);
 }
 
-template <typename IntType>
-inline bool uniform_int_distribution_check_param(IntType a, IntType b)
+template <typename RNGType>
+inline std::uint64_t uniform_int_distribution_lemire(
+    RNGType &rng, std::uint64_t s)
 {
-    return a <= b;
+    UniformBitsDistribution<std::uint64_t> ubits;
+    std::uint64_t h = 0;
+    std::uint64_t l = PhiloxHiLo<std::uint64_t>::eval(ubits(rng), s, h);
+    if (l < s) {
+        const std::uint64_t t = (0 - s) % s;
+        while (l < t) {
+            l = PhiloxHiLo<std::uint64_t>::eval(ubits(rng), s, h);
+        }
+    }
+
+    return h;
 }
 
 template <std::size_t K, typename IntType, typename RNGType>
 inline void uniform_int_distribution_impl(RNGType &rng, std::size_t n,
-    IntType *r, IntType a, IntType b, std::true_type)
+    IntType *r, IntType a, std::uint32_t s, std::true_type)
 {
-    alignas(MCKL_ALIGNMENT) std::array<double, K> s;
-    double ra = static_cast<double>(a);
-    double rb = static_cast<double>(b);
-    double *const u = s.data();
-    u01_co_distribution(rng, n, u);
-    muladd(n, u, rb - ra + const_one<double>(), ra, u);
-    floor(n, u, u);
+    alignas(MCKL_ALIGNMENT) std::array<std::uint32_t, K> s0;
+    alignas(MCKL_ALIGNMENT) std::array<std::uint32_t, K> s1;
+    std::uint32_t *const u = s0.data();
+    std::uint32_t *const v = s1.data();
+    uniform_bits_distribution(rng, n, u);
+    if (s == 0) {
+        std::copy_n(u, n, v);
+    } else {
+        const std::uint32_t t = static_cast<std::uint32_t>(0 - s) % s;
+        if (UniformIntBatchImpl::eval(n, u, s, t, v)) {
+            for (std::size_t i = 0; i != n; ++i) {
+                const std::uint64_t m = static_cast<std::uint64_t>(u[i]) * s;
+                if (static_cast<std::uint32_t>(m) < t) {
+                    v[i] = uniform_int_distribution_lemire(rng, s);
+                }
+            }
+        }
+    }
     for (std::size_t i = 0; i != n; ++i) {
-        r[i] = static_cast<IntType>(u[i]);
+        r[i] = uniform_int_distribution_shift(a, v[i]);
     }
 }
 
-template <std::size_t, typename IntType, typename RNGType>
+template <std::size_t K, typename IntType, typename RNGType>
 inline void uniform_int_distribution_impl(RNGType &rng, std::size_t n,
-    IntType *r, IntType a, IntType b, std::false_type)
+    IntType *r, IntType a, std::uint64_t s, std::false_type)
 {
-    std::uniform_int_distribution<IntType> uniform(a, b);
-    rand(rng, uniform, n, r);
+    alignas(MCKL_ALIGNMENT) std::array<std::uint64_t, K> s0;
+    std::uint64_t *const u = s0.data();
+    uniform_bits_distribution(rng, n, u);
+    if (s != 0) {
+        const std::uint64_t t = (0 - s) % s;
+        for (std::size_t i = 0; i != n; ++i) {
+            std::uint64_t h = 0;
+            const std::uint64_t l =
+                PhiloxHiLo<std::uint64_t>::eval(u[i], s, h);
+            u[i] = l < t ? uniform_int_distribution_lemire(rng, s) : h;
+        }
+    }
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = uniform_int_distribution_shift(a, u[i]);
+    }
 }
 
 template <std::size_t K, typename IntType, typename RNGType>
@@ -119,9 +186,15 @@ inline void uniform_int_distribution_impl(
         return;
     }
 
-    uniform_int_distribution_use_double(a, b) ?
-        uniform_int_distribution_impl<K>(rng, n, r, a, b, std::true_type()) :
-        uniform_int_distribution_impl<K>(rng, n, r, a, b, std::false_type());
+    // A range of 2^32 or 2^64 integers is represented by zero
+    const std::uint64_t d = uniform_int_distribution_range(a, b);
+    if (d <= std::numeric_limits<std::uint32_t>::max()) {
+        uniform_int_distribution_impl<K>(rng, n, r, a,
+            static_cast<std::uint32_t>(d + 1), std::true_type());
+    } else {
+        uniform_int_distribution_impl<K>(
+            rng, n, r, a, d + 1, std::false_type());
+    }
 }
 
 } // namespace internal
@@ -131,6 +204,12 @@ MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
 
 /// \brief Uniform integer distribution
 /// \ingroup Distribution
+///
+/// \details
+/// The integers are generated without bias by the multiply-shift rejection
+/// method of Lemire, directly from uniform random bits. The batch generation
+/// of ranges of at most \f$2^{32}\f$ integers is vectorized with AVX2 or
+/// AVX-512 if enabled.
 template <typename IntType>
 class UniformIntDistribution
 {
@@ -151,51 +230,30 @@ class UniformIntDistribution
     template <typename RNGType>
     result_type generate(RNGType &rng, const param_type &param)
     {
-        using UIntType = std::make_unsigned_t<result_type>;
-
-        constexpr result_type imin = std::numeric_limits<result_type>::min();
-        constexpr result_type imax = std::numeric_limits<result_type>::max();
-
         if (param.a() == param.b()) {
             return param.a();
         }
 
-        if (param.a() == imin && param.b() == imax) {
-            UniformBitsDistribution<UIntType> ubits;
-            union {
-                UIntType u;
-                result_type r;
-            } buf;
-            buf.u = ubits(rng);
-
-            return buf.r;
+        const std::uint64_t d =
+            internal::uniform_int_distribution_range(param.a(), param.b());
+        if (d < std::numeric_limits<std::uint32_t>::max()) {
+            return internal::uniform_int_distribution_shift(param.a(),
+                internal::uniform_int_distribution_lemire(
+                    rng, static_cast<std::uint32_t>(d + 1)));
+        }
+        if (d == std::numeric_limits<std::uint32_t>::max()) {
+            UniformBitsDistribution<std::uint32_t> ubits;
+            return internal::uniform_int_distribution_shift(
+                param.a(), ubits(rng));
+        }
+        if (d == std::numeric_limits<std::uint64_t>::max()) {
+            UniformBitsDistribution<std::uint64_t> ubits;
+            return internal::uniform_int_distribution_shift(
+                param.a(), ubits(rng));
         }
 
-        return internal::uniform_int_distribution_use_double(
-                   param.a(), param.b()) ?
-            generate(rng, param, std::true_type()) :
-            generate(rng, param, std::false_type());
-    }
-
-    template <typename RNGType>
-    result_type generate(RNGType &rng, const param_type &param, std::true_type)
-    {
-        U01CODistribution<double> u01;
-        const double ra = static_cast<double>(param.a());
-        const double rb = static_cast<double>(param.b());
-        const double u = ra + (rb - ra + const_one<double>()) * u01(rng);
-
-        return static_cast<result_type>(std::floor(u));
-    }
-
-    template <typename RNGType>
-    result_type generate(
-        RNGType &rng, const param_type &param, std::false_type)
-    {
-        std::uniform_int_distribution<result_type> uniform(
-            param.a(), param.b());
-
-        return uniform(rng);
+        return internal::uniform_int_distribution_shift(param.a(),
+            internal::uniform_int_distribution_lemire(rng, d + 1));
     }
 }; // class UniformIntDistribution
 
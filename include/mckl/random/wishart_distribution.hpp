@@ -0,0 +1,539 @@
+//============================================================================
+// MCKL/include/mckl/random/wishart_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
+#define MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/chi_squared_distribution.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/normal_mv_distribution.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename RealType>
+inline bool wishart_distribution_check_param(std::size_t dim, RealType df)
+{
+    return dim > 0 && df > static_cast<RealType>(dim) - 1;
+}
+
+/// \brief Generate the transposes of the Bartlett factors
+///
+/// \details
+/// Each of the `n` matrices stored in `r`, row major, is upper triangular
+/// with standard Normal elements above the diagonal. The squared diagonal
+/// element in the `i`-th row is Chi-squared with `df - i` degrees of freedom,
+/// or with `df - dim + 1 + i` degrees of freedom if `reversed` is `true`.
+template <typename RealType, typename RNGType>
+inline void wishart_distribution_bartlett(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, bool reversed)
+{
+    const std::size_t dd = dim * dim;
+    const std::size_t nz = dim * (dim - 1) / 2;
+    Vector<RealType> s(n * std::max(nz, static_cast<std::size_t>(1)));
+
+    std::fill_n(r, n * dd, const_zero<RealType>());
+
+    normal_distribution(
+        rng, n * nz, s.data(), const_zero<RealType>(), const_one<RealType>());
+    const RealType *z = s.data();
+    RealType *g = r;
+    for (std::size_t k = 0; k != n; ++k, g += dd) {
+        for (std::size_t i = 0; i != dim; ++i) {
+            for (std::size_t j = i + 1; j != dim; ++j) {
+                g[i * dim + j] = *z++;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i != dim; ++i) {
+        const std::size_t d = reversed ? dim - 1 - i : i;
+        chi_squared_distribution(
+            rng, n, s.data(), df - static_cast<RealType>(d));
+        sqrt(n, s.data(), s.data());
+        g = r + i * dim + i;
+        for (std::size_t k = 0; k != n; ++k, g += dd) {
+            *g = s[k];
+        }
+    }
+}
+
+/// \brief Unpack the lower triangular Cholesky factor to a full matrix
+template <typename RealType>
+inline Vector<RealType> wishart_distribution_cholf(
+    std::size_t dim, const RealType *chol)
+{
+    Vector<RealType> cholf(dim * dim);
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            cholf[i * dim + j] = *chol++;
+        }
+    }
+
+    return cholf;
+}
+
+inline void wishart_distribution_syrk(
+    std::size_t dim, const float *g, float *c, float scale)
+{
+    cblas_ssyrk(CblasRowMajor, CblasLower, CblasTrans,
+        static_cast<MCKL_BLAS_INT>(dim), static_cast<MCKL_BLAS_INT>(dim),
+        scale, g, static_cast<MCKL_BLAS_INT>(dim), 0, c,
+        static_cast<MCKL_BLAS_INT>(dim));
+}
+
+inline void wishart_distribution_syrk(
+    std::size_t dim, const double *g, double *c, double scale)
+{
+    cblas_dsyrk(CblasRowMajor, CblasLower, CblasTrans,
+        static_cast<MCKL_BLAS_INT>(dim), static_cast<MCKL_BLAS_INT>(dim),
+        scale, g, static_cast<MCKL_BLAS_INT>(dim), 0, c,
+        static_cast<MCKL_BLAS_INT>(dim));
+}
+
+/// \brief Compute the packed lower triangular elements of \f$G^TG\f$ for
+/// each of the `n` matrices \f$G\f$ stored in `g`
+template <typename RealType>
+inline void wishart_distribution_crossprod(std::size_t n, RealType *r,
+    std::size_t dim, const RealType *g, RealType scale)
+{
+    const std::size_t dd = dim * dim;
+    Vector<RealType> c(dd);
+    for (std::size_t k = 0; k != n; ++k, g += dd) {
+        wishart_distribution_syrk(dim, g, c.data(), scale);
+        for (std::size_t i = 0; i != dim; ++i) {
+            r = std::copy_n(c.data() + i * dim, i + 1, r);
+        }
+    }
+}
+
+/// \brief Invert each of the `n` upper triangular matrices stored in `g` in
+/// place
+template <typename RealType>
+inline void wishart_distribution_invert(
+    std::size_t n, std::size_t dim, RealType *g)
+{
+    const std::size_t dd = dim * dim;
+    for (std::size_t k = 0; k != n; ++k, g += dd) {
+        for (std::size_t j = 0; j != dim; ++j) {
+            const RealType gjj = 1 / g[j * dim + j];
+            g[j * dim + j] = gjj;
+            for (std::size_t i = 0; i != j; ++i) {
+                RealType s = 0;
+                for (std::size_t l = i; l != j; ++l) {
+                    s += g[i * dim + l] * g[l * dim + j];
+                }
+                g[i * dim + j] = -gjj * s;
+            }
+        }
+    }
+}
+
+template <typename RealType, typename RNGType>
+inline void wishart_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, RealType chol,
+    const RealType *cholf, bool inverse)
+{
+    Vector<RealType> g(n * dim * dim);
+    wishart_distribution_bartlett(rng, n, g.data(), dim, df, inverse);
+    if (inverse) {
+        wishart_distribution_invert(n, dim, g.data());
+    }
+    if (cholf != nullptr) {
+        normal_mv_distribution_mulchol(n * dim, g.data(), dim, cholf);
+    }
+    wishart_distribution_crossprod(n, r, dim, g.data(), chol * chol);
+}
+
+} // namespace internal
+
+/// \brief Generating Wishart random matrices with scalar scale
+///
+/// \details
+/// The scale matrix is \f$c^2 I\f$ where \f$c\f$ is `chol`. Each of the `n`
+/// results is the lower triangular part of a `dim` by `dim` matrix packed row
+/// by row.
+template <typename RealType, typename RNGType>
+inline void wishart_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType df, RealType chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(dim, "wishart_distribution");
+
+    if (n * dim == 0) {
+        return;
+    }
+
+    internal::wishart_distribution_impl<RealType>(
+        rng, n, r, dim, df, chol, nullptr, false);
+}
+
+/// \brief Generating Wishart random matrices
+///
+/// \details
+/// The scale matrix is given by the lower triangular elements of its
+/// Cholesky decomposition, packed row by row. Each of the `n` results is the
+/// lower triangular part of a `dim` by `dim` matrix packed row by row.
+template <typename RealType, typename RNGType>
+inline void wishart_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType df, const RealType *chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(n * dim, "wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "wishart_distribution");
+
+    if (n * dim == 0) {
+        return;
+    }
+
+    Vector<RealType> cholf = internal::wishart_distribution_cholf(dim, chol);
+    internal::wishart_distribution_impl(rng, n, r, dim, df,
+        const_one<RealType>(), cholf.data(), false);
+}
+
+/// \brief Wishart distribution
+/// \ingroup Distribution
+///
+/// \details
+/// The distribution is parameterized by the degrees of freedom and the lower
+/// triangular elements of the Cholesky decomposition of the scale matrix,
+/// packed row by row. Random matrices are generated by the Bartlett
+/// decomposition and only their lower triangular elements are returned,
+/// packed row by row.
+template <typename RealType>
+class WishartDistribution
+{
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_BLAS_TYPE(Wishart)
+
+  public:
+    using result_type = RealType;
+    using distribution_type = WishartDistribution<RealType>;
+
+    MCKL_PUSH_CLANG_WARNING("-Wpadded")
+    class param_type
+    {
+      public:
+        using result_type = RealType;
+        using distribution_type = WishartDistribution<RealType>;
+
+        explicit param_type(std::size_t dim = 1)
+            : dim_(dim)
+            , df_(static_cast<result_type>(dim))
+            , chol_(dim * (dim + 1) / 2, 0)
+            , is_scalar_(true)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**WishartDistribution** constructed with invalid "
+                "arguments");
+            scalar_chol(1);
+        }
+
+        param_type(std::size_t dim, result_type df, result_type chol)
+            : dim_(dim)
+            , df_(df)
+            , chol_(dim * (dim + 1) / 2, 0)
+            , is_scalar_(true)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**WishartDistribution** constructed with invalid "
+                "arguments");
+            scalar_chol(chol);
+        }
+
+        param_type(std::size_t dim, result_type df, const result_type *chol)
+            : dim_(dim)
+            , df_(df)
+            , chol_(chol, chol + dim * (dim + 1) / 2)
+            , is_scalar_(false)
+        {
+            runtime_assert(
+                internal::wishart_distribution_check_param(dim_, df_),
+                "**WishartDistribution** constructed with invalid "
+                "arguments");
+        }
+
+        std::size_t dim() const { return dim_; }
+
+        result_type df() const { return df_; }
+
+        const result_type *chol() const { return chol_.data(); }
+
+        friend bool operator==(
+            const param_type &param1, const param_type &param2)
+        {
+            MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+            MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+            if (param1.dim_ != param2.dim_) {
+                return false;
+            }
+            if (param1.df_ != param2.df_) {
+                return false;
+            }
+            if (param1.chol_ != param2.chol_) {
+                return false;
+            }
+            if (param1.is_scalar_ != param2.is_scalar_) {
+                return false;
+            }
+            return true;
+            MCKL_POP_CLANG_WARNING
+            MCKL_POP_INTEL_WARNING
+        }
+
+        friend bool operator!=(
+            const param_type &param1, const param_type &param2)
+        {
+            return !(param1 == param2);
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_ostream<CharT, Traits> &operator<<(
+            std::basic_ostream<CharT, Traits> &os, const param_type &param)
+        {
+            if (!os) {
+                return os;
+            }
+
+            os << param.dim_ << ' ';
+            os << param.df_ << ' ';
+            os << param.chol_ << ' ';
+            os << param.is_scalar_;
+
+            return os;
+        }
+
+        template <typename CharT, typename Traits>
+        friend std::basic_istream<CharT, Traits> &operator>>(
+            std::basic_istream<CharT, Traits> &is, param_type &param)
+        {
+            if (!is) {
+                return is;
+            }
+
+            param_type tmp;
+            is >> std::ws >> tmp.dim_;
+            is >> std::ws >> tmp.df_;
+            is >> std::ws >> tmp.chol_;
+            is >> std::ws >> tmp.is_scalar_;
+
+            if (is) {
+                param = std::move(tmp);
+            } else {
+                is.setstate(std::ios_base::failbit);
+            }
+
+            return is;
+        }
+
+      private:
+        std::size_t dim_;
+        result_type df_;
+        Vector<result_type> chol_;
+        bool is_scalar_;
+
+        friend distribution_type;
+
+        void scalar_chol(result_type chol)
+        {
+            for (std::size_t i = 0; i != dim_; ++i) {
+                chol_[(i + 1) * (i + 2) / 2 - 1] = chol;
+            }
+        }
+    }; // class param_type
+    MCKL_POP_CLANG_WARNING
+
+    /// \brief Construct a distribution with identity scale matrix
+    explicit WishartDistribution(std::size_t dim = 1) : param_(dim)
+    {
+        reset();
+    }
+
+    /// \brief Construct a distribution with scalar scale matrix
+    WishartDistribution(std::size_t dim, result_type df, result_type chol = 1)
+        : param_(dim, df, chol)
+    {
+        reset();
+    }
+
+    /// \brief Construct a distribution with general scale matrix
+    WishartDistribution(
+        std::size_t dim, result_type df, const result_type *chol)
+        : param_(dim, df, chol)
+    {
+        reset();
+    }
+
+    explicit WishartDistribution(const param_type &param) : param_(param)
+    {
+        reset();
+    }
+
+    explicit WishartDistribution(param_type &&param)
+        : param_(std::move(param))
+    {
+        reset();
+    }
+
+    template <typename OutputIter>
+    OutputIter min(OutputIter first) const
+    {
+        return std::fill_n(first, dim() * (dim() + 1) / 2,
+            std::numeric_limits<result_type>::lowest());
+    }
+
+    template <typename OutputIter>
+    OutputIter max(OutputIter first) const
+    {
+        return std::fill_n(first, dim() * (dim() + 1) / 2,
+            std::numeric_limits<result_type>::max());
+    }
+
+    void reset() {}
+
+    std::size_t dim() const { return param_.dim(); }
+
+    result_type df() const { return param_.df(); }
+
+    const result_type *chol() const { return param_.chol(); }
+
+    const param_type &param() const { return param_; }
+
+    void param(const param_type &param)
+    {
+        param_ = param;
+        reset();
+    }
+
+    void param(param_type &&param)
+    {
+        param_ = std::move(param);
+        reset();
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r)
+    {
+        operator()(rng, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, result_type *r, const param_type &param)
+    {
+        operator()(rng, 1, r, param);
+    }
+
+    template <typename RNGType>
+    void operator()(RNGType &rng, std::size_t n, result_type *r)
+    {
+        operator()(rng, n, r, param_);
+    }
+
+    template <typename RNGType>
+    void operator()(
+        RNGType &rng, std::size_t n, result_type *r, const param_type &param)
+    {
+        if (param.is_scalar_) {
+            wishart_distribution(
+                rng, n, r, param.dim(), param.df(), param.chol()[0]);
+        } else {
+            wishart_distribution(
+                rng, n, r, param.dim(), param.df(), param.chol());
+        }
+    }
+
+    friend bool operator==(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        if (dist1.param_ != dist2.param_) {
+            return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(
+        const distribution_type &dist1, const distribution_type &dist2)
+    {
+        return !(dist1 == dist2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const distribution_type &dist)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << dist.param_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, distribution_type &dist)
+    {
+        if (!is) {
+            return is;
+        }
+
+        param_type param;
+        is >> std::ws >> param;
+        if (is) {
+            dist.param_ = std::move(param);
+        }
+
+        return is;
+    }
+
+  private:
+    param_type param_;
+}; // class WishartDistribution
+
+template <typename RealType, typename RNGType>
+inline void rand(
+    RNGType &rng, WishartDistribution<RealType> &distribution, RealType *r)
+{
+    distribution(rng, r);
+}
+
+template <typename RealType, typename RNGType>
+inline void rand(RNGType &rng, WishartDistribution<RealType> &distribution,
+    std::size_t n, RealType *r)
+{
+    distribution(rng, n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
@@ -33,7 +33,15 @@
 #define MCKL_SMP_BACKEND_BASE_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/core/matrix.hpp>
 #include <mckl/core/particle.hpp>
+#include <atomic>
+
+#if MCKL_HAS_THREAD_AFFINITY
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 MCKL_PUSH_CLANG_WARNING("-Wweak-vtables")
 
@@ -49,6 +57,13 @@ MCKL_PUSH_CLANG_WARNING("-Wweak-vtables")
 #endif
 #endif
 
+/// \brief Default block size of the deterministic mode of the SMP backends,
+/// zero if the mode is disabled
+/// \ingroup Config
+#ifndef MCKL_SMP_DETERMINISTIC_BLOCK
+#define MCKL_SMP_DETERMINISTIC_BLOCK 0
+#endif
+
 #define MCKL_DEFINE_SMP_BACKEND_BASE_SPECIAL(Name)                            \
     Name##Base() = default;                                                   \
     Name##Base(const Name##Base<T, Derived> &) = default;                     \
@@ -97,6 +112,244 @@ class BackendTBB;
 /// \ingroup SMP
 using BackendSMP = MCKL_SMP_BACKEND;
 
+/// \brief Function object that calls `work(ibegin, iend)` on sub-ranges of
+/// \f$[0, n)\f$ in parallel
+/// \ingroup SMP
+///
+/// \details
+/// It can be passed as the `run` argument of the member functions of Weight
+/// that normalize in parallel, for example,
+/// ~~~{.cpp}
+/// particle.weight().add_log(w, RunSMP<BackendSTD>());
+/// ~~~
+template <typename = BackendSMP>
+class RunSMP;
+
+namespace internal {
+
+inline std::atomic<std::size_t> &backend_deterministic_block()
+{
+    static std::atomic<std::size_t> block(MCKL_SMP_DETERMINISTIC_BLOCK);
+
+    return block;
+}
+
+} // namespace internal
+
+/// \brief The block size of the deterministic mode of the SMP backends, zero
+/// if the mode is disabled
+/// \ingroup SMP
+inline std::size_t smp_deterministic_block()
+{
+    return internal::backend_deterministic_block().load();
+}
+
+/// \brief Enable the deterministic mode of the SMP backends with a given
+/// block size, or disable it if the size is zero
+/// \ingroup SMP
+///
+/// \details
+/// In the deterministic mode, `SMCSamplerEvalSMP` and `SMCEstimatorEvalSMP`
+/// of all backends split the particle system into consecutive blocks of the
+/// given size, regardless of the number of threads and the grain size, and
+/// call `eval_range` once for each block. The blocks may be processed by any
+/// thread in any order. If the RNG set of the particle system has one stream
+/// for each particle, such as `RNGSetVector` and `RNGSetCounter`, and
+/// `eval_range` only uses the RNG of the particles within the range, such as
+/// `range.begin().rng()`, then the results depend only on the seed, the
+/// iteration and the block size, and are identical on any number of
+/// processors. Each block can still generate its random numbers in batches.
+/// Thread-local RNG sets such as `RNGSetTBB` do not have this property, and a
+/// runtime assertion fails if the RNG set is smaller than the particle
+/// system.
+inline void smp_deterministic_block(std::size_t block)
+{
+    internal::backend_deterministic_block().store(block);
+}
+
+namespace internal {
+
+#if MCKL_HAS_THREAD_AFFINITY
+
+inline const Vector<int> &backend_affinity_cpus()
+{
+    static const Vector<int> cpus = []() {
+        Vector<int> v;
+        ::cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int i = 0; i != CPU_SETSIZE; ++i) {
+                if (CPU_ISSET(i, &set)) {
+                    v.push_back(i);
+                }
+            }
+        }
+        return v;
+    }();
+
+    return cpus;
+}
+
+/// \brief Pin the calling thread to the `id`-th processor available to the
+/// process, or to all of them if `id` is negative
+inline bool backend_pin_thread(int id)
+{
+    const Vector<int> &cpus = backend_affinity_cpus();
+    if (cpus.empty()) {
+        return false;
+    }
+
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    if (id < 0) {
+        for (int c : cpus) {
+            CPU_SET(c, &set);
+        }
+    } else {
+        CPU_SET(cpus[static_cast<std::size_t>(id) % cpus.size()], &set);
+    }
+
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+/// \brief Save the affinity mask of the calling thread if `enable` is true,
+/// and restore it on destruction
+class BackendAffinityGuard
+{
+  public:
+    explicit BackendAffinityGuard(bool enable)
+        : saved_(enable &&
+              ::pthread_getaffinity_np(
+                  ::pthread_self(), sizeof(set_), &set_) == 0)
+    {
+    }
+
+    BackendAffinityGuard(const BackendAffinityGuard &) = delete;
+    BackendAffinityGuard &operator=(const BackendAffinityGuard &) = delete;
+
+    ~BackendAffinityGuard()
+    {
+        if (saved_) {
+            ::pthread_setaffinity_np(::pthread_self(), sizeof(set_), &set_);
+        }
+    }
+
+  private:
+    ::cpu_set_t set_;
+    bool saved_;
+}; // class BackendAffinityGuard
+
+#else // MCKL_HAS_THREAD_AFFINITY
+
+inline bool backend_pin_thread(int) { return false; }
+
+class BackendAffinityGuard
+{
+  public:
+    explicit BackendAffinityGuard(bool) {}
+
+    BackendAffinityGuard(const BackendAffinityGuard &) = delete;
+    BackendAffinityGuard &operator=(const BackendAffinityGuard &) = delete;
+}; // class BackendAffinityGuard
+
+#endif // MCKL_HAS_THREAD_AFFINITY
+
+template <typename T, MatrixLayout Layout>
+std::true_type backend_is_matrix(const Matrix<T, Layout> *);
+
+std::false_type backend_is_matrix(...);
+
+template <typename T>
+using BackendIsMatrix =
+    decltype(backend_is_matrix(static_cast<const T *>(nullptr)));
+
+template <typename T, MatrixLayout Layout, typename Run>
+inline void backend_first_touch_dispatch(
+    Matrix<T, Layout> &state, Run &&run, std::true_type)
+{
+    using size_type = typename Matrix<T, Layout>::size_type;
+
+    const size_type nrow = state.nrow();
+    const size_type ncol = state.ncol();
+    Matrix<T, Layout> tmp(nrow, ncol);
+    run(static_cast<std::size_t>(nrow), [&](std::size_t ibegin,
+                                            std::size_t iend) {
+        const size_type b = static_cast<size_type>(ibegin);
+        const size_type e = static_cast<size_type>(iend);
+        if (Layout == RowMajor) {
+            std::copy(state.row_data(b), state.row_data(b) + (e - b) * ncol,
+                tmp.row_data(b));
+        } else {
+            for (size_type j = 0; j != ncol; ++j) {
+                std::copy(state.col_data(j) + b, state.col_data(j) + e,
+                    tmp.col_data(j) + b);
+            }
+        }
+    });
+    state = std::move(tmp);
+}
+
+template <typename S, typename Run>
+inline void backend_first_touch_dispatch(S &, Run &&, std::false_type)
+{
+}
+
+template <typename W, typename Run>
+inline void backend_first_touch_weight(W &, Run &&)
+{
+}
+
+template <typename Run>
+inline void backend_first_touch_weight(Weight &weight, Run &&run)
+{
+    weight.reallocate([&](std::size_t n, const double *src, double *dst) {
+        run(n, [=](std::size_t ibegin, std::size_t iend) {
+            std::copy(src + ibegin, src + iend, dst + ibegin);
+        });
+    });
+}
+
+/// \brief Call `work(ibegin, iend)` on fixed blocks in parallel if the
+/// deterministic mode is enabled, return `false` otherwise
+template <typename Backend, typename T, typename Work>
+inline bool backend_deterministic_run(Particle<T> &particle, Work &&work)
+{
+    const std::size_t block = smp_deterministic_block();
+    if (block == 0) {
+        return false;
+    }
+
+    const std::size_t N = static_cast<std::size_t>(particle.size());
+    runtime_assert(
+        static_cast<std::size_t>(particle.rng_set().size()) >= N,
+        "**SMP** deterministic mode used with an RNG set without one "
+        "stream per particle");
+
+    RunSMP<Backend>()((N + block - 1) / block,
+        [&work, block, N](std::size_t bbegin, std::size_t bend) {
+            for (std::size_t b = bbegin; b != bend; ++b) {
+                work(b * block, std::min(N, (b + 1) * block));
+            }
+        });
+
+    return true;
+}
+
+/// \brief Move the state and the weights of a particle system to newly
+/// allocated memory, copied in parallel by `run(N, work)`
+///
+/// \details
+/// The state is moved if it is derived from Matrix, and the weights are moved
+/// if they are of type Weight. Other types are left untouched.
+template <typename T, typename Run>
+inline void backend_first_touch(Particle<T> &particle, Run &&run)
+{
+    backend_first_touch_dispatch(particle.state(), run, BackendIsMatrix<T>());
+    backend_first_touch_weight(particle.weight(), run);
+}
+
+} // namespace internal
+
 /// \brief SMCSMCSampler<T>::eval_type
 /// \ingroup SMP
 template <typename T, typename = Virtual, typename = BackendSMP>
@@ -107,6 +360,11 @@ class SMCSamplerEvalSMP;
 template <typename T, typename = Virtual, typename = BackendSMP>
 class SMCEstimatorEvalSMP;
 
+/// \brief SMCSampler<T>::eval_type subtype for parallel resampling
+/// \ingroup SMP
+template <typename T, typename = BackendSMP>
+class ResampleEvalSMP;
+
 /// \brief SMCSampler evaluation base dispatch class
 /// \ingroup SMP
 template <typename T, typename Derived>
@@ -453,6 +711,356 @@ class SMCEstimatorEvalBase<T, Virtual>
     virtual void eval_last(std::size_t, Particle<T> &) {}
 }; // class SMCEstimatorEvalBase<T, Virtual>
 
+namespace internal {
+
+template <typename S>
+auto resample_smp_has_duplicate(S *s)
+    -> decltype(s->duplicate(0, 0), std::true_type());
+
+std::false_type resample_smp_has_duplicate(...);
+
+template <typename S>
+using ResampleSMPHasDuplicate =
+    decltype(resample_smp_has_duplicate(static_cast<S *>(nullptr)));
+
+} // namespace internal
+
+/// \brief Parallel resampling base class
+/// \ingroup SMP
+///
+/// \details
+/// The particle system is partitioned into blocks of `grainsize()` particles.
+/// The cumulative weights, the sorted uniform random numbers, the
+/// replication numbers, the parent indices and the new states are each
+/// computed block by block in parallel, with sequential scans over the
+/// per-block partial results in between. The uniform random numbers of the
+/// \f$i\f$-th block are generated by `particle.rng(i * grainsize())`. The
+/// partition depends only on the sample size. Thus the results do not depend
+/// on the number of threads, as long as the RNG set of the particle system
+/// has one RNG per particle.
+///
+/// The `Derived` class shall have a static member function `run(n, work)`,
+/// which calls `work(ibegin, iend)` on sub-ranges of \f$[0, n)\f$ in
+/// parallel.
+///
+/// If the state type has a member function `duplicate(src, dst)`, such as
+/// StateMatrix, the samples are copied in parallel. Otherwise
+/// `Particle::select` is called.
+template <typename T, typename Derived>
+class ResampleEvalSMPBase
+{
+  public:
+    using size_type = typename Particle<T>::size_type;
+
+    explicit ResampleEvalSMPBase(
+        ResampleScheme scheme = Stratified, std::size_t grainsize = 4096)
+        : scheme_(scheme), grainsize_(grainsize)
+    {
+        runtime_assert(grainsize_ != 0,
+            "**ResampleEvalSMP** constructed with zero grain size");
+    }
+
+    /// \brief The resampling scheme
+    ResampleScheme scheme() const { return scheme_; }
+
+    /// \brief The number of particles in each block
+    std::size_t grainsize() const { return grainsize_; }
+
+    /// \brief Resample a particle collection
+    void operator()(std::size_t, Particle<T> &particle)
+    {
+        const std::size_t N = static_cast<std::size_t>(particle.size());
+        if (N == 0) {
+            return;
+        }
+
+        const std::size_t C = (N + grainsize_ - 1) / grainsize_;
+        cw_.resize(N);
+        rep_.resize(N);
+        idx_.resize(N);
+        csum_.resize(C + 1);
+        hoff_.resize(C + 1);
+        soff_.resize(C + 1);
+
+        const std::size_t R = cumulative_weight(N, C, particle);
+        uniform(R, particle);
+        replication(N, C, R);
+        index(N, C);
+        select(N, C, particle,
+            internal::ResampleSMPHasDuplicate<
+                typename Particle<T>::state_type>());
+    }
+
+  private:
+    ResampleScheme scheme_;
+    std::size_t grainsize_;
+    Vector<double> cw_;
+    Vector<double> u01_;
+    Vector<size_type> rep_;
+    Vector<size_type> idx_;
+    Vector<double> csum_;
+    Vector<std::size_t> hoff_;
+    Vector<std::size_t> soff_;
+
+    bool residual() const
+    {
+        return scheme_ == Residual || scheme_ == ResidualStratified ||
+            scheme_ == ResidualSystematic;
+    }
+
+    std::size_t surplus(std::size_t i) const
+    {
+        return rep_[i] > 0 ? static_cast<std::size_t>(rep_[i]) - 1 : 0;
+    }
+
+    template <typename Work>
+    void run(std::size_t n, Work &&work)
+    {
+        Derived::run(n, [this, &work](std::size_t cbegin, std::size_t cend) {
+            for (std::size_t c = cbegin; c != cend; ++c) {
+                work(c);
+            }
+        });
+    }
+
+    // Set cw_ to the cumulative (residual) weights and rep_ to the integral
+    // parts of the replication numbers, return the number of remaining
+    // samples to be drawn
+    std::size_t cumulative_weight(
+        std::size_t N, std::size_t C, Particle<T> &particle)
+    {
+        const double *w = particle.weight().data();
+        const bool resid = residual();
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            double sum = 0;
+            std::size_t integ = 0;
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                double v = w[i];
+                if (resid) {
+                    const double nw = static_cast<double>(N) * w[i];
+                    const double r = std::floor(nw);
+                    rep_[i] = static_cast<size_type>(r);
+                    integ += static_cast<std::size_t>(r);
+                    v = nw - r;
+                } else {
+                    rep_[i] = 0;
+                }
+                sum += v;
+                cw_[i] = sum;
+            }
+            csum_[c] = sum;
+            hoff_[c] = integ;
+        });
+
+        double total = 0;
+        std::size_t integ = 0;
+        for (std::size_t c = 0; c != C; ++c) {
+            const double sum = csum_[c];
+            csum_[c] = total;
+            total += sum;
+            integ += hoff_[c];
+        }
+        const double scale = total > 0 ? 1 / total : 0;
+
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            const double offset = csum_[c];
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                cw_[i] = (cw_[i] + offset) * scale;
+            }
+        });
+
+        return integ < N ? N - integ : 0;
+    }
+
+    // Set u01_ to R sorted standard uniform random numbers
+    void uniform(std::size_t R, Particle<T> &particle)
+    {
+        u01_.resize(R);
+        if (R == 0) {
+            return;
+        }
+
+        const std::size_t C = (R + grainsize_ - 1) / grainsize_;
+        const double delta = 1.0 / static_cast<double>(R);
+        switch (scheme_) {
+            case Multinomial:
+            case Residual: {
+                // Order statistics from normalized exponential spacings
+                run(C, [&](std::size_t c) {
+                    const std::size_t jbegin = c * grainsize_;
+                    const std::size_t n = std::min(R, jbegin + grainsize_) -
+                        jbegin;
+                    double *const u = u01_.data() + jbegin;
+                    u01_oc_distribution(particle.rng(static_cast<size_type>(
+                                            jbegin)),
+                        n, u);
+                    log(n, u, u);
+                    double sum = 0;
+                    for (std::size_t j = 0; j != n; ++j) {
+                        sum -= u[j];
+                        u[j] = sum;
+                    }
+                    csum_[c] = sum;
+                });
+                double total = 0;
+                for (std::size_t c = 0; c != C; ++c) {
+                    const double sum = csum_[c];
+                    csum_[c] = total;
+                    total += sum;
+                }
+                U01OCDistribution<double> ru01;
+                total -= std::log(ru01(particle.rng()));
+                run(C, [&](std::size_t c) {
+                    const std::size_t jbegin = c * grainsize_;
+                    const std::size_t jend = std::min(R, jbegin + grainsize_);
+                    const double offset = csum_[c];
+                    for (std::size_t j = jbegin; j != jend; ++j) {
+                        u01_[j] = (u01_[j] + offset) / total;
+                    }
+                });
+            } break;
+            case Stratified:
+            case ResidualStratified:
+                run(C, [&](std::size_t c) {
+                    const std::size_t jbegin = c * grainsize_;
+                    const std::size_t n = std::min(R, jbegin + grainsize_) -
+                        jbegin;
+                    double *const u = u01_.data() + jbegin;
+                    u01_co_distribution(particle.rng(static_cast<size_type>(
+                                            jbegin)),
+                        n, u);
+                    for (std::size_t j = 0; j != n; ++j) {
+                        u[j] = (static_cast<double>(jbegin + j) + u[j]) *
+                            delta;
+                    }
+                });
+                break;
+            case Systematic:
+            case ResidualSystematic: {
+                U01CODistribution<double> ru01;
+                const double u0 = ru01(particle.rng());
+                run(C, [&](std::size_t c) {
+                    const std::size_t jbegin = c * grainsize_;
+                    const std::size_t jend = std::min(R, jbegin + grainsize_);
+                    for (std::size_t j = jbegin; j != jend; ++j) {
+                        u01_[j] = (static_cast<double>(j) + u0) * delta;
+                    }
+                });
+            } break;
+        }
+    }
+
+    // Add to rep_ the number of uniform random numbers falling into each
+    // interval of the cumulative weights
+    void replication(std::size_t N, std::size_t C, std::size_t R)
+    {
+        const double *const ubegin = u01_.data();
+        const double *const uend = ubegin + R;
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            const double *u = ibegin == 0 ?
+                ubegin :
+                std::lower_bound(ubegin, uend, cw_[ibegin - 1]);
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                const double *v = i + 1 == N ? uend :
+                                               std::lower_bound(
+                                                   u, uend, cw_[i]);
+                rep_[i] += static_cast<size_type>(v - u);
+                u = v;
+            }
+        });
+    }
+
+    // Set idx_ to parent indices such that idx_[i] == i if rep_[i] > 0, and
+    // the remaining copies fill the particles with rep_[i] == 0 in order
+    void index(std::size_t N, std::size_t C)
+    {
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            std::size_t h = 0;
+            std::size_t s = 0;
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                h += rep_[i] == 0 ? 1 : 0;
+                s += surplus(i);
+            }
+            hoff_[c] = h;
+            soff_[c] = s;
+        });
+
+        std::size_t h = 0;
+        std::size_t s = 0;
+        for (std::size_t c = 0; c != C; ++c) {
+            const std::size_t hc = hoff_[c];
+            const std::size_t sc = soff_[c];
+            hoff_[c] = h;
+            soff_[c] = s;
+            h += hc;
+            s += sc;
+        }
+        hoff_[C] = h;
+        soff_[C] = s;
+
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            if (hoff_[c] == hoff_[c + 1]) {
+                for (std::size_t i = ibegin; i != iend; ++i) {
+                    idx_[i] = static_cast<size_type>(i);
+                }
+                return;
+            }
+
+            // The first source block that has the hoff_[c]-th surplus copy
+            const std::size_t b = static_cast<std::size_t>(
+                std::upper_bound(soff_.begin(), soff_.begin() + C, hoff_[c]) -
+                soff_.begin() - 1);
+            std::size_t src = b * grainsize_;
+            std::size_t t = hoff_[c] - soff_[b];
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                if (rep_[i] > 0) {
+                    idx_[i] = static_cast<size_type>(i);
+                    continue;
+                }
+                while (surplus(src) <= t) {
+                    t -= surplus(src);
+                    ++src;
+                }
+                idx_[i] = static_cast<size_type>(src);
+                ++t;
+            }
+        });
+    }
+
+    void select(std::size_t N, std::size_t C, Particle<T> &particle,
+        std::true_type)
+    {
+        auto &state = particle.state();
+        run(C, [&](std::size_t c) {
+            const std::size_t ibegin = c * grainsize_;
+            const std::size_t iend = std::min(N, ibegin + grainsize_);
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                const size_type dst = static_cast<size_type>(i);
+                if (idx_[i] != dst) {
+                    state.duplicate(idx_[i], dst);
+                }
+            }
+        });
+        particle.weight().set_equal();
+    }
+
+    void select(std::size_t, std::size_t, Particle<T> &particle,
+        std::false_type)
+    {
+        particle.select(particle.size(), idx_.data());
+    }
+}; // class ResampleEvalSMPBase
+
 } // namespace mckl
 
 MCKL_POP_CLANG_WARNING
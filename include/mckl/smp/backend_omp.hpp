@@ -40,8 +40,94 @@
 
 namespace mckl {
 
+/// \brief SMP implementation ID for OpenMP
+/// \ingroup OMP
+///
+/// \details
+/// The particle system is partitioned statically, such that the \f$i\f$-th
+/// thread of the team always processes the \f$i\f$-th block. If `affinity()`
+/// is enabled, the \f$i\f$-th thread is also pinned to the \f$i\f$-th
+/// processor available to the process. Use `first_touch` to place the memory
+/// of the particle system accordingly.
+class BackendOMP
+{
+  public:
+    BackendOMP(const BackendOMP &) = delete;
+    BackendOMP &operator=(const BackendOMP &) = delete;
+
+    static BackendOMP &instance()
+    {
+        static BackendOMP backend;
+
+        return backend;
+    }
+
+    /// \brief If threads are pinned to processors
+    bool affinity() const { return affinity_; }
+
+    /// \brief Enable or disable pinning threads to processors
+    ///
+    /// \details
+    /// Has no effect unless `MCKL_HAS_THREAD_AFFINITY` is non-zero.
+    void affinity(bool enable) { affinity_ = enable; }
+
+    /// \brief Move the state and weights of a particle system to newly
+    /// allocated memory, such that each block is first touched by the thread
+    /// that processes it
+    template <typename T>
+    void first_touch(Particle<T> &particle);
+
+  private:
+    bool affinity_;
+
+    BackendOMP() : affinity_(false) {}
+}; // class BackendOMP
+
 namespace internal {
 
+/// \brief Pin the calling thread of a parallel region when affinity is
+/// enabled
+///
+/// \details
+/// The master thread is the thread that entered the region. It is pinned only
+/// for the duration of the region, and its original affinity is restored on
+/// destruction. The other threads belong to the OpenMP runtime and stay
+/// pinned between regions.
+class BackendOMPPin
+{
+  public:
+    BackendOMPPin()
+        : guard_(BackendOMP::instance().affinity() && thread_num() == 0)
+    {
+#if MCKL_HAS_OMP
+        static thread_local int pinned = -1;
+        const int id =
+            BackendOMP::instance().affinity() ? ::omp_get_thread_num() : -1;
+        if (id == 0) {
+            backend_pin_thread(0);
+        } else if (id != pinned) {
+            backend_pin_thread(id);
+            pinned = id;
+        }
+#endif
+    }
+
+    BackendOMPPin(const BackendOMPPin &) = delete;
+    BackendOMPPin &operator=(const BackendOMPPin &) = delete;
+
+  private:
+    BackendAffinityGuard guard_;
+
+    static int thread_num()
+    {
+#if MCKL_HAS_OMP
+        return ::omp_get_thread_num();
+#else
+        return -1;
+#endif
+    }
+}; // class BackendOMPPin
+
 template <typename IntType>
 inline void backend_omp_range(IntType N, IntType &ibegin, IntType &iend)
 {
@@ -61,6 +147,49 @@ inline void backend_omp_range(IntType N, IntType &ibegin, IntType &iend)
 
 } // namespace internal
 
+template <typename T>
+inline void BackendOMP::first_touch(Particle<T> &particle)
+{
+    internal::backend_first_touch(particle, [](std::size_t N, auto &&work) {
+        auto *wptr = &work;
+#if MCKL_HAS_OMP
+#pragma omp parallel default(none) firstprivate(wptr, N)
+#endif
+        {
+            std::size_t ibegin = 0;
+            std::size_t iend = 0;
+            internal::BackendOMPPin pin;
+            internal::backend_omp_range(N, ibegin, iend);
+            (*wptr)(ibegin, iend);
+        }
+    });
+}
+
+/// \brief Parallel loop using OpenMP
+/// \ingroup OMP
+template <>
+class RunSMP<BackendOMP>
+{
+  public:
+    template <typename Work>
+    void operator()(std::size_t n, Work &&work) const
+    {
+        auto *wptr = &work;
+#if MCKL_HAS_OMP
+#pragma omp parallel default(none) firstprivate(wptr, n)
+#endif
+        {
+            std::size_t ibegin = 0;
+            std::size_t iend = 0;
+            internal::BackendOMPPin pin;
+            internal::backend_omp_range(n, ibegin, iend);
+            if (ibegin != iend) {
+                (*wptr)(ibegin, iend);
+            }
+        }
+    }
+}; // class RunSMP
+
 /// \brief SMCSampler<T>::eval_type subtype using OpenMP
 /// \ingroup OMP
 template <typename T, typename Derived>
@@ -87,6 +216,16 @@ class SMCSamplerEvalSMP<T, Derived, BackendOMP>
         using size_type = typename Particle<T>::size_type;
 
         this->eval_first(iter, particle);
+        if (internal::backend_deterministic_run<BackendOMP>(particle,
+                [this, iter, &particle](std::size_t ibegin, std::size_t iend) {
+                    this->eval_range(iter,
+                        particle.range(static_cast<size_type>(ibegin),
+                            static_cast<size_type>(iend)));
+                })) {
+            this->eval_last(iter, particle);
+            return;
+        }
+
         Particle<T> *pptr = &particle;
 #if MCKL_HAS_OMP
 #pragma omp parallel default(none) firstprivate(pptr, iter)
@@ -94,6 +233,7 @@ class SMCSamplerEvalSMP<T, Derived, BackendOMP>
         {
             size_type ibegin = 0;
             size_type iend = 0;
+            internal::BackendOMPPin pin;
             internal::backend_omp_range(pptr->size(), ibegin, iend);
             this->eval_range(iter, pptr->range(ibegin, iend));
         }
@@ -130,6 +270,18 @@ class SMCEstimatorEvalSMP<T, Derived, BackendOMP>
         using size_type = typename Particle<T>::size_type;
 
         this->eval_first(iter, particle);
+        if (internal::backend_deterministic_run<BackendOMP>(particle,
+                [this, iter, dim, &particle, r](
+                    std::size_t ibegin, std::size_t iend) {
+                    this->eval_range(iter, dim,
+                        particle.range(static_cast<size_type>(ibegin),
+                            static_cast<size_type>(iend)),
+                        r + ibegin * dim);
+                })) {
+            this->eval_last(iter, particle);
+            return;
+        }
+
         Particle<T> *pptr = &particle;
 #if MCKL_HAS_OMP
 #pragma omp parallel default(none) firstprivate(pptr, iter, dim, r)
@@ -137,6 +289,7 @@ class SMCEstimatorEvalSMP<T, Derived, BackendOMP>
         {
             size_type ibegin = 0;
             size_type iend = 0;
+            internal::BackendOMPPin pin;
             internal::backend_omp_range(pptr->size(), ibegin, iend);
             this->eval_range(iter, dim, pptr->range(ibegin, iend),
                 r + static_cast<std::size_t>(ibegin) * dim);
@@ -145,6 +298,23 @@ class SMCEstimatorEvalSMP<T, Derived, BackendOMP>
     }
 }; // class SMCEstimatorEvalSMP
 
+/// \brief Parallel resampling using OpenMP
+/// \ingroup OMP
+template <typename T>
+class ResampleEvalSMP<T, BackendOMP>
+    : public ResampleEvalSMPBase<T, ResampleEvalSMP<T, BackendOMP>>
+{
+  public:
+    using ResampleEvalSMPBase<T,
+        ResampleEvalSMP<T, BackendOMP>>::ResampleEvalSMPBase;
+
+    template <typename Work>
+    static void run(std::size_t n, Work &&work)
+    {
+        RunSMP<BackendOMP>()(n, std::forward<Work>(work));
+    }
+}; // class ResampleEvalSMP
+
 /// \brief SMCSampler<T>::eval_type subtype using OpenMP
 /// \ingroup OMP
 template <typename T, typename Derived>
@@ -155,6 +325,11 @@ using SMCSamplerEvalOMP = SMCSamplerEvalSMP<T, Derived, BackendOMP>;
 template <typename T, typename Derived>
 using SMCEstimatorEvalOMP = SMCEstimatorEvalSMP<T, Derived, BackendOMP>;
 
+/// \brief Parallel resampling using OpenMP
+/// \ingroup OMP
+template <typename T>
+using ResampleEvalOMP = ResampleEvalSMP<T, BackendOMP>;
+
 } // namespace mckl
 
 #endif // MCKL_SMP_BACKEND_OMP_HPP
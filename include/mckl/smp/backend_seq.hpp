@@ -36,6 +36,19 @@
 
 namespace mckl {
 
+/// \brief Sequential loop
+/// \ingroup SEQ
+template <>
+class RunSMP<BackendSEQ>
+{
+  public:
+    template <typename Work>
+    void operator()(std::size_t n, Work &&work) const
+    {
+        work(std::size_t(0), n);
+    }
+}; // class RunSMP
+
 /// \brief SMCSampler<T>::eval_type subtype
 /// \ingroup SEQ
 template <typename T, typename Derived>
@@ -59,8 +72,17 @@ class SMCSamplerEvalSMP<T, Derived, BackendSEQ>
     template <typename... Args>
     void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
     {
+        using size_type = typename Particle<T>::size_type;
+
         this->eval_first(iter, particle);
-        this->eval_range(iter, particle.range());
+        if (!internal::backend_deterministic_run<BackendSEQ>(particle,
+                [this, iter, &particle](std::size_t ibegin, std::size_t iend) {
+                    this->eval_range(iter,
+                        particle.range(static_cast<size_type>(ibegin),
+                            static_cast<size_type>(iend)));
+                })) {
+            this->eval_range(iter, particle.range());
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCSamplerEvalSMP
@@ -91,12 +113,40 @@ class SMCEstimatorEvalSMP<T, Derived, BackendSEQ>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
         double *r, std::size_t, Args &&...)
     {
+        using size_type = typename Particle<T>::size_type;
+
         this->eval_first(iter, particle);
-        this->eval_range(iter, dim, particle.range(), r);
+        if (!internal::backend_deterministic_run<BackendSEQ>(particle,
+                [this, iter, dim, &particle, r](
+                    std::size_t ibegin, std::size_t iend) {
+                    this->eval_range(iter, dim,
+                        particle.range(static_cast<size_type>(ibegin),
+                            static_cast<size_type>(iend)),
+                        r + ibegin * dim);
+                })) {
+            this->eval_range(iter, dim, particle.range(), r);
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCEstimatorEvalSMP
 
+/// \brief Resampling using the same algorithm as the parallel backends
+/// \ingroup SEQ
+template <typename T>
+class ResampleEvalSMP<T, BackendSEQ>
+    : public ResampleEvalSMPBase<T, ResampleEvalSMP<T, BackendSEQ>>
+{
+  public:
+    using ResampleEvalSMPBase<T,
+        ResampleEvalSMP<T, BackendSEQ>>::ResampleEvalSMPBase;
+
+    template <typename Work>
+    static void run(std::size_t n, Work &&work)
+    {
+        RunSMP<BackendSEQ>()(n, std::forward<Work>(work));
+    }
+}; // class ResampleEvalSMP
+
 /// \brief SMCSampler<T>::eval_type subtype
 /// \ingroup SEQ
 template <typename T, typename Derived>
@@ -107,6 +157,11 @@ using SMCSamplerEvalSEQ = SMCSamplerEvalSMP<T, Derived, BackendSEQ>;
 template <typename T, typename Derived>
 using SMCEstimatorEvalSEQ = SMCEstimatorEvalSMP<T, Derived, BackendSEQ>;
 
+/// \brief Resampling using the same algorithm as the parallel backends
+/// \ingroup SEQ
+template <typename T>
+using ResampleEvalSEQ = ResampleEvalSMP<T, BackendSEQ>;
+
 } // namespace mckl
 
 #endif // MCKL_SMP_BACKEND_SEQ_HPP
@@ -34,17 +34,46 @@
 
 #include <mckl/core/iterator.hpp>
 #include <mckl/smp/backend_base.hpp>
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace mckl {
 
+/// \brief SMP implementation ID for the standard library
+/// \ingroup STD
+///
+/// \details
+/// The singleton owns a persistent pool of `np() - 1` worker threads, which
+/// are created on first use and reused by all subsequent calls to `run`. The
+/// calling thread participates as the first worker. The range \f$[0, N)\f$
+/// is initially partitioned into `np()` contiguous blocks, one for each
+/// worker. Each worker keeps a deque of ranges. It recursively splits its
+/// range in halves down to the grain size, pushes the upper halves to the
+/// back of its deque, and pops from the back when done. A worker whose deque
+/// is empty steals from the front of the other workers' deques.
+///
+/// If `affinity()` is enabled, each worker is pinned to a processor, and the
+/// \f$i\f$-th block is always processed as a whole by the \f$i\f$-th worker
+/// without stealing. Thus the same range of particles is processed on the same
+/// processor in every iteration. Use `first_touch` to place the memory of the
+/// particle system accordingly. The thread calling `run` acts as the first
+/// worker. It is pinned only for the duration of the call, and its original
+/// affinity is restored on return.
 class BackendSTD
 {
   public:
+    using range_type = Range<std::size_t>;
+
     BackendSTD(const BackendSTD &) = delete;
     BackendSTD &operator=(const BackendSTD &) = delete;
 
+    ~BackendSTD() { stop(); }
+
     static BackendSTD &instance()
     {
         static BackendSTD backend;
@@ -52,42 +81,310 @@ class BackendSTD
         return backend;
     }
 
-    void reset() { np_ = std::thread::hardware_concurrency(); }
+    /// \brief Reset the number of workers to the hardware concurrency
+    void reset() { np(std::thread::hardware_concurrency()); }
 
+    /// \brief The number of workers, including the calling thread
     unsigned np() const { return np_; }
 
-    void np(unsigned n) { np_ = n; }
+    /// \brief Set the number of workers
+    ///
+    /// \details
+    /// Existing worker threads are joined. New ones are created on the next
+    /// call to `run`. Calling this function from within `run` fails a
+    /// runtime assertion and has no effect.
+    void np(unsigned n)
+    {
+        if (!reconfigurable("**BackendSTD::np**")) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        stop();
+        np_ = n;
+    }
+
+    /// \brief If workers are pinned to processors with a fixed partition
+    bool affinity() const { return affinity_; }
+
+    /// \brief Enable or disable pinning workers to processors
+    ///
+    /// \details
+    /// The calling thread of the next `run` is pinned as the first worker.
+    /// Has no effect unless `MCKL_HAS_THREAD_AFFINITY` is non-zero. Calling
+    /// this function from within `run` fails a runtime assertion and has no
+    /// effect.
+    void affinity(bool enable)
+    {
+        if (!reconfigurable("**BackendSTD::affinity**")) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        stop();
+        affinity_ = enable;
+    }
+
+    /// \brief Move the state and weights of a particle system to newly
+    /// allocated memory, such that each block is first touched by the worker
+    /// that processes it when `affinity()` is enabled
+    template <typename T>
+    void first_touch(Particle<T> &particle)
+    {
+        internal::backend_first_touch(particle,
+            [this](std::size_t N, auto &&work) { run(N, N, work); });
+    }
+
+    /// \brief Apply `work(ibegin, iend)` to sub-ranges of \f$[0, N)\f$ in
+    /// parallel
+    ///
+    /// \param N The size of the range
+    /// \param grainsize No range smaller than this is passed to `work`,
+    /// unless \f$N\f$ itself is smaller. Each worker's initial block is split
+    /// into at most eight sub-ranges regardless of the grain size. Ignored if
+    /// `affinity()` is enabled.
+    /// \param work A callable object with signature `void(std::size_t,
+    /// std::size_t)`
+    ///
+    /// \details
+    /// If called from within a worker, or while the pool is occupied by
+    /// another thread, `work(0, N)` is invoked in the calling thread. The
+    /// first exception thrown by `work` is rethrown after all sub-ranges are
+    /// done.
+    template <typename Work>
+    void run(std::size_t N, std::size_t grainsize, Work &&work)
+    {
+        if (N == 0) {
+            return;
+        }
+
+        if (is_worker() || np_ < 2 || !run_mutex_.try_lock()) {
+            work(std::size_t(0), N);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(run_mutex_, std::adopt_lock);
+        using work_type = std::remove_reference_t<Work>;
+        start();
+        work_ptr_ = const_cast<void *>(static_cast<const void *>(&work));
+        work_call_ = [](void *ptr, std::size_t ibegin, std::size_t iend) {
+            (*static_cast<work_type *>(ptr))(ibegin, iend);
+        };
+        error_ = nullptr;
+        grainsize_ = affinity_ ? N : std::max(grainsize, N / (8 * np_));
+        grainsize_ = std::max(grainsize_, std::size_t(1));
+        remaining_.store(N, std::memory_order_release);
+
+        const std::size_t m = N / np_;
+        const std::size_t r = N % np_;
+        std::size_t b = 0;
+        for (unsigned i = 0; i != np_; ++i) {
+            const std::size_t l = m + (i < r ? 1 : 0);
+            if (l != 0) {
+                std::lock_guard<std::mutex> qlock(queue_[i].mutex);
+                queue_[i].deque.emplace_back(b, b + l);
+            }
+            b += l;
+        }
+
+        {
+            std::lock_guard<std::mutex> slock(mutex_);
+            ++generation_;
+        }
+        cv_.notify_all();
+
+        {
+            internal::BackendAffinityGuard guard(affinity_);
+            if (affinity_) {
+                internal::backend_pin_thread(0);
+            }
+            is_worker() = true;
+            work_loop(0);
+            is_worker() = false;
+        }
+
+        if (error_ != nullptr) {
+            std::rethrow_exception(error_);
+        }
+    }
 
   private:
+    class queue_type
+    {
+      public:
+        std::mutex mutex;
+        std::deque<range_type> deque;
+    }; // class queue_type
+
     unsigned np_;
+    bool affinity_;
+    bool stop_;
+    unsigned long long generation_;
+    std::size_t grainsize_;
+    std::atomic<std::size_t> remaining_;
+    void *work_ptr_;
+    void (*work_call_)(void *, std::size_t, std::size_t);
+    std::exception_ptr error_;
+    std::mutex error_mutex_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<queue_type[]> queue_;
+    Vector<std::thread> thread_;
 
-    BackendSTD() : np_(std::thread::hardware_concurrency()) {}
-}; // class BackendSTD
+    BackendSTD()
+        : np_(std::thread::hardware_concurrency())
+        , affinity_(false)
+        , stop_(false)
+        , generation_(0)
+        , grainsize_(1)
+        , remaining_(0)
+        , work_ptr_(nullptr)
+        , work_call_(nullptr)
+    {
+    }
 
-namespace internal {
+    static bool &is_worker()
+    {
+        static thread_local bool flag = false;
 
-template <typename T>
-inline mckl::Vector<ParticleRange<T>> backend_std_range(Particle<T> &particle)
-{
-    const std::size_t N = static_cast<std::size_t>(particle.size());
-    const std::size_t n =
-        static_cast<std::size_t>(std::max(1U, BackendSTD::instance().np()));
-    const std::size_t m = N / n;
-    const std::size_t r = N % n;
+        return flag;
+    }
+
+    // The pool cannot be reconfigured from within a run, which holds
+    // run_mutex_ until all workers are done
+    static bool reconfigurable(const char *func)
+    {
+        const bool ok = !is_worker();
+        runtime_assert(ok, std::string(func) + " called from within run");
+
+        return ok;
+    }
+
+    void start()
+    {
+        if (queue_ != nullptr) {
+            return;
+        }
+
+        stop_ = false;
+        queue_.reset(new queue_type[np_]);
+        thread_.reserve(np_ - 1);
+        const unsigned long long generation = generation_;
+        for (unsigned i = 1; i < np_; ++i) {
+            thread_.emplace_back(
+                [this, i, generation]() { worker(i, generation); });
+        }
+    }
 
-    ParticleIndex<T> b = particle.begin();
-    mckl::Vector<ParticleRange<T>> range;
-    range.reserve(n);
-    for (std::size_t i = 0; i != n; ++i) {
-        const std::size_t l = m + (i < r ? 1 : 0);
-        range.emplace_back(b, b + l);
-        b += l;
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &t : thread_) {
+            t.join();
+        }
+        thread_.clear();
+        queue_.reset();
+    }
+
+    void worker(unsigned id, unsigned long long generation)
+    {
+        is_worker() = true;
+        if (affinity_) {
+            internal::backend_pin_thread(static_cast<int>(id));
+        }
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock,
+                    [this, generation]() {
+                        return stop_ || generation_ != generation;
+                    });
+                if (stop_) {
+                    return;
+                }
+                generation = generation_;
+            }
+            work_loop(id);
+        }
+    }
+
+    void work_loop(unsigned id)
+    {
+        range_type range;
+        while (remaining_.load(std::memory_order_acquire) != 0) {
+            if (pop(id, range) || (!affinity_ && steal(id, range))) {
+                execute(id, range);
+            } else {
+                std::this_thread::yield();
+            }
+        }
     }
 
-    return range;
-}
+    bool pop(unsigned id, range_type &range)
+    {
+        std::lock_guard<std::mutex> lock(queue_[id].mutex);
+        if (queue_[id].deque.empty()) {
+            return false;
+        }
+        range = queue_[id].deque.back();
+        queue_[id].deque.pop_back();
+
+        return true;
+    }
+
+    bool steal(unsigned id, range_type &range)
+    {
+        for (unsigned k = 1; k < np_; ++k) {
+            const unsigned v = (id + k) % np_;
+            std::lock_guard<std::mutex> lock(queue_[v].mutex);
+            if (!queue_[v].deque.empty()) {
+                range = queue_[v].deque.front();
+                queue_[v].deque.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void execute(unsigned id, range_type range)
+    {
+        while (range.size() >= 2 * grainsize_) {
+            const std::size_t h = range.begin() + range.size() / 2;
+            {
+                std::lock_guard<std::mutex> lock(queue_[id].mutex);
+                queue_[id].deque.emplace_back(h, range.end());
+            }
+            range = range_type(range.begin(), h);
+        }
+
+        try {
+            work_call_(work_ptr_, range.begin(), range.end());
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (error_ == nullptr) {
+                error_ = std::current_exception();
+            }
+        }
+        remaining_.fetch_sub(range.size(), std::memory_order_acq_rel);
+    }
+}; // class BackendSTD
 
-} // namespace internal
+/// \brief Parallel loop using the standard library
+/// \ingroup STD
+template <>
+class RunSMP<BackendSTD>
+{
+  public:
+    template <typename Work>
+    void operator()(std::size_t n, Work &&work) const
+    {
+        BackendSTD::instance().run(n, 1, std::forward<Work>(work));
+    }
+}; // class RunSMP
 
 /// \brief SMCSampler<T>::eval_type subtype using the standard library
 /// \ingroup STD
@@ -110,18 +407,21 @@ class SMCSamplerEvalSMP<T, Derived, BackendSTD>
     }
 
     template <typename... Args>
-    void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
+    void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize,
+        Args &&...)
     {
+        using size_type = typename Particle<T>::size_type;
+
         this->eval_first(iter, particle);
-        mckl::Vector<std::future<void>> task_group;
-        for (auto range : internal::backend_std_range(particle)) {
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, &particle, range]() {
-                    this->eval_range(iter, range);
-                }));
-        }
-        for (auto &task : task_group) {
-            task.wait();
+        auto work = [this, iter, &particle](
+                        std::size_t ibegin, std::size_t iend) {
+            this->eval_range(iter,
+                particle.range(static_cast<size_type>(ibegin),
+                    static_cast<size_type>(iend)));
+        };
+        if (!internal::backend_deterministic_run<BackendSTD>(particle, work)) {
+            BackendSTD::instance().run(
+                static_cast<std::size_t>(particle.size()), grainsize, work);
         }
         this->eval_last(iter, particle);
     }
@@ -151,24 +451,43 @@ class SMCEstimatorEvalSMP<T, Derived, BackendSTD>
 
     template <typename... Args>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
-        double *r, std::size_t, Args &&...)
+        double *r, std::size_t grainsize, Args &&...)
     {
+        using size_type = typename Particle<T>::size_type;
+
         this->eval_first(iter, particle);
-        mckl::Vector<std::future<void>> task_group;
-        for (auto range : internal::backend_std_range(particle)) {
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, dim, &particle, r, range]() {
-                    this->eval_range(iter, dim, range,
-                        r + static_cast<std::size_t>(range.ibegin()) * dim);
-                }));
-        }
-        for (auto &task : task_group) {
-            task.wait();
+        auto work = [this, iter, dim, &particle, r](
+                        std::size_t ibegin, std::size_t iend) {
+            this->eval_range(iter, dim,
+                particle.range(static_cast<size_type>(ibegin),
+                    static_cast<size_type>(iend)),
+                r + ibegin * dim);
+        };
+        if (!internal::backend_deterministic_run<BackendSTD>(particle, work)) {
+            BackendSTD::instance().run(
+                static_cast<std::size_t>(particle.size()), grainsize, work);
         }
         this->eval_last(iter, particle);
     }
 }; // class SMCEstimatorEvalSMP
 
+/// \brief Parallel resampling using the standard library
+/// \ingroup STD
+template <typename T>
+class ResampleEvalSMP<T, BackendSTD>
+    : public ResampleEvalSMPBase<T, ResampleEvalSMP<T, BackendSTD>>
+{
+  public:
+    using ResampleEvalSMPBase<T,
+        ResampleEvalSMP<T, BackendSTD>>::ResampleEvalSMPBase;
+
+    template <typename Work>
+    static void run(std::size_t n, Work &&work)
+    {
+        RunSMP<BackendSTD>()(n, std::forward<Work>(work));
+    }
+}; // class ResampleEvalSMP
+
 /// \brief SMCSampler<T>::eval_type subtype using the standard library
 /// \ingroup STD
 template <typename T, typename Derived>
@@ -179,6 +498,11 @@ using SMCSamplerEvalSTD = SMCSamplerEvalSMP<T, Derived, BackendSTD>;
 template <typename T, typename Derived>
 using SMCEstimatorEvalSTD = SMCEstimatorEvalSMP<T, Derived, BackendSTD>;
 
+/// \brief Parallel resampling using the standard library
+/// \ingroup STD
+template <typename T>
+using ResampleEvalSTD = ResampleEvalSMP<T, BackendSTD>;
+
 } // namespace mckl
 
 #endif // MCKL_SMP_BACKEND_STD_HPP
@@ -50,6 +50,22 @@ inline ::tbb::blocked_range<IntType> backend_tbb_range(
 
 } // namespace internal
 
+/// \brief Parallel loop using Intel Threading Building Blocks
+/// \ingroup TBB
+template <>
+class RunSMP<BackendTBB>
+{
+  public:
+    template <typename Work>
+    void operator()(std::size_t n, Work &&work) const
+    {
+        ::tbb::parallel_for(internal::backend_tbb_range(n, 1),
+            [&work](const ::tbb::blocked_range<std::size_t> &range) {
+                work(range.begin(), range.end());
+            });
+    }
+}; // class RunSMP
+
 /// \brief SMCSampler<T>::eval_type subtype using Intel Threading Building
 /// Blocks
 /// \ingroup TBB
@@ -73,6 +89,13 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
             wptr_->eval_range(iter_, pptr_->range(range.begin(), range.end()));
         }
 
+        void operator()(std::size_t ibegin, std::size_t iend) const
+        {
+            wptr_->eval_range(iter_,
+                pptr_->range(static_cast<size_type>(ibegin),
+                    static_cast<size_type>(iend)));
+        }
+
       private:
         SMCSamplerEvalSMP<T, Derived, BackendTBB> *const wptr_;
         const std::size_t iter_;
@@ -98,9 +121,12 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
         Args &&... args)
     {
         this->eval_first(iter, particle);
-        ::tbb::parallel_for(
-            internal::backend_tbb_range(particle.size(), grainsize),
-            work_type(this, iter, &particle), std::forward<Args>(args)...);
+        if (!internal::backend_deterministic_run<BackendTBB>(
+                particle, work_type(this, iter, &particle))) {
+            ::tbb::parallel_for(
+                internal::backend_tbb_range(particle.size(), grainsize),
+                work_type(this, iter, &particle), std::forward<Args>(args)...);
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCSamplerEvalSMP
@@ -130,6 +156,14 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
                 r_ + static_cast<std::size_t>(range.begin()) * dim_);
         }
 
+        void operator()(std::size_t ibegin, std::size_t iend) const
+        {
+            wptr_->eval_range(iter_, dim_,
+                pptr_->range(static_cast<size_type>(ibegin),
+                    static_cast<size_type>(iend)),
+                r_ + ibegin * dim_);
+        }
+
       private:
         SMCEstimatorEvalSMP<T, Derived, BackendTBB> *const wptr_;
         const std::size_t iter_;
@@ -159,14 +193,34 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
         double *r, std::size_t grainsize, Args &&... args)
     {
         this->eval_first(iter, particle);
-        ::tbb::parallel_for(
-            internal::backend_tbb_range(particle.size(), grainsize),
-            work_type(this, iter, dim, &particle, r),
-            std::forward<Args>(args)...);
+        if (!internal::backend_deterministic_run<BackendTBB>(
+                particle, work_type(this, iter, dim, &particle, r))) {
+            ::tbb::parallel_for(
+                internal::backend_tbb_range(particle.size(), grainsize),
+                work_type(this, iter, dim, &particle, r),
+                std::forward<Args>(args)...);
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCEstimatorEvalSMP
 
+/// \brief Parallel resampling using Intel Threading Building Blocks
+/// \ingroup TBB
+template <typename T>
+class ResampleEvalSMP<T, BackendTBB>
+    : public ResampleEvalSMPBase<T, ResampleEvalSMP<T, BackendTBB>>
+{
+  public:
+    using ResampleEvalSMPBase<T,
+        ResampleEvalSMP<T, BackendTBB>>::ResampleEvalSMPBase;
+
+    template <typename Work>
+    static void run(std::size_t n, Work &&work)
+    {
+        RunSMP<BackendTBB>()(n, std::forward<Work>(work));
+    }
+}; // class ResampleEvalSMP
+
 /// \brief SMCSampler<T>::eval_type subtype using Intel Threading Building
 /// Blocks
 /// \ingroup TBB
@@ -179,6 +233,11 @@ using SMCSamplerEvalTBB = SMCSamplerEvalSMP<T, Derived, BackendTBB>;
 template <typename T, typename Derived>
 using SMCEstimatorEvalTBB = SMCEstimatorEvalSMP<T, Derived, BackendTBB>;
 
+/// \brief Parallel resampling using Intel Threading Building Blocks
+/// \ingroup TBB
+template <typename T>
+using ResampleEvalTBB = ResampleEvalSMP<T, BackendTBB>;
+
 } // namespace mckl
 
 #endif // MCKL_SMP_BACKEND_TBB_HPP
@@ -37,6 +37,57 @@
 
 namespace mckl {
 
+namespace internal {
+
+// Copy a full symmetric matrix to the storage of a covariance matrix
+template <typename RealType>
+inline void cov_pack(std::size_t p, const RealType *full, RealType *cov,
+    MatrixLayout cov_layout, bool cov_upper, bool cov_packed)
+{
+    if (!cov_packed) {
+        std::memcpy(cov, full, sizeof(RealType) * p * p);
+        return;
+    }
+
+    unsigned l = cov_layout == RowMajor ? 0 : 1;
+    unsigned u = cov_upper ? 1 : 0;
+    unsigned c = (l << 1) + u;
+    switch (c) {
+        case 0: // Row, Lower, Pack
+            for (size_t i = 0; i != p; ++i) {
+                for (std::size_t j = 0; j <= i; ++j) {
+                    *cov++ = full[i * p + j];
+                }
+            }
+            break;
+        case 1: // Row, Upper, Pack
+            for (std::size_t i = 0; i != p; ++i) {
+                for (std::size_t j = i; j != p; ++j) {
+                    *cov++ = full[i * p + j];
+                }
+            }
+            break;
+        case 2: // Col, Lower, Pack
+            for (std::size_t j = 0; j != p; ++j) {
+                for (std::size_t i = j; i != p; ++i) {
+                    *cov++ = full[j * p + i];
+                }
+            }
+            break;
+        case 3: // Col, Upper, Pack
+            for (std::size_t j = 0; j != p; ++j) {
+                for (std::size_t i = 0; i <= j; ++i) {
+                    *cov++ = full[j * p + i];
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace internal
+
 /// \brief Covariance
 /// \ingroup Covariance
 template <typename RealType = double>
@@ -238,48 +289,332 @@ class Covariance
             }
         }
 
-        if (!cov_packed) {
-            std::memcpy(cov, cov_.data(), sizeof(result_type) * cov_.size());
+        internal::cov_pack(
+            p, cov_.data(), cov, cov_layout, cov_upper, cov_packed);
+    }
+}; // class Covariance
+
+/// \brief Streaming covariance accumulator
+/// \ingroup Covariance
+///
+/// \details
+/// Samples are added one at a time, or in chunks of any size. Each chunk is
+/// processed in cache sized blocks, whose weighted means and centered sums of
+/// squares (by `syrk`) are combined with the running ones by the pairwise
+/// update of Chan, Golub and LeVeque, without copying the whole chunk. Two
+/// accumulators of disjoint samples, such as the partial results of threads,
+/// can be combined by `merge()`. The results are the same as those of
+/// Covariance on all the samples, up to rounding errors.
+template <typename RealType = double>
+class OnlineCovariance
+{
+    static_assert(internal::is_blas_floating_point<RealType>::value,
+        "**OnlineCovariance** used with RealType other than float or double");
+
+  public:
+    using result_type = RealType;
+
+    /// \brief Construct an accumulator of `p` dimensional samples
+    explicit OnlineCovariance(std::size_t p = 0) { reset(p); }
+
+    /// \brief Remove all samples and set the dimension
+    void reset(std::size_t p)
+    {
+        internal::size_check<MCKL_BLAS_INT>(p, "OnlineCovariance::reset");
+
+        p_ = p;
+        mean_.resize(p);
+        ssq_.resize(p * p);
+        clear();
+    }
+
+    /// \brief Remove all samples
+    void clear()
+    {
+        n_ = 0;
+        sw_ = 0;
+        sw2_ = 0;
+        std::fill(mean_.begin(), mean_.end(), 0);
+        std::fill(ssq_.begin(), ssq_.end(), 0);
+    }
+
+    /// \brief The dimension of the samples
+    std::size_t dim() const { return p_; }
+
+    /// \brief The number of samples added
+    std::size_t size() const { return n_; }
+
+    /// \brief The sum of the weights
+    result_type sum_weight() const { return sw_; }
+
+    /// \brief Add a sample with a weight
+    void add(const result_type *x, result_type w = 1)
+    {
+        if (p_ == 0 || !(w > 0)) {
+            ++n_;
+            return;
+        }
+
+        const result_type sw = sw_ + w;
+        const result_type c = sw_ * w / sw;
+        delta_.resize(p_);
+        sub(p_, x, mean_.data(), delta_.data());
+        muladd(p_, delta_.data(), w / sw, mean_.data(), mean_.data());
+        syr(c, delta_.data());
+        ++n_;
+        sw_ = sw;
+        sw2_ += w * w;
+    }
+
+    /// \brief Add a chunk of samples
+    ///
+    /// \param layout The storage layout of sample `x`. It is assumed to be an
+    /// `n` by `p` matrix.
+    /// \param n Sample size
+    /// \param x The sample matrix
+    /// \param w The weight vector. If it is a null pointer, then all samples
+    /// are assigned weight 1.
+    void add(MatrixLayout layout, std::size_t n, const result_type *x,
+        const result_type *w = nullptr)
+    {
+        if (n == 0 || p_ == 0) {
+            n_ += n;
             return;
         }
 
-        unsigned l = cov_layout == RowMajor ? 0 : 1;
-        unsigned u = cov_upper ? 1 : 0;
-        unsigned c = (l << 1) + u;
-        switch (c) {
-            case 0: // Row, Lower, Pack
-                for (size_t i = 0; i != p; ++i) {
-                    for (std::size_t j = 0; j <= i; ++j) {
-                        *cov++ = cov_[i * p + j];
-                    }
-                }
-                break;
-            case 1: // Row, Upper, Pack
-                for (std::size_t i = 0; i != p; ++i) {
-                    for (std::size_t j = i; j != p; ++j) {
-                        *cov++ = cov_[i * p + j];
-                    }
-                }
-                break;
-            case 2: // Col, Lower, Pack
-                for (std::size_t j = 0; j != p; ++j) {
-                    for (std::size_t i = j; i != p; ++i) {
-                        *cov++ = cov_[j * p + i];
-                    }
-                }
-                break;
-            case 3: // Col, Upper, Pack
-                for (std::size_t j = 0; j != p; ++j) {
-                    for (std::size_t i = 0; i <= j; ++i) {
-                        *cov++ = cov_[j * p + i];
+        const std::size_t k = std::max(
+            std::size_t(1), internal::BufferSize<RealType>::value / p_);
+        buffer_.resize(k * p_);
+        wsqrt_.resize(k);
+        delta_.resize(p_);
+        result_type *const y = buffer_.data();
+        for (std::size_t i = 0; i < n; i += k) {
+            const std::size_t m = std::min(k, n - i);
+            if (layout == RowMajor) {
+                std::copy_n(x + i * p_, m * p_, y);
+            } else {
+                for (std::size_t r = 0; r != m; ++r) {
+                    for (std::size_t j = 0; j != p_; ++j) {
+                        y[r * p_ + j] = x[j * n + i + r];
                     }
                 }
-                break;
-            default:
-                break;
+            }
+            if (w == nullptr) {
+                std::fill_n(wsqrt_.data(), m, const_one<result_type>());
+            } else {
+                std::copy_n(w + i, m, wsqrt_.data());
+            }
+            add_block(m);
         }
+        n_ += n;
     }
-}; // class Covariance
+
+    /// \brief Combine with the accumulator of other samples
+    void merge(const OnlineCovariance<RealType> &other)
+    {
+        runtime_assert(other.p_ == p_,
+            "**OnlineCovariance::merge** used with different dimensions");
+
+        n_ += other.n_;
+        if (!(other.sw_ > 0)) {
+            return;
+        }
+        if (!(sw_ > 0)) {
+            sw_ = other.sw_;
+            sw2_ = other.sw2_;
+            mean_ = other.mean_;
+            ssq_ = other.ssq_;
+            return;
+        }
+        merge(other.sw_, other.sw2_, other.mean_.data());
+        ::mckl::add(p_ * p_, other.ssq_.data(), ssq_.data(), ssq_.data());
+    }
+
+    /// \brief Get the mean and the covariance matrix
+    ///
+    /// \param mean Output storage of the mean. If it is a null pointer, then
+    /// it is ignored.
+    /// \param cov Output storage of the covarianc matrix. If it is a null
+    /// pointer, then it is ignored.
+    /// \param cov_layout The storage layout of the covariance matrix.
+    /// \param cov_upper If true, then the upper triangular of the covariance
+    /// matrix is packed, otherwise the lower triangular is packed. Ignored if
+    /// `cov_pack` is `false`.
+    /// \param cov_packed If true, then the covariance matrix is packed.
+    void operator()(result_type *mean, result_type *cov,
+        MatrixLayout cov_layout = RowMajor, bool cov_upper = false,
+        bool cov_packed = false) const
+    {
+        if (mean != nullptr) {
+            std::copy(mean_.begin(), mean_.end(), mean);
+        }
+        if (cov == nullptr || p_ == 0) {
+            return;
+        }
+
+        const result_type B = sw_ / (sw_ * sw_ - sw2_);
+        Vector<result_type> full(p_ * p_);
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                full[i * p_ + j] = full[j * p_ + i] = B * ssq_[i * p_ + j];
+            }
+        }
+        internal::cov_pack(
+            p_, full.data(), cov, cov_layout, cov_upper, cov_packed);
+    }
+
+  private:
+    std::size_t p_;
+    std::size_t n_;
+    result_type sw_;
+    result_type sw2_;
+    Vector<result_type> mean_;
+    Vector<result_type> ssq_; // lower triangular, row major
+    Vector<result_type> delta_;
+    Vector<result_type> buffer_;
+    Vector<result_type> wsqrt_;
+
+    // Combine the block in buffer_ with weights in wsqrt_
+    void add_block(std::size_t m)
+    {
+        result_type *const y = buffer_.data();
+        result_type *const v = wsqrt_.data();
+        const result_type sw = std::accumulate(v, v + m, result_type());
+        if (!(sw > 0)) {
+            return;
+        }
+        const result_type sw2 = dot(m, v, v);
+
+        Vector<result_type> &mean = delta_;
+        gemv(m, y, v, mean.data());
+        mul(p_, 1 / sw, mean.data(), mean.data());
+        sqrt(m, v, v);
+        for (std::size_t r = 0; r != m; ++r) {
+            sub(p_, y + r * p_, mean.data(), y + r * p_);
+            mul(p_, y + r * p_, v[r], y + r * p_);
+        }
+        syrk(m, y);
+
+        if (!(sw_ > 0)) {
+            std::copy_n(mean.data(), p_, mean_.data());
+            sw_ = sw;
+            sw2_ = sw2;
+            return;
+        }
+        merge(sw, sw2, mean.data());
+    }
+
+    // Combine the mean and the weights of other samples, whose centered sum
+    // of squares is added separately
+    void merge(result_type sw, result_type sw2, const result_type *mean)
+    {
+        const result_type s = sw_ + sw;
+        const result_type c = sw_ * sw / s;
+        Vector<result_type> delta(p_);
+        sub(p_, mean, mean_.data(), delta.data());
+        muladd(p_, delta.data(), sw / s, mean_.data(), mean_.data());
+        syr(c, delta.data());
+        sw_ = s;
+        sw2_ += sw2;
+    }
+
+    static float dot(std::size_t n, const float *x, const float *y)
+    {
+        return internal::cblas_sdot(static_cast<MCKL_BLAS_INT>(n), x, 1, y, 1);
+    }
+
+    static double dot(std::size_t n, const double *x, const double *y)
+    {
+        return internal::cblas_ddot(static_cast<MCKL_BLAS_INT>(n), x, 1, y, 1);
+    }
+
+    void gemv(std::size_t m, const float *y, const float *w, float *r)
+    {
+        internal::cblas_sgemv(internal::CblasRowMajor, internal::CblasTrans,
+            static_cast<MCKL_BLAS_INT>(m), static_cast<MCKL_BLAS_INT>(p_),
+            1.0f, y, static_cast<MCKL_BLAS_INT>(p_), w, 1, 0.0f, r, 1);
+    }
+
+    void gemv(std::size_t m, const double *y, const double *w, double *r)
+    {
+        internal::cblas_dgemv(internal::CblasRowMajor, internal::CblasTrans,
+            static_cast<MCKL_BLAS_INT>(m), static_cast<MCKL_BLAS_INT>(p_), 1.0,
+            y, static_cast<MCKL_BLAS_INT>(p_), w, 1, 0.0, r, 1);
+    }
+
+    void syr(float alpha, const float *x)
+    {
+        internal::cblas_ssyr(internal::CblasRowMajor, internal::CblasLower,
+            static_cast<MCKL_BLAS_INT>(p_), alpha, x, 1, ssq_.data(),
+            static_cast<MCKL_BLAS_INT>(p_));
+    }
+
+    void syr(double alpha, const double *x)
+    {
+        internal::cblas_dsyr(internal::CblasRowMajor, internal::CblasLower,
+            static_cast<MCKL_BLAS_INT>(p_), alpha, x, 1, ssq_.data(),
+            static_cast<MCKL_BLAS_INT>(p_));
+    }
+
+    void syrk(std::size_t m, const float *y)
+    {
+        internal::cblas_ssyrk(internal::CblasRowMajor, internal::CblasLower,
+            internal::CblasTrans, static_cast<MCKL_BLAS_INT>(p_),
+            static_cast<MCKL_BLAS_INT>(m), 1.0f, y,
+            static_cast<MCKL_BLAS_INT>(p_), 1.0f, ssq_.data(),
+            static_cast<MCKL_BLAS_INT>(p_));
+    }
+
+    void syrk(std::size_t m, const double *y)
+    {
+        internal::cblas_dsyrk(internal::CblasRowMajor, internal::CblasLower,
+            internal::CblasTrans, static_cast<MCKL_BLAS_INT>(p_),
+            static_cast<MCKL_BLAS_INT>(m), 1.0, y,
+            static_cast<MCKL_BLAS_INT>(p_), 1.0, ssq_.data(),
+            static_cast<MCKL_BLAS_INT>(p_));
+    }
+}; // class OnlineCovariance
+
+/// \brief Cholesky decomposition of a covariance matrix
+/// \ingroup Covariance
+///
+/// \param dim The dimension of the covariance matrix
+/// \param cov The `dim` by `dim` covariance matrix. Only the lower triangular
+/// of its row major storage is used.
+/// \param chol The lower triangular of the Cholesky decomposition, packed row
+/// by row, as expected by NormalMVDistribution
+///
+/// \return Zero if the decomposition succeeded, or `i + 1` if the `i`-th
+/// leading minor is not positive definite, in which case `chol` is partially
+/// written.
+template <typename RealType>
+inline std::size_t cov_chol(
+    std::size_t dim, const RealType *cov, RealType *chol)
+{
+    static_assert(internal::is_blas_floating_point<RealType>::value,
+        "**cov_chol** used with RealType other than float or double");
+
+    // Row i of the packed lower triangular starts at i * (i + 1) / 2
+    for (std::size_t i = 0; i != dim; ++i) {
+        RealType *const li = chol + i * (i + 1) / 2;
+        for (std::size_t j = 0; j <= i; ++j) {
+            const RealType *const lj = chol + j * (j + 1) / 2;
+            RealType s = cov[i * dim + j];
+            for (std::size_t k = 0; k != j; ++k) {
+                s -= li[k] * lj[k];
+            }
+            if (j != i) {
+                li[j] = s / lj[j];
+            } else if (s > 0) {
+                li[i] = std::sqrt(s);
+            } else {
+                return i + 1;
+            }
+        }
+    }
+
+    return 0;
+}
 
 } // namespace mckl
 
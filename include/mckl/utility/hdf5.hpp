@@ -686,13 +686,25 @@ inline bool hdf5store(Location &&location, const std::string &name,
     return data.write(type, vec.data());
 }
 
-/// \brief Append a vector in HDF5 format
+/// \brief Append an array in HDF5 format
 /// \ingroup HDF5
-template <typename Location, typename T, typename Alloc>
+///
+/// \details
+/// The data set shall be one dimensional and extensible, such as one created
+/// by `hdf5store` with `extensible` set to `true`. For example, the following
+/// spills the estimates of a streaming EstimateMatrix to a file
+/// ~~~{.cpp}
+/// hdf5store(file, "estimate", Vector<double>(), false, true);
+/// estimator.stream(1024, [&](std::size_t, std::size_t n, std::size_t d,
+///                            const double *r) {
+///     hdf5append(file, "estimate", n * d, r);
+/// });
+/// ~~~
+template <typename Location, typename T>
 inline bool hdf5append(
-    Location &&location, const std::string &name, const Vector<T, Alloc> &vec)
+    Location &&location, const std::string &name, std::size_t n, const T *r)
 {
-    if (vec.empty()) {
+    if (n == 0) {
         return true;
     }
 
@@ -712,7 +724,7 @@ inline bool hdf5append(
     }
 
     ::hsize_t offset[] = {space.npoints()};
-    ::hsize_t exts[] = {vec.size()};
+    ::hsize_t exts[] = {n};
     ::hsize_t dims[] = {offset[0] + exts[0]};
     if (::H5Dset_extent(data.id(), dims) != 0) {
         return false;
@@ -734,13 +746,23 @@ inline bool hdf5append(
     }
 
     if (::H5Dwrite(data.id(), type.id(), mspace.id(), space.id(), H5P_DEFAULT,
-            vec.data()) != 0) {
+            r) != 0) {
         return false;
     }
 
     return true;
 }
 
+/// \brief Append a vector in HDF5 format
+/// \ingroup HDF5
+template <typename Location, typename T, typename Alloc>
+inline bool hdf5append(
+    Location &&location, const std::string &name, const Vector<T, Alloc> &vec)
+{
+    return hdf5append(
+        std::forward<Location>(location), name, vec.size(), vec.data());
+}
+
 /// \brief Store a Matrix in HDF5 format
 /// \ingroup HDF5
 template <typename Location, typename T, MatrixLayout Layout, typename Alloc>